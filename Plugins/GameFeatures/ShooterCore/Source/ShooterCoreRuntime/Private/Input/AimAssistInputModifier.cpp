@@ -284,20 +284,11 @@ FBox2D FAimAssistOwnerViewData::ProjectShapeToScreen(const FCollisionShape& Shap
 {
 	FBox2D Box2D(ForceInitToZero);
 
-	switch (Shape.ShapeType)
+	TArray<FVector> Vertices;
+	const int32 NumVertices = AppendShapeVertices(Shape, ShapeOrigin, WorldTransform, Vertices);
+	if (NumVertices > 0)
 	{
-	case ECollisionShape::Box:
-		Box2D = ProjectBoxToScreen(Shape, ShapeOrigin, WorldTransform);
-		break;
-	case ECollisionShape::Sphere:
-		Box2D = ProjectSphereToScreen(Shape, ShapeOrigin, WorldTransform);
-		break;
-	case ECollisionShape::Capsule:
-		Box2D = ProjectCapsuleToScreen(Shape, ShapeOrigin, WorldTransform);
-		break;
-	default:
-		UE_LOG(LogAimAssist, Warning, TEXT("FAimAssistOwnerViewData::ProjectShapeToScreen() - Invalid shape type!"));
-		break;
+		ProjectShapesToScreen(Vertices, MakeArrayView(&NumVertices, 1), MakeArrayView(&Box2D, 1));
 	}
 
 	return Box2D;
@@ -306,105 +297,137 @@ FBox2D FAimAssistOwnerViewData::ProjectShapeToScreen(const FCollisionShape& Shap
 FBox2D FAimAssistOwnerViewData::ProjectBoxToScreen(const FCollisionShape& Shape, const FVector& ShapeOrigin, const FTransform& WorldTransform) const
 {
 	check(Shape.IsBox());
-	check(!Shape.IsNearlyZero());
+	return ProjectShapeToScreen(Shape, ShapeOrigin, WorldTransform);
+}
 
-	const FVector BoxExtents = Shape.GetBox();
+FBox2D FAimAssistOwnerViewData::ProjectSphereToScreen(const FCollisionShape& Shape, const FVector& ShapeOrigin, const FTransform& WorldTransform) const
+{
+	check(Shape.IsSphere());
+	return ProjectShapeToScreen(Shape, ShapeOrigin, WorldTransform);
+}
 
-	const FVector Vertices[] =
-	{
-		FVector(-BoxExtents.X, -BoxExtents.Y, -BoxExtents.Z),
-		FVector(-BoxExtents.X, -BoxExtents.Y,  BoxExtents.Z),
-		FVector(-BoxExtents.X,  BoxExtents.Y, -BoxExtents.Z),
-		FVector(-BoxExtents.X,  BoxExtents.Y,  BoxExtents.Z),
-		FVector( BoxExtents.X, -BoxExtents.Y, -BoxExtents.Z),
-		FVector( BoxExtents.X, -BoxExtents.Y,  BoxExtents.Z),
-		FVector( BoxExtents.X,  BoxExtents.Y, -BoxExtents.Z),
-		FVector( BoxExtents.X,  BoxExtents.Y,  BoxExtents.Z)
-	};
+FBox2D FAimAssistOwnerViewData::ProjectCapsuleToScreen(const FCollisionShape& Shape, const FVector& ShapeOrigin, const FTransform& WorldTransform) const
+{
+	check(Shape.IsCapsule());
+	return ProjectShapeToScreen(Shape, ShapeOrigin, WorldTransform);
+}
 
-	FBox2D Box2D(ForceInitToZero);
+int32 FAimAssistOwnerViewData::AppendShapeVertices(const FCollisionShape& Shape, const FVector& ShapeOrigin, const FTransform& WorldTransform, TArray<FVector>& OutVertices) const
+{
+	const int32 FirstVertex = OutVertices.Num();
 
-	for (int32 VerticeIndex = 0; VerticeIndex < UE_ARRAY_COUNT(Vertices); ++VerticeIndex)
+	switch (Shape.ShapeType)
+	{
+	case ECollisionShape::Box:
 	{
-		const FVector Vertex = WorldTransform.TransformPositionNoScale(Vertices[VerticeIndex] + ShapeOrigin);
+		check(!Shape.IsNearlyZero());
 
-		FVector2D ScreenPoint;
-		if (FSceneView::ProjectWorldToScreen(Vertex, ViewRect, ViewProjectionMatrix, ScreenPoint))
+		const FVector BoxExtents = Shape.GetBox();
+
+		const FVector Vertices[] =
+		{
+			FVector(-BoxExtents.X, -BoxExtents.Y, -BoxExtents.Z),
+			FVector(-BoxExtents.X, -BoxExtents.Y,  BoxExtents.Z),
+			FVector(-BoxExtents.X,  BoxExtents.Y, -BoxExtents.Z),
+			FVector(-BoxExtents.X,  BoxExtents.Y,  BoxExtents.Z),
+			FVector( BoxExtents.X, -BoxExtents.Y, -BoxExtents.Z),
+			FVector( BoxExtents.X, -BoxExtents.Y,  BoxExtents.Z),
+			FVector( BoxExtents.X,  BoxExtents.Y, -BoxExtents.Z),
+			FVector( BoxExtents.X,  BoxExtents.Y,  BoxExtents.Z)
+		};
+
+		for (int32 VerticeIndex = 0; VerticeIndex < UE_ARRAY_COUNT(Vertices); ++VerticeIndex)
 		{
-			Box2D += ScreenPoint;
+			OutVertices.Add(WorldTransform.TransformPositionNoScale(Vertices[VerticeIndex] + ShapeOrigin));
 		}
+		break;
 	}
+	case ECollisionShape::Sphere:
+	{
+		check(!Shape.IsNearlyZero());
 
-	return Box2D;
-}
+		const FVector ViewAxisY = ViewTransform.GetUnitAxis(EAxis::Y);
+		const FVector ViewAxisZ = ViewTransform.GetUnitAxis(EAxis::Z);
 
-FBox2D FAimAssistOwnerViewData::ProjectSphereToScreen(const FCollisionShape& Shape, const FVector& ShapeOrigin, const FTransform& WorldTransform) const
-{
-	check(Shape.IsSphere());
-	check(!Shape.IsNearlyZero());
+		const float SphereRadius = Shape.GetSphereRadius();
+		const FVector SphereLocation = WorldTransform.TransformPositionNoScale(ShapeOrigin);
+		const FVector SphereExtent = (ViewAxisY * SphereRadius) + (ViewAxisZ * SphereRadius);
 
-	const FVector ViewAxisY = ViewTransform.GetUnitAxis(EAxis::Y);
-	const FVector ViewAxisZ = ViewTransform.GetUnitAxis(EAxis::Z);
+		OutVertices.Add(SphereLocation + SphereExtent);
+		OutVertices.Add(SphereLocation - SphereExtent);
+		break;
+	}
+	case ECollisionShape::Capsule:
+	{
+		check(!Shape.IsNearlyZero());
 
-	const float SphereRadius = Shape.GetSphereRadius();
-	const FVector SphereLocation = WorldTransform.TransformPositionNoScale(ShapeOrigin);
-	const FVector SphereExtent = (ViewAxisY * SphereRadius) + (ViewAxisZ * SphereRadius);
+		const FVector ViewAxisY = ViewTransform.GetUnitAxis(EAxis::Y);
+		const FVector ViewAxisZ = ViewTransform.GetUnitAxis(EAxis::Z);
 
-	const FVector Vertices[] =
-	{
-		FVector(SphereLocation + SphereExtent),
-		FVector(SphereLocation - SphereExtent),
-	};
+		const float CapsuleAxisHalfLength = Shape.GetCapsuleAxisHalfLength();
+		const float CapsuleRadius = Shape.GetCapsuleRadius();
 
-	FBox2D Box2D(ForceInitToZero);
+		const FVector TopSphereLocation = WorldTransform.TransformPositionNoScale(FVector(0.0f, 0.0f, CapsuleAxisHalfLength) + ShapeOrigin);
+		const FVector BottomSphereLocation = WorldTransform.TransformPositionNoScale(FVector(0.0f, 0.0f, -CapsuleAxisHalfLength) + ShapeOrigin);
+		const FVector SphereExtent = (ViewAxisY * CapsuleRadius) + (ViewAxisZ * CapsuleRadius);
 
-	for (int32 VerticeIndex = 0; VerticeIndex < UE_ARRAY_COUNT(Vertices); ++VerticeIndex)
-	{
-		FVector2D ScreenPoint;
-		if (FSceneView::ProjectWorldToScreen(Vertices[VerticeIndex], ViewRect, ViewProjectionMatrix, ScreenPoint))
-		{
-			Box2D += ScreenPoint;
-		}
+		OutVertices.Add(TopSphereLocation + SphereExtent);
+		OutVertices.Add(TopSphereLocation - SphereExtent);
+		OutVertices.Add(BottomSphereLocation + SphereExtent);
+		OutVertices.Add(BottomSphereLocation - SphereExtent);
+		break;
+	}
+	default:
+		UE_LOG(LogAimAssist, Warning, TEXT("FAimAssistOwnerViewData::AppendShapeVertices() - Invalid shape type!"));
+		break;
 	}
 
-	return Box2D;
+	return OutVertices.Num() - FirstVertex;
 }
 
-FBox2D FAimAssistOwnerViewData::ProjectCapsuleToScreen(const FCollisionShape& Shape, const FVector& ShapeOrigin, const FTransform& WorldTransform) const
+void FAimAssistOwnerViewData::ProjectShapesToScreen(TConstArrayView<FVector> Vertices, TConstArrayView<int32> ShapeVertexCounts, TArrayView<FBox2D> OutScreenBounds) const
 {
-	check(Shape.IsCapsule());
-	check(!Shape.IsNearlyZero());
+	check(ShapeVertexCounts.Num() == OutScreenBounds.Num());
 
-	const FVector ViewAxisY = ViewTransform.GetUnitAxis(EAxis::Y);
-	const FVector ViewAxisZ = ViewTransform.GetUnitAxis(EAxis::Z);
+	// Project relative to the view so the matrix and the vertices fit in floats without losing precision far from the origin,
+	// this matches FSceneView::ProjectWorldToScreen for every vertex with W > 0.
+	const FVector ViewOrigin = ViewTransform.GetTranslation();
+	const FMatrix44f RelativeViewProjection(FTranslationMatrix(ViewOrigin) * ViewProjectionMatrix);
 
-	const float CapsuleAxisHalfLength = Shape.GetCapsuleAxisHalfLength();
-	const float CapsuleRadius = Shape.GetCapsuleRadius();
+	const VectorRegister4Float Row0 = VectorLoad(RelativeViewProjection.M[0]);
+	const VectorRegister4Float Row1 = VectorLoad(RelativeViewProjection.M[1]);
+	const VectorRegister4Float Row2 = VectorLoad(RelativeViewProjection.M[2]);
+	const VectorRegister4Float Row3 = VectorLoad(RelativeViewProjection.M[3]);
 
-	const FVector TopSphereLocation = WorldTransform.TransformPositionNoScale(FVector(0.0f, 0.0f, CapsuleAxisHalfLength) + ShapeOrigin);
-	const FVector BottomSphereLocation = WorldTransform.TransformPositionNoScale(FVector(0.0f, 0.0f, -CapsuleAxisHalfLength) + ShapeOrigin);
-	const FVector SphereExtent = (ViewAxisY * CapsuleRadius) + (ViewAxisZ * CapsuleRadius);
+	// Clip space [-1, 1] to view rect pixels, Y is flipped
+	const float HalfWidth = ViewRect.Width() * 0.5f;
+	const float HalfHeight = ViewRect.Height() * 0.5f;
+	const VectorRegister4Float ScreenScale = MakeVectorRegisterFloat(HalfWidth, -HalfHeight, 0.0f, 0.0f);
+	const VectorRegister4Float ScreenOffset = MakeVectorRegisterFloat(ViewRect.Min.X + HalfWidth, ViewRect.Min.Y + HalfHeight, 0.0f, 0.0f);
 
-	const FVector Vertices[] =
+	int32 VertexIndex = 0;
+	for (int32 ShapeIndex = 0; ShapeIndex < ShapeVertexCounts.Num(); ++ShapeIndex)
 	{
-		FVector(TopSphereLocation + SphereExtent),
-		FVector(TopSphereLocation - SphereExtent),
-		FVector(BottomSphereLocation + SphereExtent),
-		FVector(BottomSphereLocation - SphereExtent),
-	};
-
-	FBox2D Box2D(ForceInitToZero);
+		FBox2D Box2D(ForceInitToZero);
 
-	for (int32 VerticeIndex = 0; VerticeIndex < UE_ARRAY_COUNT(Vertices); ++VerticeIndex)
-	{
-		FVector2D ScreenPoint;
-		if (FSceneView::ProjectWorldToScreen(Vertices[VerticeIndex], ViewRect, ViewProjectionMatrix, ScreenPoint))
+		for (const int32 LastVertex = VertexIndex + ShapeVertexCounts[ShapeIndex]; VertexIndex < LastVertex; ++VertexIndex)
 		{
-			Box2D += ScreenPoint;
+			const FVector3f Vertex(Vertices[VertexIndex] - ViewOrigin);
+
+			VectorRegister4Float Clip = VectorMultiplyAdd(VectorSetFloat1(Vertex.X), Row0, Row3);
+			Clip = VectorMultiplyAdd(VectorSetFloat1(Vertex.Y), Row1, Clip);
+			Clip = VectorMultiplyAdd(VectorSetFloat1(Vertex.Z), Row2, Clip);
+
+			const float W = VectorGetComponent(Clip, 3);
+			if (W > 0.0f)
+			{
+				const VectorRegister4Float Screen = VectorMultiplyAdd(VectorDivide(Clip, VectorReplicate(Clip, 3)), ScreenScale, ScreenOffset);
+				Box2D += FVector2D(VectorGetComponent(Screen, 0), VectorGetComponent(Screen, 1));
+			}
 		}
-	}
 
-	return Box2D;
+		OutScreenBounds[ShapeIndex] = Box2D;
+	}
 }
 
 ///////////////////////////////////////////////////////////////////
@@ -549,7 +572,7 @@ void UAimAssistInputModifier::UpdateTargetData(float DeltaTime)
 	const TArray<FLyraAimAssistTarget>& OldTargetCache = GetPreviousTargetCache();
 	TArray<FLyraAimAssistTarget>& NewTargetCache = GetCurrentTargetCache();
 	
-	TargetManager->GetVisibleTargets(Filter, Settings, OwnerViewData, OldTargetCache, NewTargetCache);
+	TargetManager->GetVisibleTargets(Filter, Settings, OwnerViewData, OldTargetCache, NewTargetCache, TargetQueryBuffer);
 
 	//
 	// Update target weights.
@@ -1,8 +1,30 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "Input/AimAssistTargetComponent.h"
+#include "Input/AimAssistTargetManagerComponent.h"
 #include "Components/ShapeComponent.h"
 
+void UAimAssistTargetComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// If the manager doesn't exist yet it picks up every target that has begun play once it does
+	if (UAimAssistTargetManagerComponent* TargetManager = UAimAssistTargetManagerComponent::Get(this))
+	{
+		TargetManager->RegisterTarget(this);
+	}
+}
+
+void UAimAssistTargetComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UAimAssistTargetManagerComponent* TargetManager = UAimAssistTargetManagerComponent::Get(this))
+	{
+		TargetManager->UnregisterTarget(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void UAimAssistTargetComponent::GatherTargetOptions(FAimAssistTargetOptions& OutTargetData)
 {
 	if (!TargetData.TargetShapeComponent.IsValid())
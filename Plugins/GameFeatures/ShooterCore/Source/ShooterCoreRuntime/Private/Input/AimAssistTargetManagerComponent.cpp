@@ -14,6 +14,10 @@
 #include "Character/LyraHealthComponent.h"
 #include "ShooterCoreRuntimeSettings.h"
 #include "DrawDebugHelpers.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/GameStateBase.h"
+#include "UObject/UObjectIterator.h"
 
 namespace LyraConsoleVariables
 {
@@ -81,10 +85,212 @@ static bool GatherTargetInfo(const AActor* Actor, const UShapeComponent* ShapeCo
 }
 
 
-void UAimAssistTargetManagerComponent::GetVisibleTargets(const FAimAssistFilter& Filter, const FAimAssistSettings& Settings, const FAimAssistOwnerViewData& OwnerData, const TArray<FLyraAimAssistTarget>& OldTargets, OUT TArray<FLyraAimAssistTarget>& OutNewTargets)
+UAimAssistTargetManagerComponent* UAimAssistTargetManagerComponent::Get(const UObject* WorldContextObject)
+{
+	if (const UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
+	{
+		if (const AGameStateBase* GameState = World->GetGameState())
+		{
+			return GameState->FindComponentByClass<UAimAssistTargetManagerComponent>();
+		}
+	}
+	return nullptr;
+}
+
+void UAimAssistTargetManagerComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// Targets that began play before the experience added this manager could not register themselves
+	UWorld* World = GetWorld();
+	for (UAimAssistTargetComponent* TargetComponent : TObjectRange<UAimAssistTargetComponent>())
+	{
+		if (TargetComponent->GetWorld() == World && TargetComponent->HasBegunPlay())
+		{
+			RegisterTarget(TargetComponent);
+		}
+	}
+}
+
+void UAimAssistTargetManagerComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	for (auto It = RegisteredTargets.CreateIterator(); It; ++It)
+	{
+		if (USceneComponent* TrackedComponent = It->TrackedComponent.Get())
+		{
+			TrackedComponent->TransformUpdated.Remove(It->TransformUpdatedHandle);
+		}
+	}
+
+	RegisteredTargets.Empty();
+	RegisteredTargetIndices.Empty();
+	TargetCells.Empty();
+	MaxTargetRadius = 0.0f;
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UAimAssistTargetManagerComponent::RegisterTarget(TScriptInterface<IAimAssistTaget> Target)
+{
+	UObject* TargetObject = Target.GetObject();
+	if (!TargetObject || RegisteredTargetIndices.Contains(TargetObject))
+	{
+		return;
+	}
+
+	USceneComponent* TrackedComponent = Cast<USceneComponent>(TargetObject);
+	if (!TrackedComponent)
+	{
+		if (AActor* TargetActor = Cast<AActor>(TargetObject))
+		{
+			TrackedComponent = TargetActor->GetRootComponent();
+		}
+	}
+
+	if (!TrackedComponent)
+	{
+		UE_LOG(LogAimAssist, Warning, TEXT("Aim assist target %s has no scene component to track, ignoring it."), *GetNameSafe(TargetObject));
+		return;
+	}
+
+	const int32 TargetIndex = RegisteredTargets.Add(FRegisteredTarget());
+	FRegisteredTarget& Entry = RegisteredTargets[TargetIndex];
+	Entry.Target = TargetObject;
+	Entry.TrackedComponent = TrackedComponent;
+	Entry.Cell = GetTargetCell(TrackedComponent->GetComponentLocation());
+	Entry.TransformUpdatedHandle = TrackedComponent->TransformUpdated.AddUObject(this, &ThisClass::HandleTargetTransformUpdated, TargetIndex);
+
+	RegisteredTargetIndices.Add(TargetObject, TargetIndex);
+	TargetCells.FindOrAdd(Entry.Cell).Add(TargetIndex);
+	MaxTargetRadius = FMath::Max(MaxTargetRadius, TrackedComponent->Bounds.SphereRadius);
+}
+
+void UAimAssistTargetManagerComponent::UnregisterTarget(TScriptInterface<IAimAssistTaget> Target)
+{
+	int32 TargetIndex = INDEX_NONE;
+	if (RegisteredTargetIndices.RemoveAndCopyValue(Target.GetObject(), TargetIndex))
+	{
+		RemoveTarget(TargetIndex);
+	}
+}
+
+void UAimAssistTargetManagerComponent::RemoveTarget(int32 TargetIndex)
+{
+	FRegisteredTarget& Entry = RegisteredTargets[TargetIndex];
+
+	if (USceneComponent* TrackedComponent = Entry.TrackedComponent.Get())
+	{
+		TrackedComponent->TransformUpdated.Remove(Entry.TransformUpdatedHandle);
+	}
+
+	if (TArray<int32>* CellTargets = TargetCells.Find(Entry.Cell))
+	{
+		CellTargets->RemoveSingleSwap(TargetIndex, false);
+		if (CellTargets->IsEmpty())
+		{
+			TargetCells.Remove(Entry.Cell);
+		}
+	}
+
+	RegisteredTargets.RemoveAt(TargetIndex);
+}
+
+FIntPoint UAimAssistTargetManagerComponent::GetTargetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / TargetCellSize), FMath::FloorToInt(Location.Y / TargetCellSize));
+}
+
+void UAimAssistTargetManagerComponent::HandleTargetTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport, int32 TargetIndex)
+{
+	FRegisteredTarget& Entry = RegisteredTargets[TargetIndex];
+
+	const FIntPoint NewCell = GetTargetCell(UpdatedComponent->GetComponentLocation());
+	if (NewCell != Entry.Cell)
+	{
+		if (TArray<int32>* OldCellTargets = TargetCells.Find(Entry.Cell))
+		{
+			OldCellTargets->RemoveSingleSwap(TargetIndex, false);
+			if (OldCellTargets->IsEmpty())
+			{
+				TargetCells.Remove(Entry.Cell);
+			}
+		}
+
+		TargetCells.FindOrAdd(NewCell).Add(TargetIndex);
+		Entry.Cell = NewCell;
+	}
+}
+
+// Whether an overlap query on the channel would find the target, which needs query collision that doesn't ignore the channel
+static bool CanTargetOverlapChannel(const UObject* TargetObject, const USceneComponent* TrackedComponent, ECollisionChannel Channel)
+{
+	auto CanComponentOverlap = [Channel](const UPrimitiveComponent* Component)
+	{
+		return Component->IsQueryCollisionEnabled() && (Component->GetCollisionResponseToChannel(Channel) != ECR_Ignore);
+	};
+
+	// Actor targets are found through any of their primitive components
+	if (const AActor* TargetActor = Cast<AActor>(TargetObject))
+	{
+		bool bCanOverlap = false;
+		TargetActor->ForEachComponent<UPrimitiveComponent>(/*bIncludeFromChildActors=*/ false, [&](const UPrimitiveComponent* Component)
+		{
+			bCanOverlap = bCanOverlap || CanComponentOverlap(Component);
+		});
+		return bCanOverlap;
+	}
+
+	const UPrimitiveComponent* PrimitiveComponent = Cast<UPrimitiveComponent>(TrackedComponent);
+	return PrimitiveComponent && CanComponentOverlap(PrimitiveComponent);
+}
+
+void UAimAssistTargetManagerComponent::QueryTargetsInBox(const FVector& Center, const FQuat& Rotation, const FVector& HalfExtents, ECollisionChannel Channel, TArray<int32>& OutTargetIndices) const
+{
+	OutTargetIndices.Reset();
+
+	const FBox WorldBounds = FBox(-HalfExtents, HalfExtents).TransformBy(FTransform(Rotation, Center)).ExpandBy(MaxTargetRadius);
+	const FIntPoint MinCell = GetTargetCell(WorldBounds.Min);
+	const FIntPoint MaxCell = GetTargetCell(WorldBounds.Max);
+
+	for (int32 CellX = MinCell.X; CellX <= MaxCell.X; ++CellX)
+	{
+		for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; ++CellY)
+		{
+			const TArray<int32>* CellTargets = TargetCells.Find(FIntPoint(CellX, CellY));
+			if (!CellTargets)
+			{
+				continue;
+			}
+
+			for (int32 TargetIndex : *CellTargets)
+			{
+				const FRegisteredTarget& Entry = RegisteredTargets[TargetIndex];
+				const USceneComponent* TrackedComponent = Entry.TrackedComponent.Get();
+				if (!TrackedComponent)
+				{
+					continue;
+				}
+
+				// Treat the target as its bounding sphere against the oriented box
+				const FVector LocalLocation = Rotation.UnrotateVector(TrackedComponent->GetComponentLocation() - Center);
+				const float Radius = TrackedComponent->Bounds.SphereRadius;
+				if (FMath::Abs(LocalLocation.X) <= HalfExtents.X + Radius && FMath::Abs(LocalLocation.Y) <= HalfExtents.Y + Radius && FMath::Abs(LocalLocation.Z) <= HalfExtents.Z + Radius)
+				{
+					if (CanTargetOverlapChannel(Entry.Target.Get(), TrackedComponent, Channel))
+					{
+						OutTargetIndices.Add(TargetIndex);
+					}
+				}
+			}
+		}
+	}
+}
+
+void UAimAssistTargetManagerComponent::GetVisibleTargets(const FAimAssistFilter& Filter, const FAimAssistSettings& Settings, const FAimAssistOwnerViewData& OwnerData, const TArray<FLyraAimAssistTarget>& OldTargets, OUT TArray<FLyraAimAssistTarget>& OutNewTargets, FAimAssistTargetQueryBuffer& Buffer)
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(UAimAssistTargetManagerComponent::GetVisibleTargets);
 	OutNewTargets.Reset();
+	Buffer.Reset();
 	const APlayerController* PC = OwnerData.PlayerController;
 	
 	if (!PC)
@@ -116,142 +322,123 @@ void UAimAssistTargetManagerComponent::GetVisibleTargets(const FAimAssistFilter&
 	const FBox2D AssistOuterReticleBounds = OwnerData.ProjectReticleToScreen(Settings.AssistOuterReticleWidth.GetValue(), Settings.AssistOuterReticleHeight.GetValue(), ReticleDepth);
 	const FBox2D TargetingReticleBounds = OwnerData.ProjectReticleToScreen(Settings.TargetingReticleWidth.GetValue(), Settings.TargetingReticleHeight.GetValue(), ReticleDepth);
 
-	static TArray<FOverlapResult> OverlapResults;
-	// Do a world trace on the Aim Assist channel to get any visible targets
+	// Find the registered targets inside the viewfinder box
 	{
-		UWorld* World = GetWorld();
-		
-		OverlapResults.Reset();
-
 		const FVector PawnLocation = OwnerPawn->GetActorLocation();
-		ECollisionChannel AimAssistChannel = GetAimAssistChannel();
-		FCollisionQueryParams Params(SCENE_QUERY_STAT(AimAssist_QueryTargetsInRange), true);
-		Params.AddIgnoredActor(OwnerPawn);
 
-		// Need to multiply these by 0.5 because MakeBox takes in half extents
-		FCollisionShape BoxShape = FCollisionShape::MakeBox(FVector3f(ReticleDepth * 0.5f, Settings.AssistOuterReticleWidth.GetValue() * 0.5f, Settings.AssistOuterReticleHeight.GetValue() * 0.5f));						
-		World->OverlapMultiByChannel(OUT OverlapResults, PawnLocation, OwnerData.PlayerTransform.GetRotation(), AimAssistChannel, BoxShape, Params);
+		// Need to multiply these by 0.5 because the box is described by its half extents
+		const FVector BoxHalfExtents(ReticleDepth * 0.5f, Settings.AssistOuterReticleWidth.GetValue() * 0.5f, Settings.AssistOuterReticleHeight.GetValue() * 0.5f);
+		QueryTargetsInBox(PawnLocation, OwnerData.PlayerTransform.GetRotation(), BoxHalfExtents, GetAimAssistChannel(), Buffer.RegisteredTargets);
 
 #if ENABLE_DRAW_DEBUG && !UE_BUILD_SHIPPING
 		if(LyraConsoleVariables::bDrawDebugViewfinder)
 		{
-			DrawDebugBox(World, PawnLocation, BoxShape.GetBox(), OwnerData.PlayerTransform.GetRotation(), FColor::Red);	
+			DrawDebugBox(GetWorld(), PawnLocation, BoxHalfExtents, OwnerData.PlayerTransform.GetRotation(), FColor::Red);	
 		}
 #endif
 	}
 
-	// Gather target options from any visibile hit results that implement the IAimAssistTarget interface
-	TArray<FAimAssistTargetOptions> NewTargetData;
+	// Gather targets that are in front of the player, and the vertices of their shapes to project them all at once
+	for (int32 TargetIndex : Buffer.RegisteredTargets)
 	{
-		for (const FOverlapResult& Overlap : OverlapResults)
+		IAimAssistTaget* Target = Cast<IAimAssistTaget>(RegisteredTargets[TargetIndex].Target.Get());
+		if (!Target)
 		{
-			TScriptInterface<IAimAssistTaget> TargetActor(Overlap.GetActor());
-			if (TargetActor)
-			{
-				FAimAssistTargetOptions TargetData;
-				TargetActor->GatherTargetOptions(TargetData);
-				NewTargetData.Add(TargetData);
-			}
-			
-			TScriptInterface<IAimAssistTaget> TargetComponent(Overlap.GetComponent());
-			if (TargetComponent)
-			{
-				FAimAssistTargetOptions TargetData;
-				TargetComponent->GatherTargetOptions(TargetData);
-				NewTargetData.Add(TargetData);
-			}			
+			continue;
+		}
+
+		FAimAssistTargetOptions AimAssistTarget;
+		Target->GatherTargetOptions(AimAssistTarget);
+
+		if (!DoesTargetPassFilter(OwnerData, Filter, AimAssistTarget, TargetRange))
+		{
+			continue;
 		}
-	}
-	
-	// Gather targets that are in front of the player
-	{
-		const FVector PawnLocation = OwnerPawn->GetActorLocation();		
 		
-		for (FAimAssistTargetOptions& AimAssistTarget : NewTargetData)
+		AActor* OwningActor = AimAssistTarget.TargetShapeComponent->GetOwner();
+
+		FTransform TargetTransform;
+		FCollisionShape TargetShape;
+		FVector TargetShapeOrigin;
+
+		if (!GatherTargetInfo(OwningActor, AimAssistTarget.TargetShapeComponent.Get(), TargetTransform, TargetShape, TargetShapeOrigin))
 		{
-			if (!DoesTargetPassFilter(OwnerData, Filter, AimAssistTarget, TargetRange))
-			{
-				continue;
-			}
-			
-			AActor* OwningActor = AimAssistTarget.TargetShapeComponent->GetOwner();
+			continue;
+		}
+		
+		const FVector TargetViewLocation = TargetTransform.TransformPositionNoScale(TargetShapeOrigin);
+		const FVector TargetViewVector = (TargetViewLocation - ViewLocation);
+
+		FVector TargetViewDirection;
+		float TargetViewDistance;
+		TargetViewVector.ToDirectionAndLength(TargetViewDirection, TargetViewDistance);
+		const float TargetViewDot = FVector::DotProduct(TargetViewDirection, ViewForward);
+		if (TargetViewDot <= 0.0f)
+		{
+			continue;
+		}
 
-			FTransform TargetTransform;
-			FCollisionShape TargetShape;
-			FVector TargetShapeOrigin;
+		const int32 NumVertices = OwnerData.AppendShapeVertices(TargetShape, TargetShapeOrigin, TargetTransform, Buffer.ShapeVertices);
+		if (NumVertices == 0)
+		{
+			continue;
+		}
 
-			if (!GatherTargetInfo(OwningActor, AimAssistTarget.TargetShapeComponent.Get(), TargetTransform, TargetShape, TargetShapeOrigin))
-			{
-				continue;
-			}
-			
-			const FVector TargetViewLocation = TargetTransform.TransformPositionNoScale(TargetShapeOrigin);
-			const FVector TargetViewVector = (TargetViewLocation - ViewLocation);
-
-			FVector TargetViewDirection;
-			float TargetViewDistance;
-			TargetViewVector.ToDirectionAndLength(TargetViewDirection, TargetViewDistance);
-			const float TargetViewDot = FVector::DotProduct(TargetViewDirection, ViewForward);
-			if (TargetViewDot <= 0.0f)
-			{
-				continue;
-			}
-			
-			const FLyraAimAssistTarget* OldTarget = FindTarget(OldTargets, AimAssistTarget.TargetShapeComponent.Get());
+		FAimAssistTargetQueryBuffer::FCandidate& Candidate = Buffer.Candidates.AddDefaulted_GetRef();
+		Candidate.TargetShapeComponent = AimAssistTarget.TargetShapeComponent;
+		Candidate.Location = TargetTransform.GetTranslation();
+		Candidate.ViewDistance = TargetViewDistance;
+		Candidate.ViewDot = TargetViewDot;
+		Buffer.ShapeVertexCounts.Add(NumVertices);
+	}
 
-			// Calculate the screen bounds for this target
-			FBox2D TargetScreenBounds(ForceInitToZero);
-			const bool bUpdateTargetProjections = true;
-			if (bUpdateTargetProjections)
-			{
-				TargetScreenBounds = OwnerData.ProjectShapeToScreen(TargetShape, TargetShapeOrigin, TargetTransform);
-			}
-			else
-			{
-				// Target projections are not being updated so use the values from the previous frame if the target existed.
-				if (OldTarget)
-				{
-					TargetScreenBounds = OldTarget->ScreenBounds;
-				}
-			}
+	// Calculate the screen bounds for all targets
+	Buffer.ScreenBounds.SetNumUninitialized(Buffer.Candidates.Num());
+	OwnerData.ProjectShapesToScreen(Buffer.ShapeVertices, Buffer.ShapeVertexCounts, Buffer.ScreenBounds);
 
-			if (!TargetScreenBounds.bIsValid)
-			{
-				continue;
-			}
+	for (int32 CandidateIndex = 0; CandidateIndex < Buffer.Candidates.Num(); ++CandidateIndex)
+	{
+		const FAimAssistTargetQueryBuffer::FCandidate& Candidate = Buffer.Candidates[CandidateIndex];
+		const FBox2D& TargetScreenBounds = Buffer.ScreenBounds[CandidateIndex];
 
-			if (!TargetingReticleBounds.Intersect(TargetScreenBounds))
-			{
-				continue;
-			}
+		if (!TargetScreenBounds.bIsValid)
+		{
+			continue;
+		}
 
-			FLyraAimAssistTarget NewTarget;
-
-			NewTarget.TargetShapeComponent = AimAssistTarget.TargetShapeComponent;
-			NewTarget.Location = TargetTransform.GetTranslation();
-			NewTarget.ScreenBounds = TargetScreenBounds;
-			NewTarget.ViewDistance = TargetViewDistance;
-			NewTarget.bUnderAssistInnerReticle = AssistInnerReticleBounds.Intersect(TargetScreenBounds);
-			NewTarget.bUnderAssistOuterReticle = AssistOuterReticleBounds.Intersect(TargetScreenBounds);
-			
-			// Transfer target data from last frame.
-			if (OldTarget)
-			{
-				NewTarget.DeltaMovement = (NewTarget.Location - OldTarget->Location);
-				NewTarget.AssistTime = OldTarget->AssistTime;
-				NewTarget.AssistWeight = OldTarget->AssistWeight;
-				NewTarget.VisibilityTraceHandle = OldTarget->VisibilityTraceHandle;
-			}
+		if (!TargetingReticleBounds.Intersect(TargetScreenBounds))
+		{
+			continue;
+		}
 
-			// Calculate a score used for sorting based on previous weight, distance from target, and distance from reticle.
-			const float AssistWeightScore = (NewTarget.AssistWeight * Settings.TargetScore_AssistWeight);
-			const float ViewDotScore = ((TargetViewDot * Settings.TargetScore_ViewDot) - Settings.TargetScore_ViewDotOffset);
-			const float ViewDistanceScore = ((1.0f - (TargetViewDistance / TargetRange)) * Settings.TargetScore_ViewDistance);
+		const FLyraAimAssistTarget* OldTarget = FindTarget(OldTargets, Candidate.TargetShapeComponent.Get());
 
-			NewTarget.SortScore = (AssistWeightScore + ViewDotScore + ViewDistanceScore);
+		FLyraAimAssistTarget NewTarget;
 
-			OutNewTargets.Add(NewTarget);
+		NewTarget.TargetShapeComponent = Candidate.TargetShapeComponent;
+		NewTarget.Location = Candidate.Location;
+		NewTarget.ScreenBounds = TargetScreenBounds;
+		NewTarget.ViewDistance = Candidate.ViewDistance;
+		NewTarget.bUnderAssistInnerReticle = AssistInnerReticleBounds.Intersect(TargetScreenBounds);
+		NewTarget.bUnderAssistOuterReticle = AssistOuterReticleBounds.Intersect(TargetScreenBounds);
+		
+		// Transfer target data from last frame.
+		if (OldTarget)
+		{
+			NewTarget.DeltaMovement = (NewTarget.Location - OldTarget->Location);
+			NewTarget.AssistTime = OldTarget->AssistTime;
+			NewTarget.AssistWeight = OldTarget->AssistWeight;
+			NewTarget.VisibilityTraceHandle = OldTarget->VisibilityTraceHandle;
 		}
+
+		// Calculate a score used for sorting based on previous weight, distance from target, and distance from reticle.
+		const float AssistWeightScore = (NewTarget.AssistWeight * Settings.TargetScore_AssistWeight);
+		const float ViewDotScore = ((Candidate.ViewDot * Settings.TargetScore_ViewDot) - Settings.TargetScore_ViewDotOffset);
+		const float ViewDistanceScore = ((1.0f - (Candidate.ViewDistance / TargetRange)) * Settings.TargetScore_ViewDistance);
+
+		NewTarget.SortScore = (AssistWeightScore + ViewDotScore + ViewDistanceScore);
+
+		OutNewTargets.Add(NewTarget);
 	}
 
 	// Sort the targets by their score so if there are too many so we can limit the amount of visibility traces performed.
@@ -2,11 +2,32 @@
 
 #include "LyraWorldCollectable.h"
 #include "EngineUtils.h"
+#include "Interaction/LyraInteractionSubsystem.h"
 
 ALyraWorldCollectable::ALyraWorldCollectable()
 {
 }
 
+void ALyraWorldCollectable::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (ULyraInteractionSubsystem* InteractionSubsystem = GetWorld()->GetSubsystem<ULyraInteractionSubsystem>())
+	{
+		InteractionSubsystem->RegisterInteractable(this);
+	}
+}
+
+void ALyraWorldCollectable::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (ULyraInteractionSubsystem* InteractionSubsystem = GetWorld()->GetSubsystem<ULyraInteractionSubsystem>())
+	{
+		InteractionSubsystem->UnregisterInteractable(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void ALyraWorldCollectable::GatherInteractionOptions(const FInteractionQuery& InteractQuery, FInteractionOptionBuilder& InteractionBuilder)
 {
 	InteractionBuilder.AddInteractionOption(Option);
@@ -4,17 +4,114 @@
 #include "Character/LyraPawn.h"
 #include "Teams/LyraTeamSubsystem.h"
 #include "GameModes/LyraGameState.h"
+#include "GameFramework/GameModeBase.h"
 #include "GameFramework/PlayerState.h"
+#include "Messages/LyraVerbMessage.h"
+#include "NativeGameplayTags.h"
 #include "Player/LyraPlayerStart.h"
 #include "Engine/World.h"
 
+UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Lyra_Elimination_Message, "Lyra.Elimination.Message");
+
 UTDM_PlayerSpawningManagmentComponent::UTDM_PlayerSpawningManagmentComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
 }
 
+void UTDM_PlayerSpawningManagmentComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (GetOwner()->HasAuthority())
+	{
+		UGameplayMessageSubsystem& MessageSubsystem = UGameplayMessageSubsystem::Get(this);
+		EliminationListenerHandle = MessageSubsystem.RegisterListener(TAG_Lyra_Elimination_Message, this, &ThisClass::OnEliminationMessage);
+	}
+}
+
+void UTDM_PlayerSpawningManagmentComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	EliminationListenerHandle.Unregister();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UTDM_PlayerSpawningManagmentComponent::OnEliminationMessage(FGameplayTag Channel, const FLyraVerbMessage& Payload)
+{
+	if (const APlayerState* TargetPS = Cast<APlayerState>(Payload.Target))
+	{
+		if (const APawn* Pawn = TargetPS->GetPawn())
+		{
+			RecentDeaths.Add({ Pawn->GetActorLocation(), GetWorld()->GetTimeSeconds() });
+		}
+	}
+}
+
+void UTDM_PlayerSpawningManagmentComponent::UpdatePawnSnapshot()
+{
+	if (PawnSnapshotFrame == GFrameCounter)
+	{
+		return;
+	}
+	PawnSnapshotFrame = GFrameCounter;
+
+	PawnX.Reset();
+	PawnY.Reset();
+	PawnZ.Reset();
+	PawnTeamIds.Reset();
+
+	ULyraTeamSubsystem* TeamSubsystem = GetWorld()->GetSubsystem<ULyraTeamSubsystem>();
+	ALyraGameState* GameState = GetGameStateChecked<ALyraGameState>();
+
+	for (APlayerState* PS : GameState->PlayerArray)
+	{
+		const int32 TeamId = TeamSubsystem->FindTeamFromObject(PS);
+
+		// We should have a TeamId by now...
+		if (PS->IsOnlyASpectator() || !ensure(TeamId != INDEX_NONE))
+		{
+			continue;
+		}
+
+		if (APawn* Pawn = PS->GetPawn())
+		{
+			const FVector Location = Pawn->GetActorLocation();
+			PawnX.Add(Location.X);
+			PawnY.Add(Location.Y);
+			PawnZ.Add(Location.Z);
+			PawnTeamIds.Add(TeamId);
+		}
+	}
+
+	// Expire eliminations here too, so the scoring terms never see stale entries
+	const double ExpiredTime = GetWorld()->GetTimeSeconds() - RecentDeathLifetime;
+	RecentDeaths.RemoveAll([ExpiredTime](const FRecentDeath& Death) { return Death.Time < ExpiredTime; });
+}
+
+ELyraPlayerStartLocationOccupancy UTDM_PlayerSpawningManagmentComponent::GetCachedLocationOccupancy(ALyraPlayerStart* PlayerStart, AController* Player)
+{
+	if (OccupancyCacheFrame != GFrameCounter)
+	{
+		OccupancyCache.Reset();
+		OccupancyCacheFrame = GFrameCounter;
+	}
+
+	const AGameModeBase* GameMode = GetWorld()->GetAuthGameMode();
+	const UClass* PawnClass = GameMode ? GameMode->GetDefaultPawnClassForController(Player) : nullptr;
+
+	const TPair<TObjectKey<ALyraPlayerStart>, TObjectKey<UClass>> Key(PlayerStart, PawnClass);
+	if (const ELyraPlayerStartLocationOccupancy* Occupancy = OccupancyCache.Find(Key))
+	{
+		return *Occupancy;
+	}
+
+	return OccupancyCache.Add(Key, PlayerStart->GetLocationOccupancy(Player));
+}
+
 AActor* UTDM_PlayerSpawningManagmentComponent::OnChoosePlayerStart(AController* Player, TArray<ALyraPlayerStart*>& PlayerStarts)
 {
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_TDM_PlayerSpawning_ChoosePlayerStart);
+
 	ULyraTeamSubsystem* TeamSubsystem = GetWorld()->GetSubsystem<ULyraTeamSubsystem>();
 	const int32 PlayerTeamId = TeamSubsystem->FindTeamFromObject(Player);
 
@@ -24,62 +121,181 @@ AActor* UTDM_PlayerSpawningManagmentComponent::OnChoosePlayerStart(AController*
 		return nullptr;
 	}
 
-	ALyraGameState* GameState = GetGameStateChecked<ALyraGameState>();
+	UpdatePawnSnapshot();
+
+	TArray<float, TInlineAllocator<64>> EnemyX;
+	TArray<float, TInlineAllocator<64>> EnemyY;
+	TArray<float, TInlineAllocator<64>> EnemyZ;
+	for (int32 PawnIndex = 0; PawnIndex < PawnTeamIds.Num(); ++PawnIndex)
+	{
+		if (PawnTeamIds[PawnIndex] != PlayerTeamId)
+		{
+			EnemyX.Add(PawnX[PawnIndex]);
+			EnemyY.Add(PawnY[PawnIndex]);
+			EnemyZ.Add(PawnZ[PawnIndex]);
+		}
+	}
+
+	// Without anyone to get away from every start is as good as any other, let the default random pick handle it
+	if (EnemyX.IsEmpty() || PlayerStarts.IsEmpty())
+	{
+		return nullptr;
+	}
+
+	TArray<FVector, TInlineAllocator<256>> StartLocations;
+	StartLocations.Reserve(PlayerStarts.Num());
+	for (const ALyraPlayerStart* PlayerStart : PlayerStarts)
+	{
+		StartLocations.Add(PlayerStart->GetActorLocation());
+	}
 
-	ALyraPlayerStart* BestPlayerStart = nullptr;
-	double MaxDistance = 0;
+	FTDMSpawnScoringContext Context;
+	Context.Player = Player;
+	Context.PlayerTeamId = PlayerTeamId;
+	Context.StartLocations = StartLocations;
+	Context.EnemyX = EnemyX;
+	Context.EnemyY = EnemyY;
+	Context.EnemyZ = EnemyZ;
+
+	TArray<float, TInlineAllocator<256>> Scores;
+	Scores.SetNumZeroed(PlayerStarts.Num());
+	ScorePlayerStarts(Context, Scores);
+
+	// Claimed starts are only a fallback for when every unclaimed start is blocked
+	TArray<int32, TInlineAllocator<256>> Candidates;
 	ALyraPlayerStart* FallbackPlayerStart = nullptr;
-	double FallbackMaxDistance = 0;
+	float FallbackScore = 0.0f;
+	for (int32 StartIndex = 0; StartIndex < PlayerStarts.Num(); ++StartIndex)
+	{
+		if (PlayerStarts[StartIndex]->IsClaimed())
+		{
+			if (FallbackPlayerStart == nullptr || Scores[StartIndex] > FallbackScore)
+			{
+				FallbackPlayerStart = PlayerStarts[StartIndex];
+				FallbackScore = Scores[StartIndex];
+			}
+		}
+		else
+		{
+			Candidates.Add(StartIndex);
+		}
+	}
 
-	for (APlayerState* PS : GameState->PlayerArray)
+	const auto ByScore = [&Scores](int32 A, int32 B) { return Scores[A] > Scores[B]; };
+	Candidates.Sort(ByScore);
+
+	if (LineOfSightCandidateCount > 0 && LineOfSightPenalty > 0.0f && Candidates.Num() > 0)
 	{
-		const int32 TeamId = TeamSubsystem->FindTeamFromObject(PS);
-		
-		// We should have a TeamId by now...
-		if (PS->IsOnlyASpectator() || !ensure(TeamId != INDEX_NONE))
+		const int32 NumTraced = FMath::Min(LineOfSightCandidateCount, Candidates.Num());
+		ApplyLineOfSightScores(Context, MakeArrayView(Candidates.GetData(), NumTraced), Scores);
+		Candidates.Sort(ByScore);
+	}
+
+	// Only now pay for collision queries, best first, stopping at the first start the pawn fits in
+	for (int32 StartIndex : Candidates)
+	{
+		if (GetCachedLocationOccupancy(PlayerStarts[StartIndex], Player) < ELyraPlayerStartLocationOccupancy::Full)
 		{
-			continue;
+			return PlayerStarts[StartIndex];
+		}
+	}
+
+	return FallbackPlayerStart;
+}
+
+void UTDM_PlayerSpawningManagmentComponent::ScorePlayerStarts(const FTDMSpawnScoringContext& Context, TArrayView<float> Scores) const
+{
+	AddEnemyDistanceScores(Context, Scores);
+	AddRecentDeathScores(Context, Scores);
+}
+
+void UTDM_PlayerSpawningManagmentComponent::AddEnemyDistanceScores(const FTDMSpawnScoringContext& Context, TArrayView<float> Scores) const
+{
+	const float* RESTRICT EnemyX = Context.EnemyX.GetData();
+	const float* RESTRICT EnemyY = Context.EnemyY.GetData();
+	const float* RESTRICT EnemyZ = Context.EnemyZ.GetData();
+	const int32 NumEnemies = Context.EnemyX.Num();
+
+	for (int32 StartIndex = 0; StartIndex < Scores.Num(); ++StartIndex)
+	{
+		const float StartX = Context.StartLocations[StartIndex].X;
+		const float StartY = Context.StartLocations[StartIndex].Y;
+		const float StartZ = Context.StartLocations[StartIndex].Z;
+
+		float MinDistanceSquared = BIG_NUMBER;
+		for (int32 EnemyIndex = 0; EnemyIndex < NumEnemies; ++EnemyIndex)
+		{
+			const float DX = EnemyX[EnemyIndex] - StartX;
+			const float DY = EnemyY[EnemyIndex] - StartY;
+			const float DZ = EnemyZ[EnemyIndex] - StartZ;
+			MinDistanceSquared = FMath::Min(MinDistanceSquared, DX * DX + DY * DY + DZ * DZ);
 		}
 
-		// If the other player isn't on the same team, lets find the furthest spawn from them.
-		if (TeamId != PlayerTeamId)
+		Scores[StartIndex] += EnemyDistanceWeight * FMath::Sqrt(MinDistanceSquared);
+	}
+}
+
+void UTDM_PlayerSpawningManagmentComponent::AddRecentDeathScores(const FTDMSpawnScoringContext& Context, TArrayView<float> Scores) const
+{
+	if (RecentDeaths.IsEmpty() || RecentDeathPenalty <= 0.0f || RecentDeathLifetime <= 0.0f)
+	{
+		return;
+	}
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	const double RadiusSquared = FMath::Square(RecentDeathRadius);
+
+	for (const FRecentDeath& Death : RecentDeaths)
+	{
+		const float Penalty = RecentDeathPenalty * (1.0f - FMath::Clamp(float(Now - Death.Time) / RecentDeathLifetime, 0.0f, 1.0f));
+
+		for (int32 StartIndex = 0; StartIndex < Scores.Num(); ++StartIndex)
 		{
-			for (ALyraPlayerStart* PlayerStart : PlayerStarts)
+			if (FVector::DistSquared(Context.StartLocations[StartIndex], Death.Location) < RadiusSquared)
 			{
-				if (APawn* Pawn = PS->GetPawn())
-				{
-					const double Distance = PlayerStart->GetDistanceTo(Pawn);
-
-					if (PlayerStart->IsClaimed())
-					{
-						if (FallbackPlayerStart == nullptr || Distance > FallbackMaxDistance)
-						{
-							FallbackPlayerStart = PlayerStart;
-							FallbackMaxDistance = Distance;
-						}
-					}
-					else if (PlayerStart->GetLocationOccupancy(Player) < ELyraPlayerStartLocationOccupancy::Full)
-					{
-						if (BestPlayerStart == nullptr || Distance > MaxDistance)
-						{
-							BestPlayerStart = PlayerStart;
-							MaxDistance = Distance;
-						}
-					}
-				}
+				Scores[StartIndex] -= Penalty;
 			}
 		}
 	}
+}
 
-	if (BestPlayerStart)
+void UTDM_PlayerSpawningManagmentComponent::ApplyLineOfSightScores(const FTDMSpawnScoringContext& Context, TArrayView<const int32> CandidateIndices, TArrayView<float> Scores) const
+{
+	UWorld* World = GetWorld();
+	const APawn* PawnToFit = nullptr;
+	if (const AGameModeBase* GameMode = World->GetAuthGameMode())
 	{
-		return BestPlayerStart;
+		const UClass* PawnClass = GameMode->GetDefaultPawnClassForController(Context.Player);
+		PawnToFit = PawnClass ? GetDefault<APawn>(PawnClass) : nullptr;
 	}
+	const FVector EyeOffset(0.0f, 0.0f, PawnToFit ? PawnToFit->BaseEyeHeight : 64.0f);
+	const double MaxDistanceSquared = FMath::Square(LineOfSightMaxDistance);
 
-	return FallbackPlayerStart;
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(TDM_SpawnLineOfSight), /*bTraceComplex=*/ false);
+
+	for (int32 StartIndex : CandidateIndices)
+	{
+		const FVector EyeLocation = Context.StartLocations[StartIndex] + EyeOffset;
+
+		for (int32 EnemyIndex = 0; EnemyIndex < Context.EnemyX.Num(); ++EnemyIndex)
+		{
+			const FVector EnemyLocation(Context.EnemyX[EnemyIndex], Context.EnemyY[EnemyIndex], Context.EnemyZ[EnemyIndex]);
+			if (FVector::DistSquared(EyeLocation, EnemyLocation) > MaxDistanceSquared)
+			{
+				continue;
+			}
+
+			// The enemy pawn itself blocks visibility, so anything hit short of it means the view is obstructed
+			FHitResult Hit;
+			if (!World->LineTraceSingleByChannel(Hit, EyeLocation, EnemyLocation + EyeOffset, ECC_Visibility, QueryParams) || Hit.GetActor() == nullptr || Hit.GetActor()->IsA<APawn>())
+			{
+				Scores[StartIndex] -= LineOfSightPenalty;
+			}
+		}
+	}
 }
 
 void UTDM_PlayerSpawningManagmentComponent::OnFinishRestartPlayer(AController* Player, const FRotator& StartRotation)
 {
 	
-}
\ No newline at end of file
+}
@@ -3,11 +3,35 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "GameFramework/GameplayMessageSubsystem.h"
 #include "Player/LyraPlayerSpawningManagerComponent.h"
+#include "Player/LyraPlayerStart.h"
+#include "UObject/ObjectKey.h"
 #include "TDM_PlayerSpawningManagmentComponent.generated.h"
 
+struct FLyraVerbMessage;
+
+/** Everything a scoring term needs to know about a single spawn request */
+struct FTDMSpawnScoringContext
+{
+	AController* Player = nullptr;
+	int32 PlayerTeamId = INDEX_NONE;
+
+	/** Start locations, parallel to the Scores array handed to the scoring terms */
+	TConstArrayView<FVector> StartLocations;
+
+	/** Positions of every living enemy pawn, split into components so the distance pass vectorizes */
+	TConstArrayView<float> EnemyX;
+	TConstArrayView<float> EnemyY;
+	TConstArrayView<float> EnemyZ;
+};
+
 /**
- * 
+ * Team deathmatch spawning: picks the start that scores best against the living enemies.
+ *
+ * Enemy pawn positions are gathered at most once per frame and start occupancy (a collision query)
+ * is cached per frame and only evaluated for the best candidates, so a respawn wave costs one
+ * scoring pass per player instead of a collision query per player and start.
  */
 UCLASS()
 class UTDM_PlayerSpawningManagmentComponent : public ULyraPlayerSpawningManagerComponent
@@ -18,9 +42,83 @@ public:
 
 	UTDM_PlayerSpawningManagmentComponent(const FObjectInitializer& ObjectInitializer);
 
+	//~UActorComponent interface
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	//~End of UActorComponent interface
+
 	virtual AActor* OnChoosePlayerStart(AController* Player, TArray<ALyraPlayerStart*>& PlayerStarts) override;
 	virtual void OnFinishRestartPlayer(AController* Player, const FRotator& StartRotation) override;
 
 protected:
 
+	/**
+	 * Adds every scoring term to Scores, higher is better. Override to add or replace terms;
+	 * terms that need queries should restrict themselves to the best few starts.
+	 */
+	virtual void ScorePlayerStarts(const FTDMSpawnScoringContext& Context, TArrayView<float> Scores) const;
+
+	/** Scores each start by the distance to the closest enemy */
+	void AddEnemyDistanceScores(const FTDMSpawnScoringContext& Context, TArrayView<float> Scores) const;
+
+	/** Penalizes starts close to recent eliminations, fading out over RecentDeathLifetime */
+	void AddRecentDeathScores(const FTDMSpawnScoringContext& Context, TArrayView<float> Scores) const;
+
+	/** Penalizes the candidate starts an enemy can see; these are line traces so only CandidateIndices are tested */
+	void ApplyLineOfSightScores(const FTDMSpawnScoringContext& Context, TArrayView<const int32> CandidateIndices, TArrayView<float> Scores) const;
+
+	/** Score per centimeter to the closest enemy */
+	UPROPERTY(EditDefaultsOnly, Category = "Spawn Scoring")
+	float EnemyDistanceWeight = 1.0f;
+
+	/** Score removed for a start right on top of an elimination that just happened */
+	UPROPERTY(EditDefaultsOnly, Category = "Spawn Scoring")
+	float RecentDeathPenalty = 2000.0f;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Spawn Scoring")
+	float RecentDeathRadius = 1500.0f;
+
+	/** Seconds an elimination keeps penalizing nearby starts */
+	UPROPERTY(EditDefaultsOnly, Category = "Spawn Scoring")
+	float RecentDeathLifetime = 10.0f;
+
+	/** Score removed for each enemy with line of sight to a start */
+	UPROPERTY(EditDefaultsOnly, Category = "Spawn Scoring")
+	float LineOfSightPenalty = 3000.0f;
+
+	/** Enemies further away than this are not traced against */
+	UPROPERTY(EditDefaultsOnly, Category = "Spawn Scoring")
+	float LineOfSightMaxDistance = 5000.0f;
+
+	/** How many of the best starts get line of sight traces, 0 disables the term */
+	UPROPERTY(EditDefaultsOnly, Category = "Spawn Scoring")
+	int32 LineOfSightCandidateCount = 4;
+
+private:
+	void OnEliminationMessage(FGameplayTag Channel, const FLyraVerbMessage& Payload);
+
+	void UpdatePawnSnapshot();
+
+	ELyraPlayerStartLocationOccupancy GetCachedLocationOccupancy(ALyraPlayerStart* PlayerStart, AController* Player);
+
+	struct FRecentDeath
+	{
+		FVector Location;
+		double Time;
+	};
+
+	/** Living pawn positions and teams, refreshed on the first spawn request of a frame */
+	TArray<float> PawnX;
+	TArray<float> PawnY;
+	TArray<float> PawnZ;
+	TArray<int32> PawnTeamIds;
+	uint64 PawnSnapshotFrame = 0;
+
+	/** Occupancy only depends on the start and the pawn class that has to fit there */
+	TMap<TPair<TObjectKey<ALyraPlayerStart>, TObjectKey<UClass>>, ELyraPlayerStartLocationOccupancy> OccupancyCache;
+	uint64 OccupancyCacheFrame = 0;
+
+	TArray<FRecentDeath> RecentDeaths;
+
+	FGameplayMessageListenerHandle EliminationListenerHandle;
 };
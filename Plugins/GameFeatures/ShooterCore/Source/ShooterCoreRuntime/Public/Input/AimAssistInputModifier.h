@@ -44,6 +44,12 @@ struct FAimAssistOwnerViewData
 	FBox2D ProjectSphereToScreen(const FCollisionShape& Shape, const FVector& ShapeOrigin, const FTransform& WorldTransform) const;
 	FBox2D ProjectCapsuleToScreen(const FCollisionShape& Shape, const FVector& ShapeOrigin, const FTransform& WorldTransform) const;
 
+	/** Appends the world space vertices whose screen bounds bound the shape, returns how many were added */
+	int32 AppendShapeVertices(const FCollisionShape& Shape, const FVector& ShapeOrigin, const FTransform& WorldTransform, TArray<FVector>& OutVertices) const;
+
+	/** Projects many shapes at once, ShapeVertexCounts splits Vertices into consecutive runs with one screen bounds each */
+	void ProjectShapesToScreen(TConstArrayView<FVector> Vertices, TConstArrayView<int32> ShapeVertexCounts, TArrayView<FBox2D> OutScreenBounds) const;
+
 	/** Pointer to the player controller that can be used to calculate the data we need to check for visible targets */
 	const APlayerController* PlayerController = nullptr;
 
@@ -110,6 +116,36 @@ protected:
 	float CalculateRotationToTarget2D(float TargetX, float TargetY, float OffsetY) const;
 };
 
+/** Scratch memory for gathering targets, owned by each modifier so split screen players never share it */
+struct FAimAssistTargetQueryBuffer
+{
+	struct FCandidate
+	{
+		TWeakObjectPtr<UShapeComponent> TargetShapeComponent;
+		FVector Location = FVector::ZeroVector;
+		float ViewDistance = 0.0f;
+		float ViewDot = 0.0f;
+	};
+
+	/** Registered target indices found in the spatial hash */
+	TArray<int32> RegisteredTargets;
+
+	/** Targets that passed the filter, projected to screen together */
+	TArray<FCandidate> Candidates;
+	TArray<FVector> ShapeVertices;
+	TArray<int32> ShapeVertexCounts;
+	TArray<FBox2D> ScreenBounds;
+
+	void Reset()
+	{
+		RegisteredTargets.Reset();
+		Candidates.Reset();
+		ShapeVertices.Reset();
+		ShapeVertexCounts.Reset();
+		ScreenBounds.Reset();
+	}
+};
+
 /** Options for filtering out certain aim assist targets */
 USTRUCT(BlueprintType)
 struct FAimAssistFilter
@@ -387,6 +423,8 @@ protected:
 	/** The current in use target cache */
 	uint32 TargetCacheIndex;
 
+	FAimAssistTargetQueryBuffer TargetQueryBuffer;
+
 	FAimAssistOwnerViewData OwnerViewData;
 
 	float LastPullStrength = 0.0f;
@@ -16,6 +16,11 @@ class SHOOTERCORERUNTIME_API UAimAssistTargetComponent : public UCapsuleComponen
 	GENERATED_BODY()
 
 public:
+
+	//~ Begin UActorComponent interface
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	//~ End UActorComponent interface
 	
 	//~ Begin IAimAssistTaget interface
 	virtual void GatherTargetOptions(OUT FAimAssistTargetOptions& TargetData) override;
@@ -7,14 +7,18 @@
 #include "Input/AimAssistInputModifier.h"
 #include "Input/IAimAssistTargetInterface.h"
 #include "CommonInputBaseTypes.h"
+#include "Components/SceneComponent.h"
+#include "Containers/SparseArray.h"
+#include "UObject/ObjectKey.h"
 #include "AimAssistTargetManagerComponent.generated.h"
 
 class APlayerController;
 
 /**
  * The Aim Assist Target Manager Component is used to gather all aim assist targets that are within
- * a given player's view. Targets must implement the IAimAssistTargetInterface and be on the
- * collision channel that is set in the ShooterCoreRuntimeSettings. 
+ * a given player's view. Targets must implement the IAimAssistTargetInterface and register with
+ * the manager, which keeps them in a spatial hash that follows their movement so finding the
+ * targets in view needs no physics query.
  */
 UCLASS(Blueprintable)
 class SHOOTERCORERUNTIME_API UAimAssistTargetManagerComponent : public UGameStateComponent
@@ -23,8 +27,21 @@ class SHOOTERCORERUNTIME_API UAimAssistTargetManagerComponent : public UGameStat
 
 public:
 
+	//~UActorComponent interface
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	//~End of UActorComponent interface
+
+	/** Returns the target manager of the given world's game state, if the experience added one */
+	static UAimAssistTargetManagerComponent* Get(const UObject* WorldContextObject);
+
+	/** Starts considering the given target for aim assist. Its scene component (or root component for actors) is tracked as it moves */
+	void RegisterTarget(TScriptInterface<IAimAssistTaget> Target);
+
+	void UnregisterTarget(TScriptInterface<IAimAssistTaget> Target);
+
 	/** Gets all visible active targets based on the given local player and their ViewTransform */
-	void GetVisibleTargets(const FAimAssistFilter& Filter, const FAimAssistSettings& Settings, const FAimAssistOwnerViewData& OwnerData, const TArray<FLyraAimAssistTarget>& OldTargets, OUT TArray<FLyraAimAssistTarget>& OutNewTargets);
+	void GetVisibleTargets(const FAimAssistFilter& Filter, const FAimAssistSettings& Settings, const FAimAssistOwnerViewData& OwnerData, const TArray<FLyraAimAssistTarget>& OldTargets, OUT TArray<FLyraAimAssistTarget>& OutNewTargets, FAimAssistTargetQueryBuffer& Buffer);
 
 	/** Get a Player Controller's FOV scaled based on their current input type. */
 	static float GetFOVScale(const APlayerController* PC, ECommonInputType InputType);
@@ -45,4 +62,33 @@ protected:
 	
 	/** Setup CollisionQueryParams to ignore a set of actors based on filter settings. Such as Ignoring Requester or Instigator. */
 	void InitTargetSelectionCollisionParams(FCollisionQueryParams& OutParams, const AActor& RequestedBy, const FAimAssistFilter& Filter) const;
+
+	/** Size of the spatial hash cells on the XY plane, roughly the depth of the targeting box works well */
+	UPROPERTY(EditDefaultsOnly, Category = "Aim Assist")
+	float TargetCellSize = 1000.0f;
+
+private:
+	struct FRegisteredTarget
+	{
+		TWeakObjectPtr<UObject> Target;
+		TWeakObjectPtr<USceneComponent> TrackedComponent;
+		FIntPoint Cell = FIntPoint::ZeroValue;
+		FDelegateHandle TransformUpdatedHandle;
+	};
+
+	FIntPoint GetTargetCell(const FVector& Location) const;
+
+	/** Finds the registered targets that can overlap the given box on the channel, like the overlap query this replaces */
+	void QueryTargetsInBox(const FVector& Center, const FQuat& Rotation, const FVector& HalfExtents, ECollisionChannel Channel, TArray<int32>& OutTargetIndices) const;
+
+	void HandleTargetTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport, int32 TargetIndex);
+
+	void RemoveTarget(int32 TargetIndex);
+
+	TSparseArray<FRegisteredTarget> RegisteredTargets;
+	TMap<TObjectKey<UObject>, int32> RegisteredTargetIndices;
+	TMap<FIntPoint, TArray<int32>> TargetCells;
+
+	/** Largest bounds radius of any registered target, used to pad the queried cells */
+	float MaxTargetRadius = 0.0f;
 };
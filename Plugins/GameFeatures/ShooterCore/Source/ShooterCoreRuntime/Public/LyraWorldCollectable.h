@@ -20,7 +20,13 @@ public:
 
 	ALyraWorldCollectable();
 
+	//~AActor interface
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	//~End of AActor interface
+
 	virtual void GatherInteractionOptions(const FInteractionQuery& InteractQuery, FInteractionOptionBuilder& InteractionBuilder) override;
+	virtual bool CanCacheInteractionOptions() const override { return true; }
 	virtual FInventoryPickup GetPickupInventory() const override;
 
 protected:
@@ -2,6 +2,7 @@
 
 #include "GameFramework/GameplayMessageSubsystem.h"
 #include "Engine/Engine.h"
+#include "Async/ParallelFor.h"
 
 DEFINE_LOG_CATEGORY(LogGameplayMessageSubsystem);
 
@@ -49,9 +50,28 @@ bool UGameplayMessageSubsystem::HasInstance(const UObject* WorldContextObject)
 	return Router != nullptr;
 }
 
+void UGameplayMessageSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &ThisClass::HandleWorldPostActorTick);
+}
+
 void UGameplayMessageSubsystem::Deinitialize()
 {
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+
+	// Nobody is left to receive the queued messages
+	for (const FQueuedMessage& Message : QueuedMessages)
+	{
+		Message.StructType->DestroyStruct(Message.MessageBytes);
+	}
+	QueuedMessages.Reset();
+	MessageArenas[0].Flush();
+	MessageArenas[1].Flush();
+
 	ListenerMap.Reset();
+	DispatchCache.Reset();
 
 	Super::Deinitialize();
 }
@@ -61,58 +81,174 @@ void UGameplayMessageSubsystem::BroadcastMessageInternal(FGameplayTag Channel, c
 	// Log the message if enabled
 	if (UE::GameplayMessageSubsystem::ShouldLogMessages != 0)
 	{
-		FString* pContextString = nullptr;
+		LogMessage(Channel, StructType, MessageBytes);
+	}
+
+	DispatchMessage(Channel, StructType, MessageBytes);
+}
+
+void UGameplayMessageSubsystem::QueueMessageInternal(FGameplayTag Channel, const UScriptStruct* StructType, const void* MessageBytes)
+{
+	check(IsInGameThread());
+
+	// Log the message if enabled
+	if (UE::GameplayMessageSubsystem::ShouldLogMessages != 0)
+	{
+		LogMessage(Channel, StructType, MessageBytes);
+	}
+
+	FMemStackBase& Arena = MessageArenas[CurrentArena];
+	void* Copy = Arena.Alloc(FMath::Max(StructType->GetStructureSize(), 1), StructType->GetMinAlignment());
+	StructType->InitializeStruct(Copy);
+	StructType->CopyScriptStruct(Copy, MessageBytes);
+
+	QueuedMessages.Add({ Channel, StructType, Copy });
+}
+
+void UGameplayMessageSubsystem::FlushQueuedMessages()
+{
+	check(IsInGameThread());
+
+	if (bFlushingMessages || QueuedMessages.Num() == 0)
+	{
+		return;
+	}
+
+	TGuardValue<bool> FlushGuard(bFlushingMessages, true);
+
+	// Anything queued by the listeners goes to the other arena and waits for the next flush
+	TArray<FQueuedMessage> Messages = MoveTemp(QueuedMessages);
+	FMemStackBase& Arena = MessageArenas[CurrentArena];
+	CurrentArena ^= 1;
+
+	ThreadSafeDeliveries.Reset();
+	for (const FQueuedMessage& Message : Messages)
+	{
+		DispatchMessage(Message.Channel, Message.StructType, Message.MessageBytes, &Message);
+	}
+
+	// The messages have to outlive the parallel deliveries, so this waits for all of them
+	ParallelFor(ThreadSafeDeliveries.Num(), [this](int32 Index)
+	{
+		const FThreadSafeDelivery& Delivery = ThreadSafeDeliveries[Index];
+		Delivery.Listener->ReceivedCallback(Delivery.Message->Channel, Delivery.Message->StructType, Delivery.Message->MessageBytes);
+	});
+	ThreadSafeDeliveries.Reset();
+
+	for (const FQueuedMessage& Message : Messages)
+	{
+		Message.StructType->DestroyStruct(Message.MessageBytes);
+	}
+	Arena.Flush();
+
+	// Give the array back so the next frame doesn't have to grow it again
+	if (QueuedMessages.Num() == 0)
+	{
+		Messages.Reset();
+		QueuedMessages = MoveTemp(Messages);
+	}
+}
+
+void UGameplayMessageSubsystem::HandleWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (World && World->GetGameInstance() == GetGameInstance())
+	{
+		FlushQueuedMessages();
+	}
+}
+
+void UGameplayMessageSubsystem::LogMessage(FGameplayTag Channel, const UScriptStruct* StructType, const void* MessageBytes) const
+{
+	FString* pContextString = nullptr;
 #if WITH_EDITOR
-		if (GIsEditor)
+	if (GIsEditor)
+	{
+		extern ENGINE_API FString GPlayInEditorContextString;
+		pContextString = &GPlayInEditorContextString;
+	}
+#endif
+
+	FString HumanReadableMessage;
+	StructType->ExportText(/*out*/ HumanReadableMessage, MessageBytes, /*Defaults=*/ nullptr, /*OwnerObject=*/ nullptr, PPF_None, /*ExportRootScope=*/ nullptr);
+	UE_LOG(LogGameplayMessageSubsystem, Log, TEXT("BroadcastMessage(%s, %s, %s)"), pContextString ? **pContextString : *GetPathNameSafe(this), *Channel.ToString(), *HumanReadableMessage);
+}
+
+void UGameplayMessageSubsystem::DispatchMessage(FGameplayTag Channel, const UScriptStruct* StructType, const void* MessageBytes, const FQueuedMessage* QueuedMessage)
+{
+	// Broadcast the message, holding on to the list in case there are registrations or removals while handling callbacks
+	const TSharedRef<const FDispatchList> DispatchList = FindOrBuildDispatchList(Channel, StructType);
+	for (const FDispatchEntry& Entry : *DispatchList)
+	{
+		const FGameplayMessageListenerData& Listener = *Entry.Listener;
+		if (Listener.bHadValidType && !Listener.ListenerStructType.IsValid())
 		{
-			extern ENGINE_API FString GPlayInEditorContextString;
-			pContextString = &GPlayInEditorContextString;
+			UE_LOG(LogGameplayMessageSubsystem, Warning, TEXT("Listener struct type has gone invalid on Channel %s. Removing listener from list"), *Channel.ToString());
+			UnregisterListenerInternal(Entry.ListenerChannel, Listener.HandleID);
+			continue;
 		}
-#endif
 
-		FString HumanReadableMessage;
-		StructType->ExportText(/*out*/ HumanReadableMessage, MessageBytes, /*Defaults=*/ nullptr, /*OwnerObject=*/ nullptr, PPF_None, /*ExportRootScope=*/ nullptr);
-		UE_LOG(LogGameplayMessageSubsystem, Log, TEXT("BroadcastMessage(%s, %s, %s)"), pContextString ? **pContextString : *GetPathNameSafe(this), *Channel.ToString(), *HumanReadableMessage);
+		if (Entry.bTypeMatches)
+		{
+			if (QueuedMessage && Listener.bThreadSafe)
+			{
+				ThreadSafeDeliveries.Add({ QueuedMessage, Entry.Listener });
+			}
+			else
+			{
+				Listener.ReceivedCallback(Channel, StructType, MessageBytes);
+			}
+		}
+		else
+		{
+			UE_LOG(LogGameplayMessageSubsystem, Error, TEXT("Struct type mismatch on channel %s (broadcast type %s, listener at %s was expecting type %s)"),
+				*Channel.ToString(),
+				*StructType->GetPathName(),
+				*Entry.ListenerChannel.ToString(),
+				*Listener.ListenerStructType->GetPathName());
+		}
+	}
+}
+
+TSharedRef<const UGameplayMessageSubsystem::FDispatchList> UGameplayMessageSubsystem::FindOrBuildDispatchList(FGameplayTag Channel, const UScriptStruct* StructType)
+{
+	const TPair<FGameplayTag, const UScriptStruct*> Key(Channel, StructType);
+	if (const TSharedRef<const FDispatchList>* Cached = DispatchCache.Find(Key))
+	{
+		return *Cached;
 	}
 
-	// Broadcast the message
+	TSharedRef<FDispatchList> DispatchList = MakeShared<FDispatchList>();
 	bool bOnInitialTag = true;
 	for (FGameplayTag Tag = Channel; Tag.IsValid(); Tag = Tag.RequestDirectParent())
 	{
 		if (const FChannelListenerList* pList = ListenerMap.Find(Tag))
 		{
-			// Copy in case there are removals while handling callbacks
-			TArray<FGameplayMessageListenerData> ListenerArray(pList->Listeners);
-
-			for (const FGameplayMessageListenerData& Listener : ListenerArray)
+			for (const TSharedRef<FGameplayMessageListenerData>& Listener : pList->Listeners)
 			{
-				if (bOnInitialTag || (Listener.MatchType == EGameplayMessageMatch::PartialMatch))
+				if (bOnInitialTag || (Listener->MatchType == EGameplayMessageMatch::PartialMatch))
 				{
-					if (Listener.bHadValidType && !Listener.ListenerStructType.IsValid())
-					{
-						UE_LOG(LogGameplayMessageSubsystem, Warning, TEXT("Listener struct type has gone invalid on Channel %s. Removing listener from list"), *Channel.ToString());
-						UnregisterListenerInternal(Channel, Listener.HandleID);
-						continue;
-					}
-
 					// The receiving type must be either a parent of the sending type or completely ambiguous (for internal use)
-					if (!Listener.bHadValidType || StructType->IsChildOf(Listener.ListenerStructType.Get()))
-					{
-						Listener.ReceivedCallback(Channel, StructType, MessageBytes);
-					}
-					else
-					{
-						UE_LOG(LogGameplayMessageSubsystem, Error, TEXT("Struct type mismatch on channel %s (broadcast type %s, listener at %s was expecting type %s)"),
-							*Channel.ToString(),
-							*StructType->GetPathName(),
-							*Tag.ToString(),
-							*Listener.ListenerStructType->GetPathName());
-					}
+					const bool bTypeMatches = !Listener->bHadValidType || StructType->IsChildOf(Listener->ListenerStructType.Get());
+					DispatchList->Add({ Listener, Tag, bTypeMatches });
 				}
 			}
 		}
 		bOnInitialTag = false;
 	}
+
+	DispatchCache.Add(Key, DispatchList);
+	return DispatchList;
+}
+
+void UGameplayMessageSubsystem::InvalidateDispatchLists(FGameplayTag Channel)
+{
+	for (auto It = DispatchCache.CreateIterator(); It; ++It)
+	{
+		if (It.Key().Key.MatchesTag(Channel))
+		{
+			It.RemoveCurrent();
+		}
+	}
 }
 
 void UGameplayMessageSubsystem::K2_BroadcastMessage(FGameplayTag Channel, const int32& Message)
@@ -138,16 +274,19 @@ DEFINE_FUNCTION(UGameplayMessageSubsystem::execK2_BroadcastMessage)
 	}
 }
 
-FGameplayMessageListenerHandle UGameplayMessageSubsystem::RegisterListenerInternal(FGameplayTag Channel, TFunction<void(FGameplayTag, const UScriptStruct*, const void*)>&& Callback, const UScriptStruct* StructType, EGameplayMessageMatch MatchType)
+FGameplayMessageListenerHandle UGameplayMessageSubsystem::RegisterListenerInternal(FGameplayTag Channel, TFunction<void(FGameplayTag, const UScriptStruct*, const void*)>&& Callback, const UScriptStruct* StructType, EGameplayMessageMatch MatchType, bool bThreadSafe)
 {
 	FChannelListenerList& List = ListenerMap.FindOrAdd(Channel);
 
-	FGameplayMessageListenerData& Entry = List.Listeners.AddDefaulted_GetRef();
+	FGameplayMessageListenerData& Entry = *List.Listeners.Add_GetRef(MakeShared<FGameplayMessageListenerData>());
 	Entry.ReceivedCallback = MoveTemp(Callback);
 	Entry.ListenerStructType = StructType;
 	Entry.bHadValidType = StructType != nullptr;
 	Entry.HandleID = ++List.HandleID;
 	Entry.MatchType = MatchType;
+	Entry.bThreadSafe = bThreadSafe;
+
+	InvalidateDispatchLists(Channel);
 
 	return FGameplayMessageListenerHandle(this, Channel, Entry.HandleID);
 }
@@ -170,10 +309,11 @@ void UGameplayMessageSubsystem::UnregisterListenerInternal(FGameplayTag Channel,
 {
 	if (FChannelListenerList* pList = ListenerMap.Find(Channel))
 	{
-		int32 MatchIndex = pList->Listeners.IndexOfByPredicate([ID = HandleID](const FGameplayMessageListenerData& Other) { return Other.HandleID == ID; });
+		int32 MatchIndex = pList->Listeners.IndexOfByPredicate([ID = HandleID](const TSharedRef<FGameplayMessageListenerData>& Other) { return Other->HandleID == ID; });
 		if (MatchIndex != INDEX_NONE)
 		{
 			pList->Listeners.RemoveAtSwap(MatchIndex);
+			InvalidateDispatchLists(Channel);
 		}
 
 		if (pList->Listeners.Num() == 0)
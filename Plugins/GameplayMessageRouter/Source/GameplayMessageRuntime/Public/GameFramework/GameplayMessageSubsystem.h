@@ -8,6 +8,7 @@
 #include "GameFramework/GameplayMessageTypes2.h"
 #include "GameplayTagContainer.h"
 #include "Logging/LogMacros.h"
+#include "Misc/MemStack.h"
 
 #include "GameplayMessageSubsystem.generated.h"
 
@@ -62,6 +63,9 @@ struct FGameplayMessageListenerData
 	int32 HandleID;
 	EGameplayMessageMatch MatchType;
 
+	// Whether queued messages can be delivered to this listener from worker threads
+	bool bThreadSafe = false;
+
 	// Adding some logging and extra variables around some potential problems with this
 	TWeakObjectPtr<const UScriptStruct> ListenerStructType = nullptr;
 	bool bHadValidType = false;
@@ -101,6 +105,7 @@ public:
 	static bool HasInstance(const UObject* WorldContextObject);
 
 	//~USubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
 	virtual void Deinitialize() override;
 	//~End of USubsystem interface
 
@@ -117,6 +122,26 @@ public:
 		BroadcastMessageInternal(Channel, StructType, &Message);
 	}
 
+	/**
+	 * Queue a message to be broadcast on the specified channel once the actors of the world have ticked
+	 * The message is copied, so a burst of messages raised from deep inside gameplay code costs a single flush.
+	 * Listeners registered as thread safe receive queued messages in parallel on worker threads.
+	 *
+	 * @param Channel			The message channel to broadcast on
+	 * @param Message			The message to send (must be the same type of UScriptStruct expected by the listeners for this channel, otherwise an error will be logged)
+	 */
+	template <typename FMessageStructType>
+	void QueueMessage(FGameplayTag Channel, const FMessageStructType& Message)
+	{
+		const UScriptStruct* StructType = TBaseStructure<FMessageStructType>::Get();
+		QueueMessageInternal(Channel, StructType, &Message);
+	}
+
+	/**
+	 * Broadcast the messages queued so far. Messages queued by listeners while flushing wait for the next flush.
+	 */
+	void FlushQueuedMessages();
+
 	/**
 	 * Register to receive messages on a specified channel
 	 *
@@ -184,7 +209,7 @@ public:
 			};
 
 			const UScriptStruct* StructType = TBaseStructure<FMessageStructType>::Get();
-			Handle = RegisterListenerInternal(Channel, ThunkCallback, StructType, Params.MatchType);
+			Handle = RegisterListenerInternal(Channel, ThunkCallback, StructType, Params.MatchType, Params.bThreadSafe);
 		}
 
 		return Handle;
@@ -213,12 +238,16 @@ private:
 	// Internal helper for broadcasting a message
 	void BroadcastMessageInternal(FGameplayTag Channel, const UScriptStruct* StructType, const void* MessageBytes);
 
+	// Internal helper for queueing a message
+	void QueueMessageInternal(FGameplayTag Channel, const UScriptStruct* StructType, const void* MessageBytes);
+
 	// Internal helper for registering a message listener
 	FGameplayMessageListenerHandle RegisterListenerInternal(
 		FGameplayTag Channel, 
 		TFunction<void(FGameplayTag, const UScriptStruct*, const void*)>&& Callback,
 		const UScriptStruct* StructType,
-		EGameplayMessageMatch MatchType);
+		EGameplayMessageMatch MatchType,
+		bool bThreadSafe = false);
 
 	void UnregisterListenerInternal(FGameplayTag Channel, int32 HandleID);
 
@@ -226,10 +255,64 @@ private:
 	// List of all entries for a given channel
 	struct FChannelListenerList
 	{
-		TArray<FGameplayMessageListenerData> Listeners;
+		TArray<TSharedRef<FGameplayMessageListenerData>> Listeners;
 		int32 HandleID = 0;
 	};
 
+	// A listener that will receive the messages broadcast on a concrete channel with a concrete struct type
+	struct FDispatchEntry
+	{
+		TSharedRef<FGameplayMessageListenerData> Listener;
+		FGameplayTag ListenerChannel;
+		bool bTypeMatches;
+	};
+
+	// Flattened listeners for a concrete channel and struct type, exact matches first and then partial matches up the tag hierarchy.
+	// A list is never modified once built, so broadcasts can hold on to it while callbacks register or unregister listeners
+	using FDispatchList = TArray<FDispatchEntry>;
+
+	TSharedRef<const FDispatchList> FindOrBuildDispatchList(FGameplayTag Channel, const UScriptStruct* StructType);
+
+	// Drops the dispatch lists of the channel and its children
+	void InvalidateDispatchLists(FGameplayTag Channel);
+
+	// A queued message, copied into the arena it was queued in
+	struct FQueuedMessage
+	{
+		FGameplayTag Channel;
+		const UScriptStruct* StructType;
+		void* MessageBytes;
+	};
+
+	// A queued message to deliver to a thread safe listener
+	struct FThreadSafeDelivery
+	{
+		const FQueuedMessage* Message;
+		TSharedRef<FGameplayMessageListenerData> Listener;
+	};
+
+	// Calls the listeners of a message, a queued message is added to ThreadSafeDeliveries for the thread safe ones instead
+	void DispatchMessage(FGameplayTag Channel, const UScriptStruct* StructType, const void* MessageBytes, const FQueuedMessage* QueuedMessage = nullptr);
+
+	void LogMessage(FGameplayTag Channel, const UScriptStruct* StructType, const void* MessageBytes) const;
+
+	void HandleWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+
 private:
 	TMap<FGameplayTag, FChannelListenerList> ListenerMap;
+
+	TMap<TPair<FGameplayTag, const UScriptStruct*>, TSharedRef<const FDispatchList>> DispatchCache;
+
+	// Messages queued since the last flush, copied into the current arena. Flushing switches arenas,
+	// so messages queued by listeners during a flush don't share memory with the ones being delivered.
+	// The arenas are freed as a whole by Flush rather than by marks, so they allow allocating without one
+	TArray<FQueuedMessage> QueuedMessages;
+	FMemStackBase MessageArenas[2] = { FMemStackBase(/*InMinMarksToAlloc=*/ 0), FMemStackBase(/*InMinMarksToAlloc=*/ 0) };
+	int32 CurrentArena = 0;
+	bool bFlushingMessages = false;
+
+	// Scratch list reused by every flush
+	TArray<FThreadSafeDelivery> ThreadSafeDeliveries;
+
+	FDelegateHandle PostActorTickHandle;
 };
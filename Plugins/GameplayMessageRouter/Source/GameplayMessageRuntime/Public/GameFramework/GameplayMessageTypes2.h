@@ -34,6 +34,12 @@ struct FGameplayMessageListenerParams
 	/** If bound this callback will trigger when a message is broadcast on the specified channel. */
 	TFunction<void(FGameplayTag, const FMessageStructType&)> OnMessageReceivedCallback;
 
+	/**
+	 * Whether Callback can be called from worker threads. Queued messages are delivered to thread safe listeners in parallel,
+	 * so the callback must not touch UObjects or any other state shared with the game thread without synchronization.
+	 */
+	bool bThreadSafe = false;
+
 	/** Helper to bind weak member function to OnMessageReceivedCallback */
 	template<typename TOwner = UObject>
 	void SetMessageReceivedCallback(TOwner* Object, void(TOwner::* Function)(FGameplayTag, const FMessageStructType&))
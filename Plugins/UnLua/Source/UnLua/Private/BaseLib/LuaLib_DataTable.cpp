@@ -14,10 +14,89 @@
 
 #include "UnLuaEx.h"
 #include "LuaCore.h"
+#include "ReflectionUtils/PropertyDesc.h"
 #include "Kismet/DataTableFunctionLibrary.h"
 
 namespace UnLua
 {
+    /**
+     * Row metatable, columns and secondary indexes of a data table, built on first use and dropped when the table changes.
+     */
+    struct FDataTableView
+    {
+        const UScriptStruct* RowStruct = nullptr;
+        TArray<ANSICHAR> MetatableName;
+        TMap<FName, TSharedPtr<FPropertyDesc>> Columns;     // authored column name -> property
+        TMap<FName, TMultiMap<uint32, FName>> Indexes;      // column name -> value hash -> row names
+        FDelegateHandle OnChangedHandle;
+    };
+
+    static TMap<TWeakObjectPtr<UDataTable>, FDataTableView> DataTableViews;
+
+    static void OnDataTableChanged(TWeakObjectPtr<UDataTable> Table)
+    {
+        FDataTableView View;
+        if (DataTableViews.RemoveAndCopyValue(Table, View) && Table.IsValid())
+            Table->OnDataTableChanged().Remove(View.OnChangedHandle);
+    }
+
+    static FDataTableView* GetDataTableView(UDataTable* Table)
+    {
+        const UScriptStruct* RowStruct = Table->GetRowStruct();
+        if (!RowStruct)
+            return nullptr;
+
+        const TWeakObjectPtr<UDataTable> Key(Table);
+        if (FDataTableView* View = DataTableViews.Find(Key))
+            return View;
+
+        // drop the views of unloaded tables before adding a new one
+        for (auto It = DataTableViews.CreateIterator(); It; ++It)
+        {
+            if (!It.Key().IsValid())
+                It.RemoveCurrent();
+        }
+
+        FDataTableView& View = DataTableViews.Add(Key);
+        View.RowStruct = RowStruct;
+        const FTCHARToUTF8 MetatableName(*(TEXT("F") + RowStruct->GetName()));
+        View.MetatableName.Append(MetatableName.Get(), MetatableName.Length() + 1);
+        for (TFieldIterator<FProperty> It(RowStruct); It; ++It)
+        {
+            View.Columns.Add(FName(*It->GetAuthoredName()), TSharedPtr<FPropertyDesc>(FPropertyDesc::Create(*It)));
+        }
+        View.OnChangedHandle = Table->OnDataTableChanged().AddStatic(&OnDataTableChanged, Key);
+        return &View;
+    }
+
+    static const FPropertyDesc* GetColumn(lua_State* L, const FDataTableView& View, FName ColumnName)
+    {
+        const TSharedPtr<FPropertyDesc>* Column = View.Columns.Find(ColumnName);
+        if (!Column)
+        {
+            luaL_error(L, "invalid column %s", TCHAR_TO_UTF8(*ColumnName.ToString()));
+            return nullptr;
+        }
+        return Column->Get();
+    }
+
+    static const TMultiMap<uint32, FName>& GetIndex(lua_State* L, UDataTable* Table, FDataTableView& View, FName ColumnName, const FPropertyDesc* Column)
+    {
+        if (const TMultiMap<uint32, FName>* Index = View.Indexes.Find(ColumnName))
+            return *Index;
+
+        const FProperty* Property = Column->GetUProperty();
+        if (!(Property->PropertyFlags & CPF_HasGetValueTypeHash))
+            luaL_error(L, "column %s can't be indexed", TCHAR_TO_UTF8(*ColumnName.ToString()));
+
+        TMultiMap<uint32, FName>& Index = View.Indexes.Add(ColumnName);
+        for (const auto& Row : Table->GetRowMap())
+        {
+            Index.Add(Property->GetValueTypeHash(Property->ContainerPtrToValuePtr<void>(Row.Value)), Row.Key);
+        }
+        return Index;
+    }
+
     /**
      * Get row data with structure.
      */
@@ -36,39 +115,171 @@ namespace UnLua
 
         FName RowName = UnLua::Get(L, 2, TType<FName>());
         void* RowPtr = Table->FindRowUnchecked(RowName);
+        const FDataTableView* View = RowPtr ? GetDataTableView(Table) : nullptr;
 
-        if (RowPtr == nullptr)
+        if (View == nullptr)
         {
             lua_pushnil(L);
         }
         else
         {
-            const UScriptStruct* StructType = Table->GetRowStruct();
-
-            if (StructType != nullptr)
+            const UScriptStruct* StructType = View->RowStruct;
+            uint8 StructPadding = StructType->GetMinAlignment();
+            uint8 Padding = StructPadding < 8 ? 8 : StructPadding;
+            void* Userdata = NewUserdataWithPadding(L, StructType->GetStructureSize(), View->MetatableName.GetData(), Padding);
+            if (Userdata != nullptr)
             {
-                FString Name = FString("F" + StructType->GetName());
-                uint8 StructPadding = StructType->GetMinAlignment();
-                uint8 Padding = StructPadding < 8 ? 8 : StructPadding;
-                void* Userdata = NewUserdataWithPadding(L, StructType->GetStructureSize(), TCHAR_TO_UTF8(*Name), Padding);
-                if (Userdata != nullptr)
+                if (StructType->StructFlags & STRUCT_CopyNative)
                 {
-                    if (StructType->StructFlags & STRUCT_CopyNative)
-                    {
-                        //Do ScriptStruct Construct
-                        UScriptStruct::ICppStructOps* TheCppStructOps = StructType->GetCppStructOps();
-                        TheCppStructOps->Construct(Userdata);
-                    }
-                    StructType->CopyScriptStruct(Userdata, RowPtr);
+                    //Do ScriptStruct Construct
+                    UScriptStruct::ICppStructOps* TheCppStructOps = StructType->GetCppStructOps();
+                    TheCppStructOps->Construct(Userdata);
                 }
+                StructType->CopyScriptStruct(Userdata, RowPtr);
             }
         }
         return 1;
     }
 
+    /**
+     * Get a copy of the value of a single column of a row, without copying the rest of the row.
+     * UE.UDataTableFunctionLibrary.GetCellValue(Table, RowName, ColumnName)
+     */
+    static int32 UDataTable_GetCellValue(lua_State* L)
+    {
+        int32 NumParams = lua_gettop(L);
+        if (NumParams != 3)
+            return luaL_error(L, "invalid parameters");
+
+        UDataTable* Table = Cast<UDataTable>(UnLua::GetUObject(L, 1));
+        if (!Table)
+            return luaL_error(L, "invalid UDataTable");
+
+        FDataTableView* View = GetDataTableView(Table);
+        if (!View)
+            return luaL_error(L, "invalid row struct");
+
+        const FPropertyDesc* Column = GetColumn(L, *View, UnLua::Get(L, 3, TType<FName>()));
+        const void* RowPtr = Table->FindRowUnchecked(UnLua::Get(L, 2, TType<FName>()));
+        if (!RowPtr)
+        {
+            lua_pushnil(L);
+            return 1;
+        }
+        // values are copied, lua must never hold pointers into row memory that a reimport frees
+        Column->GetValue(L, RowPtr, true);
+        return 1;
+    }
+
+    /**
+     * Get copies of the values of a column of all rows, and the row names in the same order.
+     * local Values, RowNames = UE.UDataTableFunctionLibrary.GetColumnValues(Table, ColumnName)
+     */
+    static int32 UDataTable_GetColumnValues(lua_State* L)
+    {
+        int32 NumParams = lua_gettop(L);
+        if (NumParams != 2)
+            return luaL_error(L, "invalid parameters");
+
+        UDataTable* Table = Cast<UDataTable>(UnLua::GetUObject(L, 1));
+        if (!Table)
+            return luaL_error(L, "invalid UDataTable");
+
+        FDataTableView* View = GetDataTableView(Table);
+        if (!View)
+            return luaL_error(L, "invalid row struct");
+
+        const FPropertyDesc* Column = GetColumn(L, *View, UnLua::Get(L, 2, TType<FName>()));
+        const TMap<FName, uint8*>& RowMap = Table->GetRowMap();
+        lua_createtable(L, RowMap.Num(), 0);
+        lua_createtable(L, RowMap.Num(), 0);
+        int32 RowIndex = 0;
+        for (const auto& Row : RowMap)
+        {
+            ++RowIndex;
+            Column->GetValue(L, Row.Value, true);
+            lua_rawseti(L, -3, RowIndex);
+            UnLua::Push(L, FName(Row.Key));
+            lua_rawseti(L, -2, RowIndex);
+        }
+        return 2;
+    }
+
+    struct FFindRowNamesArgs
+    {
+        UDataTable* Table;
+        const FPropertyDesc* Column;
+        const TMultiMap<uint32, FName>* Index;
+        void* Value;
+    };
+
+    /**
+     * The part of FindRowNames that can raise lua errors, called protected so the caller always destroys the value.
+     */
+    static int32 UDataTable_FindRowNamesProtected(lua_State* L)
+    {
+        const FFindRowNamesArgs& Args = *(const FFindRowNamesArgs*)lua_touserdata(L, 1);
+        const FProperty* Property = Args.Column->GetUProperty();
+        Args.Column->SetValueInternal(L, Args.Value, 2, true);
+
+        lua_createtable(L, 0, 0);
+        int32 NumFound = 0;
+        for (auto It = Args.Index->CreateConstKeyIterator(Property->GetValueTypeHash(Args.Value)); It; ++It)
+        {
+            const uint8* RowPtr = Args.Table->FindRowUnchecked(It.Value());
+            if (RowPtr && Property->Identical(Property->ContainerPtrToValuePtr<void>(RowPtr), Args.Value))
+            {
+                UnLua::Push(L, It.Value());
+                lua_rawseti(L, -2, ++NumFound);
+            }
+        }
+        return 1;
+    }
+
+    /**
+     * Find the names of the rows whose column equals the value. the column is indexed on first use.
+     * UE.UDataTableFunctionLibrary.FindRowNames(Table, ColumnName, Value)
+     */
+    static int32 UDataTable_FindRowNames(lua_State* L)
+    {
+        int32 NumParams = lua_gettop(L);
+        if (NumParams != 3)
+            return luaL_error(L, "invalid parameters");
+
+        UDataTable* Table = Cast<UDataTable>(UnLua::GetUObject(L, 1));
+        if (!Table)
+            return luaL_error(L, "invalid UDataTable");
+
+        FDataTableView* View = GetDataTableView(Table);
+        if (!View)
+            return luaL_error(L, "invalid row struct");
+
+        const FName ColumnName = UnLua::Get(L, 2, TType<FName>());
+        const FPropertyDesc* Column = GetColumn(L, *View, ColumnName);
+        const TMultiMap<uint32, FName>& Index = GetIndex(L, Table, *View, ColumnName, Column);
+
+        const FProperty* Property = Column->GetUProperty();
+        void* Value = FMemory_Alloca_Aligned(Property->GetSize(), Property->GetMinAlignment());
+        Property->InitializeValue(Value);
+
+        // converting the value raises on a type mismatch, which would otherwise skip destroying it
+        FFindRowNamesArgs Args{Table, Column, &Index, Value};
+        lua_pushcfunction(L, UDataTable_FindRowNamesProtected);
+        lua_pushlightuserdata(L, &Args);
+        lua_pushvalue(L, 3);
+        const int32 Status = lua_pcall(L, 2, 1, 0);
+        Property->DestroyValue(Value);
+        if (Status != LUA_OK)
+            return lua_error(L);
+        return 1;
+    }
+
     static const luaL_Reg UDataTableLib[] =
     {
         {"GetRowDataStructure", UDataTable_GetRowDataStructure},
+        {"GetCellValue", UDataTable_GetCellValue},
+        {"GetColumnValues", UDataTable_GetColumnValues},
+        {"FindRowNames", UDataTable_FindRowNames},
         {nullptr, nullptr}
     };
 
@@ -15,6 +15,7 @@
 #include "UnLuaEx.h"
 #include "LuaCore.h"
 #include "LuaDynamicBinding.h"
+#include "LuaEnv.h"
 #include "Engine/World.h"
 
 /**
@@ -161,6 +162,139 @@ static int32 UWorld_SpawnActorEx(lua_State* L)
     return 1;
 }
 
+/**
+ * Acquire an actor from the actor pool, or spawn one if the pool of its class is empty.
+ * for example:
+ * World:AcquireActor(
+ *  ProjectileClass, InitialTransform, ESpawnActorCollisionHandlingMethod.AlwaysSpawn,
+ *  OwnerActor, Instigator, "Weapon.Projectile_C", Initializer, ULevel, Name
+ * )
+ * the parameters are the same as SpawnActor. a pooled actor keeps the lua instance it was spawned with,
+ * and 'OnAcquired(self, Initializer)' is called on it instead of 'Initialize'.
+ */
+static int32 UWorld_AcquireActor(lua_State* L)
+{
+    int32 NumParams = lua_gettop(L);
+    if (NumParams < 2)
+        return luaL_error(L, "invalid parameters");
+
+    UWorld* World = Cast<UWorld>(UnLua::GetUObject(L, 1));
+    if (!World)
+        return luaL_error(L, "invalid world");
+
+    UClass* Class = Cast<UClass>(UnLua::GetUObject(L, 2));
+    if (!Class)
+        return luaL_error(L, "invalid actor class");
+
+    FTransform Transform;
+    if (NumParams > 2)
+    {
+        FTransform* TransformPtr = (FTransform*)GetCppInstanceFast(L, 3);
+        if (TransformPtr)
+        {
+            Transform = *TransformPtr;
+        }
+    }
+
+    AActor* Owner = NumParams > 4 ? Cast<AActor>(UnLua::GetUObject(L, 5)) : nullptr;
+    APawn* Instigator = nullptr;
+    if (NumParams > 5)
+    {
+        AActor* Actor = Cast<AActor>(UnLua::GetUObject(L, 6));
+        if (Actor)
+        {
+            Instigator = Cast<APawn>(Actor);
+            if (!Instigator)
+            {
+                Instigator = Actor->GetInstigator();
+            }
+        }
+    }
+
+    int32 TableRef = LUA_NOREF;
+    if (NumParams > 7 && lua_type(L, 8) == LUA_TTABLE)
+    {
+        lua_pushvalue(L, 8);
+        TableRef = luaL_ref(L, LUA_REGISTRYINDEX);
+    }
+    const auto ActorPool = UnLua::FLuaEnv::FindEnvChecked(L).GetActorPool();
+    AActor* Actor = ActorPool->Acquire(World, Class, Transform, Owner, Instigator, TableRef);
+    luaL_unref(L, LUA_REGISTRYINDEX, TableRef);
+    if (!Actor)
+        return UWorld_SpawnActor(L);
+
+    UnLua::PushUObject(L, Actor);
+    return 1;
+}
+
+/**
+ * Return an actor to the actor pool instead of destroying it.
+ * World:ReleaseActor(Actor)
+ * 'OnReleased(self)' is called on its lua instance before the actor is hidden and stops ticking and colliding.
+ */
+static int32 UWorld_ReleaseActor(lua_State* L)
+{
+    int32 NumParams = lua_gettop(L);
+    if (NumParams < 2)
+        return luaL_error(L, "invalid parameters");
+
+    AActor* Actor = Cast<AActor>(UnLua::GetUObject(L, 2));
+    if (!Actor)
+        return luaL_error(L, "invalid actor");
+
+    const auto ActorPool = UnLua::FLuaEnv::FindEnvChecked(L).GetActorPool();
+    lua_pushboolean(L, ActorPool->Release(Actor));
+    return 1;
+}
+
+/**
+ * Spawn actors into the actor pool ahead of time.
+ * World:PrewarmActors(ProjectileClass, Count, "Weapon.Projectile_C")
+ * returns the number of pooled actors of the class.
+ */
+static int32 UWorld_PrewarmActors(lua_State* L)
+{
+    int32 NumParams = lua_gettop(L);
+    if (NumParams < 3)
+        return luaL_error(L, "invalid parameters");
+
+    UWorld* World = Cast<UWorld>(UnLua::GetUObject(L, 1));
+    if (!World)
+        return luaL_error(L, "invalid world");
+
+    UClass* Class = Cast<UClass>(UnLua::GetUObject(L, 2));
+    if (!Class || !Class->IsChildOf<AActor>())
+        return luaL_error(L, "invalid actor class");
+
+    const int32 Count = (int32)luaL_checkinteger(L, 3);
+    const char* ModuleName = NumParams > 3 ? lua_tostring(L, 4) : nullptr;
+    const auto ActorPool = UnLua::FLuaEnv::FindEnvChecked(L).GetActorPool();
+    lua_pushinteger(L, ActorPool->Prewarm(World, Class, Count, UTF8_TO_TCHAR(ModuleName)));
+    return 1;
+}
+
+/**
+ * World:GetPooledActorNum(ProjectileClass)
+ */
+static int32 UWorld_GetPooledActorNum(lua_State* L)
+{
+    int32 NumParams = lua_gettop(L);
+    if (NumParams < 2)
+        return luaL_error(L, "invalid parameters");
+
+    UWorld* World = Cast<UWorld>(UnLua::GetUObject(L, 1));
+    if (!World)
+        return luaL_error(L, "invalid world");
+
+    UClass* Class = Cast<UClass>(UnLua::GetUObject(L, 2));
+    if (!Class)
+        return luaL_error(L, "invalid actor class");
+
+    const auto ActorPool = UnLua::FLuaEnv::FindEnvChecked(L).GetActorPool();
+    lua_pushinteger(L, ActorPool->Num(World, Class));
+    return 1;
+}
+
 DEFINE_TYPE(ESpawnActorCollisionHandlingMethod)
 
 DEFINE_TYPE(EObjectFlags)
@@ -202,6 +336,10 @@ static const luaL_Reg UWorldLib[] =
 {
     {"SpawnActor", UWorld_SpawnActor},
     {"SpawnActorEx", UWorld_SpawnActorEx},
+    {"AcquireActor", UWorld_AcquireActor},
+    {"ReleaseActor", UWorld_ReleaseActor},
+    {"PrewarmActors", UWorld_PrewarmActors},
+    {"GetPooledActorNum", UWorld_GetPooledActorNum},
     {nullptr, nullptr}
 };
 
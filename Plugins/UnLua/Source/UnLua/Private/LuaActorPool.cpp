@@ -0,0 +1,186 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "LuaActorPool.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "LuaCore.h"
+#include "LuaDynamicBinding.h"
+#include "LuaEnv.h"
+
+namespace UnLua
+{
+    FActorPool::FActorPool(FLuaEnv* Env)
+        : Env(Env)
+    {
+        OnWorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddRaw(this, &FActorPool::OnWorldCleanup);
+    }
+
+    FActorPool::~FActorPool()
+    {
+        FWorldDelegates::OnWorldCleanup.Remove(OnWorldCleanupHandle);
+
+        // pooled actors would otherwise stay hidden in their worlds without a lua instance to reactivate them
+        for (const auto& WorldPair : Worlds)
+        {
+            if (WorldPair.Key->bIsTearingDown)
+                continue;
+
+            for (const auto& ClassPair : WorldPair.Value.Classes)
+            {
+                for (const auto& Pooled : ClassPair.Value)
+                {
+                    if (AActor* Actor = Pooled.Actor.Get())
+                        Actor->Destroy();
+                }
+            }
+        }
+    }
+
+    AActor* FActorPool::Acquire(UWorld* World, UClass* Class, const FTransform& Transform, AActor* Owner, APawn* Instigator, int32 InitializerTableRef)
+    {
+        FWorldPool* WorldPool = Worlds.Find(World);
+        if (!WorldPool)
+            return nullptr;
+
+        TArray<FPooledActor>* PooledActors = WorldPool->Classes.Find(Class);
+        if (!PooledActors)
+            return nullptr;
+
+        while (PooledActors->Num() > 0)
+        {
+            const FPooledActor Pooled = PooledActors->Pop(false);
+            WorldPool->PooledActors.Remove(Pooled.Actor);
+
+            // destroyed by gameplay code while it was pooled
+            AActor* Actor = Pooled.Actor.Get();
+            if (!Actor || Actor->IsActorBeingDestroyed())
+                continue;
+
+            Actor->SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+            Actor->SetOwner(Owner);
+            Actor->SetInstigator(Instigator);
+            Actor->SetActorEnableCollision(Pooled.bCollisionEnabled);
+            Actor->SetActorHiddenInGame(Pooled.bHidden);
+            Actor->SetActorTickEnabled(Pooled.bTickEnabled);
+            for (const auto& Component : Pooled.TickingComponents)
+            {
+                if (Component.IsValid())
+                    Component->SetComponentTickEnabled(true);
+            }
+
+            CallHook(Actor, "OnAcquired", InitializerTableRef);
+            return Actor;
+        }
+        return nullptr;
+    }
+
+    bool FActorPool::Release(AActor* Actor)
+    {
+        if (!IsValid(Actor) || Actor->IsActorBeingDestroyed())
+            return false;
+
+        UWorld* World = Actor->GetWorld();
+        if (!World || World->bIsTearingDown)
+            return false;
+
+        FWorldPool& WorldPool = Worlds.FindOrAdd(World);
+        bool bAlreadyPooled;
+        WorldPool.PooledActors.Add(Actor, &bAlreadyPooled);
+        if (bAlreadyPooled)
+            return false;
+
+        CallHook(Actor, "OnReleased", LUA_NOREF);
+        if (Actor->IsActorBeingDestroyed())
+        {
+            WorldPool.PooledActors.Remove(Actor);
+            return false;
+        }
+
+        FPooledActor Pooled;
+        Pooled.Actor = Actor;
+        Pooled.bHidden = Actor->IsHidden();
+        Pooled.bCollisionEnabled = Actor->GetActorEnableCollision();
+        Pooled.bTickEnabled = Actor->IsActorTickEnabled();
+        for (UActorComponent* Component : Actor->GetComponents())
+        {
+            if (Component && Component->IsComponentTickEnabled())
+            {
+                Component->SetComponentTickEnabled(false);
+                Pooled.TickingComponents.Add(Component);
+            }
+        }
+
+        Actor->DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
+        Actor->SetActorHiddenInGame(true);
+        Actor->SetActorEnableCollision(false);
+        Actor->SetActorTickEnabled(false);
+
+        WorldPool.Classes.FindOrAdd(Actor->GetClass()).Add(MoveTemp(Pooled));
+        return true;
+    }
+
+    int32 FActorPool::Prewarm(UWorld* World, UClass* Class, int32 Count, const TCHAR* ModuleName)
+    {
+        if (!World || !Class || !Class->IsChildOf<AActor>())
+            return 0;
+
+        FActorSpawnParameters SpawnParameters;
+        SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+        lua_State* L = Env->GetMainState();
+        for (int32 Missing = Count - Num(World, Class); Missing > 0; --Missing)
+        {
+            FScopedLuaDynamicBinding Binding(L, Class, ModuleName, LUA_NOREF);
+            AActor* Actor = World->SpawnActor(Class, &FTransform::Identity, SpawnParameters);
+            if (!Release(Actor))
+                break;
+        }
+        return Num(World, Class);
+    }
+
+    int32 FActorPool::Num(UWorld* World, UClass* Class) const
+    {
+        const FWorldPool* WorldPool = Worlds.Find(World);
+        if (!WorldPool)
+            return 0;
+
+        const TArray<FPooledActor>* PooledActors = WorldPool->Classes.Find(Class);
+        return PooledActors ? PooledActors->Num() : 0;
+    }
+
+    void FActorPool::CallHook(AActor* Actor, const char* HookName, int32 InitializerTableRef) const
+    {
+        lua_State* L = Env->GetMainState();
+        const int32 FunctionRef = PushFunction(L, Actor, HookName);
+        if (FunctionRef == LUA_NOREF)
+            return;
+
+        if (InitializerTableRef != LUA_NOREF)
+            lua_rawgeti(L, LUA_REGISTRYINDEX, InitializerTableRef);
+        else
+            lua_pushnil(L);
+
+        if (!CallFunction(L, 2, 0))
+            UE_LOG(LogUnLua, Warning, TEXT("Failed to call '%s' function!"), UTF8_TO_TCHAR(HookName));
+        luaL_unref(L, LUA_REGISTRYINDEX, FunctionRef);
+    }
+
+    void FActorPool::OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+    {
+        // the world destroys its actors, pooled or not
+        Worlds.Remove(World);
+    }
+}
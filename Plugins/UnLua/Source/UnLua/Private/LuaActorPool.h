@@ -0,0 +1,78 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "lua.hpp"
+
+class AActor;
+class APawn;
+class UActorComponent;
+class UWorld;
+
+namespace UnLua
+{
+    class FLuaEnv;
+
+    /**
+     * Recycles actors spawned from lua, so short lived actors like projectiles and tracers skip spawning,
+     * registering their components and binding their lua instance again. A released actor is hidden, stops
+     * ticking and colliding, and keeps its lua instance; the bound module is notified with 'OnReleased(self)'
+     * and 'OnAcquired(self, Initializer)' so that it can reset its state.
+     */
+    class FActorPool
+    {
+    public:
+        explicit FActorPool(FLuaEnv* Env);
+
+        ~FActorPool();
+
+        /** Reactivate a pooled actor of the class at the transform, returns null if the pool is empty */
+        AActor* Acquire(UWorld* World, UClass* Class, const FTransform& Transform, AActor* Owner, APawn* Instigator, int32 InitializerTableRef);
+
+        /** Deactivate the actor and return it to the pool of its class */
+        bool Release(AActor* Actor);
+
+        /** Spawn actors bound to the module until the pool of the class holds at least Count actors */
+        int32 Prewarm(UWorld* World, UClass* Class, int32 Count, const TCHAR* ModuleName);
+
+        int32 Num(UWorld* World, UClass* Class) const;
+
+    private:
+        struct FPooledActor
+        {
+            TWeakObjectPtr<AActor> Actor;
+            bool bHidden;
+            bool bCollisionEnabled;
+            bool bTickEnabled;
+            TArray<TWeakObjectPtr<UActorComponent>> TickingComponents;
+        };
+
+        struct FWorldPool
+        {
+            TMap<UClass*, TArray<FPooledActor>> Classes;
+            TSet<TWeakObjectPtr<AActor>> PooledActors;
+        };
+
+        void CallHook(AActor* Actor, const char* HookName, int32 InitializerTableRef) const;
+
+        void OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+
+        FLuaEnv* Env;
+        TMap<UWorld*, FWorldPool> Worlds;
+        FDelegateHandle OnWorldCleanupHandle;
+    };
+}
@@ -13,6 +13,7 @@
 // See the License for the specific language governing permissions and limitations under the License.
 
 #include "LuaDeadLoopCheck.h"
+#include "LuaMemoryTracker.h"
 #include "HAL/RunnableThread.h"
 #include "UnLuaModule.h"
 
@@ -105,11 +106,18 @@ namespace UnLua
         const auto Hook = lua_gethook(L);
         if (Hook == nullptr)
             lua_sethook(L, OnLuaLineEvent, LUA_MASKLINE, 0);
+        else if (FLuaMemoryTracker::IsTrackerHook(Hook))
+            lua_sethook(L, Hook, lua_gethookmask(L) | LUA_MASKLINE, 0);
     }
 
     void FDeadLoopCheck::FGuard::OnLuaLineEvent(lua_State* L, lua_Debug* ar)
     {
         lua_sethook(L, nullptr, 0, 0);
+        OnTimeout(L);
+    }
+
+    void FDeadLoopCheck::OnTimeout(lua_State* L)
+    {
         luaL_error(L, "lua script exec timeout");
     }
 }
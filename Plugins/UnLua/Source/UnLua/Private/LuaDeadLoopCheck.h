@@ -27,6 +27,9 @@ namespace UnLua
     {
     public:
         static int32 Timeout; // in seconds
+
+        /** Raises the timeout error, from the guard's line hook or from a hook that chains line events to it */
+        static void OnTimeout(lua_State* L);
         
         class FGuard final
         {
@@ -48,15 +48,18 @@ namespace UnLua
 
         RegisterDelegates();
 
+        // the allocator reports to the tracker, so it has to exist before the state does
+        MemoryTracker = new FLuaMemoryTracker(this);
+
 #if PLATFORM_WINDOWS
         // 防止类似AppleProResMedia插件忘了恢复Dll查找目录
         // https://github.com/Tencent/UnLua/issues/534
         const auto Dir = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir() / TEXT("Binaries/Win64"));
         FPlatformProcess::PushDllDirectory(*Dir);
-        L = lua_newstate(GetLuaAllocator(), nullptr);
+        L = lua_newstate(GetLuaAllocator(), this);
         FPlatformProcess::PopDllDirectory(*Dir);
 #else
-        L = lua_newstate(GetLuaAllocator(), nullptr);
+        L = lua_newstate(GetLuaAllocator(), this);
 #endif
 
         AllEnvs.Add(L, this);
@@ -80,6 +83,7 @@ namespace UnLua
         EnumRegistry = new FEnumRegistry(this);
         DanglingCheck = new FDanglingCheck(this);
         DeadLoopCheck = new FDeadLoopCheck(this);
+        ActorPool = new FActorPool(this);
 
         AutoObjectReference.SetName("UnLua_AutoReference");
         ManualObjectReference.SetName("UnLua_ManualReference");
@@ -133,6 +137,10 @@ namespace UnLua
     FLuaEnv::~FLuaEnv()
     {
         OnDestroyed.Broadcast(*this);
+
+        // pooled actors are destroyed while their lua instances can still handle EndPlay
+        delete ActorPool;
+
         lua_close(L);
         AllEnvs.Remove(L);
 
@@ -144,6 +152,7 @@ namespace UnLua
         delete EnumRegistry;
         delete DanglingCheck;
         delete DeadLoopCheck;
+        delete MemoryTracker;
 
         if (!IsEngineExitRequested() && Manager)
         {
@@ -540,6 +549,7 @@ namespace UnLua
             if (!Loader.Execute(Env, FileName, Data, ChunkName))
                 continue;
 
+            Env.MemoryTracker->RegisterChunk(ChunkName, FileName);
             if (Env.LoadString(Data, ChunkName))
                 break;
 
@@ -551,8 +561,8 @@ namespace UnLua
 
     int FLuaEnv::LoadFromFileSystem(lua_State* L)
     {
-        FString FileName(UTF8_TO_TCHAR(lua_tostring(L, 1)));
-        FileName.ReplaceInline(TEXT("."), TEXT("/"));
+        const FString ModuleName(UTF8_TO_TCHAR(lua_tostring(L, 1)));
+        FString FileName = ModuleName.Replace(TEXT("."), TEXT("/"));
 
         auto& Env = *(FLuaEnv*)lua_touserdata(L, lua_upvalueindex(1));
         TArray<uint8> Data;
@@ -560,6 +570,7 @@ namespace UnLua
 
         auto LoadIt = [&]
         {
+            Env.MemoryTracker->RegisterChunk(FullPath, ModuleName);
             if (Env.LoadString(Data, TCHAR_TO_UTF8(*FullPath)))
                 return 1;
             return luaL_error(L, "file loading from file system error");
@@ -690,8 +701,13 @@ namespace UnLua
 
     void* FLuaEnv::DefaultLuaAllocator(void* ud, void* ptr, size_t osize, size_t nsize)
     {
+        const auto Tracker = ud ? ((FLuaEnv*)ud)->MemoryTracker : nullptr;
+        const bool bTracking = Tracker && Tracker->IsTracking();
+
         if (nsize == 0)
         {
+            if (bTracking)
+                Tracker->OnFree(ptr);
             UNLUA_STAT_MEMORY_FREE(ptr, Lua);
             FMemory::Free(ptr);
             return nullptr;
@@ -702,11 +718,15 @@ namespace UnLua
         {
             Buffer = FMemory::Malloc(nsize);
             UNLUA_STAT_MEMORY_ALLOC(Buffer, Lua);
+            if (bTracking)
+                Tracker->OnAlloc(Buffer, nsize);
         }
         else
         {
             UNLUA_STAT_MEMORY_REALLOC(ptr, Buffer, Lua);
             Buffer = FMemory::Realloc(ptr, nsize);
+            if (bTracking && Buffer)
+                Tracker->OnRealloc(ptr, Buffer, nsize);
         }
         return Buffer;
     }
@@ -0,0 +1,216 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+#include "LuaMemoryTracker.h"
+#include "LuaDeadLoopCheck.h"
+#include "LuaEnv.h"
+
+namespace UnLua
+{
+    static const FString NativeTag = TEXT("<native>");
+
+    FLuaMemoryTracker::FScope::FScope(FLuaMemoryTracker* Owner, const FString& Tag)
+        : Owner(Owner)
+    {
+        Owner->ScopeTags.Push(Owner->FindOrAddTag(Tag));
+        Owner->CurrentTag = Owner->ScopeTags.Last();
+    }
+
+    FLuaMemoryTracker::FScope::~FScope()
+    {
+        Owner->ScopeTags.Pop(false);
+        Owner->CurrentTag = Owner->ScopeTags.Num() > 0 ? Owner->ScopeTags.Last() : 0;
+    }
+
+    FLuaMemoryTracker::FLuaMemoryTracker(FLuaEnv* Env)
+        : Env(Env),
+          bTracking(false),
+          CurrentTag(0)
+    {
+        FindOrAddTag(NativeTag);
+    }
+
+    TUniquePtr<FLuaMemoryTracker::FScope> FLuaMemoryTracker::MakeScope(const FString& Tag)
+    {
+        if (!bTracking)
+            return TUniquePtr<FScope>();
+        return MakeUnique<FScope>(this, Tag);
+    }
+
+    void FLuaMemoryTracker::Start()
+    {
+        if (bTracking)
+            return;
+
+        const auto L = Env->GetMainState();
+        if (lua_gethook(L) != nullptr)
+        {
+            UE_LOG(LogUnLua, Warning, TEXT("lua memory tracking replaces the hook already installed on %s, e.g. by a debugger."), *Env->GetName());
+        }
+
+        // coroutines created from now on inherit the hook of the main thread
+        lua_sethook(L, OnLuaHook, LUA_MASKCALL | LUA_MASKRET, 0);
+        CurrentTag = 0;
+        bTracking = true;
+    }
+
+    void FLuaMemoryTracker::Stop()
+    {
+        if (!bTracking)
+            return;
+
+        const auto L = Env->GetMainState();
+        if (lua_gethook(L) == OnLuaHook)
+            lua_sethook(L, nullptr, 0, 0);
+
+        // frees of untracked blocks are ignored, so the live set can't be kept once tracking stops
+        bTracking = false;
+        Allocations.Empty();
+        for (auto& Stats : Tags)
+        {
+            Stats.Bytes = 0;
+            Stats.Count = 0;
+        }
+    }
+
+    void FLuaMemoryTracker::RegisterChunk(const FString& ChunkName, const FString& ModuleName)
+    {
+        ChunkModules.Add(ChunkName, ModuleName);
+    }
+
+    void FLuaMemoryTracker::OnAlloc(void* Ptr, size_t Size)
+    {
+        if (!Ptr)
+            return;
+
+        Allocations.Add(Ptr, {CurrentTag, (int32)Size});
+        auto& Stats = Tags[CurrentTag];
+        Stats.Bytes += Size;
+        Stats.Count++;
+    }
+
+    void FLuaMemoryTracker::OnFree(void* Ptr)
+    {
+        FAllocation Allocation;
+        if (!Ptr || !Allocations.RemoveAndCopyValue(Ptr, Allocation))
+            return;
+
+        auto& Stats = Tags[Allocation.Tag];
+        Stats.Bytes -= Allocation.Size;
+        Stats.Count--;
+    }
+
+    void FLuaMemoryTracker::OnRealloc(void* OldPtr, void* NewPtr, size_t NewSize)
+    {
+        FAllocation Allocation;
+        if (!Allocations.RemoveAndCopyValue(OldPtr, Allocation))
+        {
+            OnAlloc(NewPtr, NewSize);
+            return;
+        }
+
+        // growing an object is charged to whoever created it, not to the code that happens to grow it
+        Tags[Allocation.Tag].Bytes += (int64)NewSize - Allocation.Size;
+        Allocation.Size = (int32)NewSize;
+        Allocations.Add(NewPtr, Allocation);
+    }
+
+    FLuaMemoryTracker::FSnapshot FLuaMemoryTracker::TakeSnapshot() const
+    {
+        FSnapshot Snapshot;
+        for (const auto& Stats : Tags)
+        {
+            if (Stats.Count > 0)
+                Snapshot.Add(Stats);
+        }
+        Snapshot.Sort([](const FTagStats& A, const FTagStats& B) { return A.Bytes > B.Bytes; });
+        return Snapshot;
+    }
+
+    void FLuaMemoryTracker::SaveSnapshot(const FString& Name)
+    {
+        Snapshots.Add(Name, TakeSnapshot());
+    }
+
+    const FLuaMemoryTracker::FSnapshot* FLuaMemoryTracker::FindSnapshot(const FString& Name) const
+    {
+        return Snapshots.Find(Name);
+    }
+
+    void FLuaMemoryTracker::OnLuaHook(lua_State* L, lua_Debug* ar)
+    {
+        if (ar->event == LUA_HOOKLINE)
+        {
+            // line events are only added by the dead loop check once its timeout expired
+            lua_sethook(L, OnLuaHook, LUA_MASKCALL | LUA_MASKRET, 0);
+            FDeadLoopCheck::OnTimeout(L);
+            return;
+        }
+
+        auto& Tracker = *FLuaEnv::FindEnvChecked(L).GetMemoryTracker();
+        if (ar->event == LUA_HOOKCALL || ar->event == LUA_HOOKTAILCALL)
+        {
+            lua_getinfo(L, "S", ar);
+            // C functions allocate on behalf of the lua code calling them
+            if (ar->what[0] != 'C')
+                Tracker.CurrentTag = Tracker.FindOrAddSourceTag(ar->source);
+            return;
+        }
+
+        // returning, so charge the nearest lua frame below the one that is leaving
+        lua_Debug Frame;
+        for (int32 Level = 1; lua_getstack(L, Level, &Frame); ++Level)
+        {
+            lua_getinfo(L, "S", &Frame);
+            if (Frame.what[0] != 'C')
+            {
+                Tracker.CurrentTag = Tracker.FindOrAddSourceTag(Frame.source);
+                return;
+            }
+        }
+        Tracker.CurrentTag = Tracker.ScopeTags.Num() > 0 ? Tracker.ScopeTags.Last() : 0;
+    }
+
+    int32 FLuaMemoryTracker::FindOrAddTag(const FString& Tag)
+    {
+        if (const int32* Index = TagIndices.Find(Tag))
+            return *Index;
+
+        const int32 Index = Tags.AddDefaulted();
+        Tags[Index].Tag = Tag;
+        TagIndices.Add(Tag, Index);
+        return Index;
+    }
+
+    int32 FLuaMemoryTracker::FindOrAddSourceTag(const char* Source)
+    {
+        // source strings are owned by function prototypes, so an address may be reused once a prototype is collected
+        if (const auto Cached = SourceTags.Find(Source))
+        {
+            if (FCStringAnsi::Strcmp(Cached->Source.GetData(), Source) == 0)
+                return Cached->Tag;
+        }
+
+        FString ChunkName = UTF8_TO_TCHAR(Source);
+        if (ChunkName.StartsWith(TEXT("@")) || ChunkName.StartsWith(TEXT("=")))
+            ChunkName.RightChopInline(1, false);
+
+        const FString* ModuleName = ChunkModules.Find(ChunkName);
+        FSourceTag& SourceTag = SourceTags.Add(Source);
+        SourceTag.Tag = FindOrAddTag(ModuleName ? *ModuleName : ChunkName);
+        SourceTag.Source.SetNumUninitialized(FCStringAnsi::Strlen(Source) + 1);
+        FMemory::Memcpy(SourceTag.Source.GetData(), Source, SourceTag.Source.Num());
+        return SourceTag.Tag;
+    }
+}
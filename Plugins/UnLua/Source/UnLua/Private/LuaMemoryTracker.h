@@ -0,0 +1,110 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "lua.hpp"
+
+namespace UnLua
+{
+    class FLuaEnv;
+
+    /**
+     * Attributes live lua heap bytes to the module whose code is executing when the memory is allocated.
+     * The executing module is tracked with a call/return hook, chunk names are mapped back to module
+     * names by the file loaders, and memory allocated from native code is attributed to the innermost scope.
+     */
+    class FLuaMemoryTracker
+    {
+    public:
+        struct FTagStats
+        {
+            FString Tag;
+            int64 Bytes = 0;
+            int64 Count = 0;
+        };
+
+        using FSnapshot = TArray<FTagStats>;
+
+        class FScope final
+        {
+        public:
+            FScope(FLuaMemoryTracker* Owner, const FString& Tag);
+
+            ~FScope();
+
+        private:
+            FLuaMemoryTracker* Owner;
+        };
+
+        explicit FLuaMemoryTracker(FLuaEnv* Env);
+
+        TUniquePtr<FScope> MakeScope(const FString& Tag);
+
+        FORCEINLINE bool IsTracking() const { return bTracking; }
+
+        /** The dead loop check adds line events to the tracker's hook instead of skipping its own */
+        FORCEINLINE static bool IsTrackerHook(lua_Hook Hook) { return Hook == OnLuaHook; }
+
+        void Start();
+
+        void Stop();
+
+        void RegisterChunk(const FString& ChunkName, const FString& ModuleName);
+
+        void OnAlloc(void* Ptr, size_t Size);
+
+        void OnFree(void* Ptr);
+
+        void OnRealloc(void* OldPtr, void* NewPtr, size_t NewSize);
+
+        /** Live bytes per tag, sorted by size */
+        FSnapshot TakeSnapshot() const;
+
+        void SaveSnapshot(const FString& Name);
+
+        const FSnapshot* FindSnapshot(const FString& Name) const;
+
+    private:
+        struct FAllocation
+        {
+            int32 Tag;
+            int32 Size;
+        };
+
+        struct FSourceTag
+        {
+            int32 Tag;
+            TArray<ANSICHAR> Source;
+        };
+
+        static void OnLuaHook(lua_State* L, lua_Debug* ar);
+
+        int32 FindOrAddTag(const FString& Tag);
+
+        int32 FindOrAddSourceTag(const char* Source);
+
+        FLuaEnv* Env;
+        bool bTracking;
+        int32 CurrentTag;
+        TArray<int32> ScopeTags;
+        TArray<FTagStats> Tags;
+        TMap<FString, int32> TagIndices;
+        TMap<const char*, FSourceTag> SourceTags;
+        TMap<FString, FString> ChunkModules;
+        TMap<void*, FAllocation> Allocations;
+        TMap<FString, FSnapshot> Snapshots;
+    };
+}
@@ -1,4 +1,6 @@
 ﻿#include "UnLuaConsoleCommands.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
 
 #define LOCTEXT_NAMESPACE "UnLuaConsoleCommands"
 
@@ -20,6 +22,26 @@ namespace UnLua
               *LOCTEXT("CommandText_CollectGarbage", "Force collect garbage in lua env.").ToString(),
               FConsoleCommandWithArgsDelegate::CreateRaw(this, &FUnLuaConsoleCommands::CollectGarbage)
           ),
+          MemTrackCommand(
+              TEXT("lua.mem.track"),
+              *LOCTEXT("CommandText_MemTrack", "Starts or stops attributing lua memory to the module allocating it. usage: lua.mem.track <1|0>").ToString(),
+              FConsoleCommandWithArgsDelegate::CreateRaw(this, &FUnLuaConsoleCommands::MemTrack)
+          ),
+          MemSnapshotCommand(
+              TEXT("lua.mem.snapshot"),
+              *LOCTEXT("CommandText_MemSnapshot", "Logs live lua memory per module and saves it under the given name. usage: lua.mem.snapshot [name]").ToString(),
+              FConsoleCommandWithArgsDelegate::CreateRaw(this, &FUnLuaConsoleCommands::MemSnapshot)
+          ),
+          MemDiffCommand(
+              TEXT("lua.mem.diff"),
+              *LOCTEXT("CommandText_MemDiff", "Logs per module lua memory growth between two snapshots, or since a snapshot. usage: lua.mem.diff <from> [to]").ToString(),
+              FConsoleCommandWithArgsDelegate::CreateRaw(this, &FUnLuaConsoleCommands::MemDiff)
+          ),
+          MemCsvCommand(
+              TEXT("lua.mem.csv"),
+              *LOCTEXT("CommandText_MemCsv", "Writes a snapshot, or the live lua memory per module, to a csv file in the profiling dir. usage: lua.mem.csv [name]").ToString(),
+              FConsoleCommandWithArgsDelegate::CreateRaw(this, &FUnLuaConsoleCommands::MemCsv)
+          ),
           Module(InModule)
     {
     }
@@ -79,6 +101,134 @@ namespace UnLua
 
         Env->GC();
     }
+
+    void FUnLuaConsoleCommands::MemTrack(const TArray<FString>& Args) const
+    {
+        if (Args.Num() != 1)
+        {
+            UE_LOG(LogUnLua, Log, TEXT("usage: lua.mem.track <1|0>"));
+            return;
+        }
+
+        auto Env = Module->GetEnv();
+        if (!Env)
+        {
+            UE_LOG(LogUnLua, Warning, TEXT("no available lua env found to track memory."));
+            return;
+        }
+
+        if (Args[0].ToBool())
+            Env->GetMemoryTracker()->Start();
+        else
+            Env->GetMemoryTracker()->Stop();
+    }
+
+    void FUnLuaConsoleCommands::MemSnapshot(const TArray<FString>& Args) const
+    {
+        const auto Tracker = GetMemoryTracker(TEXT("take memory snapshot"));
+        if (!Tracker)
+            return;
+
+        const auto Snapshot = Tracker->TakeSnapshot();
+        int64 TotalBytes = 0;
+        UE_LOG(LogUnLua, Log, TEXT("  Bytes\tCount\tModule"));
+        for (const auto& Stats : Snapshot)
+        {
+            UE_LOG(LogUnLua, Log, TEXT("  %lld\t%lld\t%s"), Stats.Bytes, Stats.Count, *Stats.Tag);
+            TotalBytes += Stats.Bytes;
+        }
+        UE_LOG(LogUnLua, Log, TEXT("  %lld bytes tracked in %d modules"), TotalBytes, Snapshot.Num());
+
+        if (Args.Num() > 0)
+            Tracker->SaveSnapshot(Args[0]);
+    }
+
+    void FUnLuaConsoleCommands::MemDiff(const TArray<FString>& Args) const
+    {
+        if (Args.Num() < 1 || Args.Num() > 2)
+        {
+            UE_LOG(LogUnLua, Log, TEXT("usage: lua.mem.diff <from> [to]"));
+            return;
+        }
+
+        const auto Tracker = GetMemoryTracker(TEXT("diff memory snapshots"));
+        if (!Tracker)
+            return;
+
+        const auto From = Tracker->FindSnapshot(Args[0]);
+        const auto Current = Args.Num() > 1 ? FLuaMemoryTracker::FSnapshot() : Tracker->TakeSnapshot();
+        const auto To = Args.Num() > 1 ? Tracker->FindSnapshot(Args[1]) : &Current;
+        if (!From || !To)
+        {
+            UE_LOG(LogUnLua, Warning, TEXT("no lua memory snapshot named %s."), From ? *Args[1] : *Args[0]);
+            return;
+        }
+
+        TMap<FString, int64> Deltas;
+        for (const auto& Stats : *To)
+            Deltas.Add(Stats.Tag, Stats.Bytes);
+        for (const auto& Stats : *From)
+            Deltas.FindOrAdd(Stats.Tag) -= Stats.Bytes;
+        Deltas.ValueSort([](int64 A, int64 B) { return A > B; });
+
+        UE_LOG(LogUnLua, Log, TEXT("  Delta\tModule"));
+        for (const auto& Pair : Deltas)
+        {
+            if (Pair.Value != 0)
+                UE_LOG(LogUnLua, Log, TEXT("  %+lld\t%s"), Pair.Value, *Pair.Key);
+        }
+    }
+
+    void FUnLuaConsoleCommands::MemCsv(const TArray<FString>& Args) const
+    {
+#if ALLOW_DEBUG_FILES
+        const auto Tracker = GetMemoryTracker(TEXT("export memory"));
+        if (!Tracker)
+            return;
+
+        const auto Saved = Args.Num() > 0 ? Tracker->FindSnapshot(Args[0]) : nullptr;
+        if (Args.Num() > 0 && !Saved)
+        {
+            UE_LOG(LogUnLua, Warning, TEXT("no lua memory snapshot named %s."), *Args[0]);
+            return;
+        }
+
+        const auto Snapshot = Saved ? *Saved : Tracker->TakeSnapshot();
+        const FString OutputDir = FPaths::ProfilingDir() / TEXT("LuaMemory");
+        IFileManager::Get().MakeDirectory(*OutputDir, true);
+
+        const FString Suffix = Args.Num() > 0 ? TEXT("_") + Args[0] : FString();
+        const FString FileName = OutputDir / FString::Printf(TEXT("LuaMemory_%s%s.csv"), *FDateTime::Now().ToString(TEXT("%H%M%S")), *Suffix);
+        FArchive* OutputFile = IFileManager::Get().CreateDebugFileWriter(*FileName);
+        if (!OutputFile)
+        {
+            UE_LOG(LogUnLua, Warning, TEXT("failed to create %s."), *FileName);
+            return;
+        }
+
+        OutputFile->Logf(TEXT("Module,Bytes,Count"));
+        for (const auto& Stats : Snapshot)
+            OutputFile->Logf(TEXT("\"%s\",%lld,%lld"), *Stats.Tag.Replace(TEXT("\""), TEXT("\"\"")), Stats.Bytes, Stats.Count);
+        delete OutputFile;
+
+        UE_LOG(LogUnLua, Log, TEXT("wrote lua memory snapshot to %s"), *IFileManager::Get().ConvertToAbsolutePathForExternalAppForRead(*FileName));
+#endif
+    }
+
+    FLuaMemoryTracker* FUnLuaConsoleCommands::GetMemoryTracker(const TCHAR* Usage) const
+    {
+        const auto Env = Module->GetEnv();
+        if (!Env)
+        {
+            UE_LOG(LogUnLua, Warning, TEXT("no available lua env found to %s."), Usage);
+            return nullptr;
+        }
+
+        const auto Tracker = Env->GetMemoryTracker();
+        if (!Tracker->IsTracking())
+            UE_LOG(LogUnLua, Warning, TEXT("lua memory tracking is off, run lua.mem.track 1 first."));
+        return Tracker;
+    }
 }
 
 #undef LOCTEXT_NAMESPACE
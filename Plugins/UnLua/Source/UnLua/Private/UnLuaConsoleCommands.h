@@ -27,6 +27,14 @@ namespace UnLua
 
         FAutoConsoleCommand CollectGarbageCommand;
 
+        FAutoConsoleCommand MemTrackCommand;
+
+        FAutoConsoleCommand MemSnapshotCommand;
+
+        FAutoConsoleCommand MemDiffCommand;
+
+        FAutoConsoleCommand MemCsvCommand;
+
         explicit FUnLuaConsoleCommands(IUnLuaModule* InModule);
 
         void Do(const TArray<FString>& Args) const;
@@ -35,7 +43,17 @@ namespace UnLua
 
         void CollectGarbage(const TArray<FString>& Args) const;
 
+        void MemTrack(const TArray<FString>& Args) const;
+
+        void MemSnapshot(const TArray<FString>& Args) const;
+
+        void MemDiff(const TArray<FString>& Args) const;
+
+        void MemCsv(const TArray<FString>& Args) const;
+
     private:
+        FLuaMemoryTracker* GetMemoryTracker(const TCHAR* Usage) const;
+
         IUnLuaModule* Module;
     };
 }
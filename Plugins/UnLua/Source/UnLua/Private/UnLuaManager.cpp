@@ -29,6 +29,8 @@
 
 static const TCHAR* SReadableInputEvent[] = { TEXT("Pressed"), TEXT("Released"), TEXT("Repeat"), TEXT("DoubleClick"), TEXT("Axis"), TEXT("Max") };
 
+UNLUA_DECLARE_CYCLE_STAT("ReplaceInputs", ReplaceInputs);
+
 UUnLuaManager::UUnLuaManager()
     : InputActionFunc(nullptr), InputAxisFunc(nullptr), InputTouchFunc(nullptr), InputVectorAxisFunc(nullptr), InputGestureFunc(nullptr), AnimNotifyFunc(nullptr)
 {
@@ -38,7 +40,14 @@ UUnLuaManager::UUnLuaManager()
     }
 
     GetDefaultInputs();             // get all Axis/Action inputs
-    EKeys::GetAllKeys(AllKeys);     // get all key inputs
+
+    // get all key inputs
+    TArray<FKey> AllKeys;
+    EKeys::GetAllKeys(AllKeys);
+    for (const FKey &Key : AllKeys)
+    {
+        AllKeyNames.Add(Key.GetFName());
+    }
 
     // get template input UFunctions for InputAction/InputAxis/InputTouch/InputVectorAxis/InputGesture/AnimNotify
     UClass *Class = GetClass();
@@ -63,6 +72,9 @@ bool UUnLuaManager::Bind(UObject *Object, const TCHAR *InModuleName, int32 Initi
     if (!Env->GetClassRegistry()->Register(Class))
         return false;
 
+    // memory allocated natively while binding belongs to the bound module
+    const auto MemoryScope = Env->GetMemoryTracker()->MakeScope(InModuleName);
+
     // try bind lua if not bind or use a copyed table
     UnLua::FLuaRetValues RetValues = UnLua::Call(L, "require", TCHAR_TO_UTF8(InModuleName));
     FString Error;
@@ -162,6 +174,12 @@ void UUnLuaManager::GetDefaultInputs()
     {
         DefaultActionNames.Add(ActionName);
     }
+
+    // plans resolve against the default inputs
+    for (auto &Pair : Classes)
+    {
+        BuildInputBindingPlan(Pair.Value);
+    }
 }
 
 /**
@@ -181,19 +199,20 @@ bool UUnLuaManager::ReplaceInputs(AActor *Actor, UInputComponent *InputComponent
     if (!Actor || !InputComponent)
         return false;
 
+    UNLUA_SCOPE_CYCLE_COUNTER(ReplaceInputs);
+
     const auto Class = Actor->GetClass();
     const auto BindInfo = Classes.Find(Class);
     if (!BindInfo)
         return false;
 
-    auto& LuaFunctions = BindInfo->LuaFunctions;
-    ReplaceActionInputs(Actor, InputComponent, LuaFunctions);       // replace action inputs
-    ReplaceKeyInputs(Actor, InputComponent, LuaFunctions);          // replace key inputs
-    ReplaceAxisInputs(Actor, InputComponent, LuaFunctions);         // replace axis inputs
-    ReplaceTouchInputs(Actor, InputComponent, LuaFunctions);        // replace touch inputs
-    ReplaceAxisKeyInputs(Actor, InputComponent, LuaFunctions);      // replace AxisKey inputs
-    ReplaceVectorAxisInputs(Actor, InputComponent, LuaFunctions);   // replace VectorAxis inputs
-    ReplaceGestureInputs(Actor, InputComponent, LuaFunctions);      // replace gesture inputs
+    ReplaceActionInputs(Actor, InputComponent, *BindInfo);       // replace action inputs
+    ReplaceKeyInputs(Actor, InputComponent, *BindInfo);          // replace key inputs
+    ReplaceAxisInputs(Actor, InputComponent, *BindInfo);         // replace axis inputs
+    ReplaceTouchInputs(Actor, InputComponent, *BindInfo);        // replace touch inputs
+    ReplaceAxisKeyInputs(Actor, InputComponent, *BindInfo);      // replace AxisKey inputs
+    ReplaceVectorAxisInputs(Actor, InputComponent, *BindInfo);   // replace VectorAxis inputs
+    ReplaceGestureInputs(Actor, InputComponent, *BindInfo);      // replace gesture inputs
 
     return true;
 }
@@ -294,6 +313,7 @@ bool UUnLuaManager::BindClass(UClass* Class, const FString& InModuleName, FStrin
 
     UnLua::LowLevel::GetFunctionNames(Env->GetMainState(), Ref, BindInfo.LuaFunctions);
     ULuaFunction::GetOverridableFunctions(Class, BindInfo.UEFunctions);
+    BuildInputBindingPlan(BindInfo);
 
     // 用LuaTable里所有的函数来替换Class上对应的UFunction
     for (const auto& LuaFuncName : BindInfo.LuaFunctions)
@@ -337,12 +357,70 @@ bool UUnLuaManager::BindClass(UClass* Class, const FString& InModuleName, FStrin
     return true;
 }
 
+/**
+ * Resolve the input events handled by the Lua functions of a bound class
+ */
+void UUnLuaManager::BuildInputBindingPlan(FClassBindInfo &BindInfo) const
+{
+    FInputBindingPlan &Plan = BindInfo.InputBindingPlan;
+    Plan = FInputBindingPlan();
+    if (!BindInfo.Class->IsChildOf<AActor>())
+    {
+        return;
+    }
+
+    for (const FName &FuncName : BindInfo.LuaFunctions)
+    {
+        if (DefaultAxisNames.Contains(FuncName))
+        {
+            Plan.DefaultAxes.Add(FuncName);
+        }
+        if (AllKeyNames.Contains(FuncName))
+        {
+            Plan.KeyFunctions.Add(FuncName);
+        }
+
+        // input event handlers are named '<Action/Key>_<Event>'
+        const FString Name = FuncName.ToString();
+        int32 Separator;
+        if (!Name.FindLastChar(TEXT('_'), Separator))
+        {
+            continue;
+        }
+
+        const FString Suffix = Name.Mid(Separator + 1);
+        for (int32 Event = IE_Pressed; Event < IE_MAX; ++Event)
+        {
+            if (!Suffix.Equals(SReadableInputEvent[Event], ESearchCase::IgnoreCase))
+            {
+                continue;
+            }
+
+            const FName InputName(*Name.Left(Separator));
+            Plan.EventFunctions[Event].Add(InputName, FuncName);
+            if (Event == IE_Pressed || Event == IE_Released)
+            {
+                if (DefaultActionNames.Contains(InputName))
+                {
+                    Plan.DefaultActions.Add({ InputName, (EInputEvent)Event, FuncName });
+                }
+                if (AllKeyNames.Contains(InputName))
+                {
+                    Plan.DefaultKeys.Add({ InputName, (EInputEvent)Event, FuncName });
+                }
+            }
+            break;
+        }
+    }
+}
+
 /**
  * Replace action inputs
  */
-void UUnLuaManager::ReplaceActionInputs(AActor *Actor, UInputComponent *InputComponent, TSet<FName> &LuaFunctions)
+void UUnLuaManager::ReplaceActionInputs(AActor *Actor, UInputComponent *InputComponent, const FClassBindInfo &BindInfo)
 {
     UClass *Class = Actor->GetClass();
+    const FInputBindingPlan &Plan = BindInfo.InputBindingPlan;
 
     TSet<FName> ActionNames;
     int32 NumActionBindings = InputComponent->GetNumActionBindings();
@@ -350,55 +428,47 @@ void UUnLuaManager::ReplaceActionInputs(AActor *Actor, UInputComponent *InputCom
     {
         FInputActionBinding &IAB = InputComponent->GetActionBinding(i);
         FName Name = GET_INPUT_ACTION_NAME(IAB);
-        FString ActionName = Name.ToString();
         ActionNames.Add(Name);
 
-        FName FuncName = FName(*FString::Printf(TEXT("%s_%s"), *ActionName, SReadableInputEvent[IAB.KeyEvent]));
-        if (LuaFunctions.Find(FuncName))
+        if (const FName *FuncName = Plan.FindEventFunction(Name, IAB.KeyEvent))
         {
-            ULuaFunction::Override(InputActionFunc, Class, FuncName);
-            IAB.ActionDelegate.BindDelegate(Actor, FuncName);
+            ULuaFunction::Override(InputActionFunc, Class, *FuncName);
+            IAB.ActionDelegate.BindDelegate(Actor, *FuncName);
         }
 
         if (!IS_INPUT_ACTION_PAIRED(IAB))
         {
             EInputEvent IE = IAB.KeyEvent == IE_Pressed ? IE_Released : IE_Pressed;
-            FuncName = FName(*FString::Printf(TEXT("%s_%s"), *ActionName, SReadableInputEvent[IE]));
-            if (LuaFunctions.Find(FuncName))
+            if (const FName *FuncName = Plan.FindEventFunction(Name, IE))
             {
-                ULuaFunction::Override(InputActionFunc, Class, FuncName);
+                ULuaFunction::Override(InputActionFunc, Class, *FuncName);
                 FInputActionBinding AB(Name, IE);
-                AB.ActionDelegate.BindDelegate(Actor, FuncName);
+                AB.ActionDelegate.BindDelegate(Actor, *FuncName);
                 InputComponent->AddActionBinding(AB);
             }
         }
     }
 
-    EInputEvent IEs[] = { IE_Pressed, IE_Released };
-    TSet<FName> DiffActionNames = DefaultActionNames.Difference(ActionNames);
-    for (TSet<FName>::TConstIterator It(DiffActionNames); It; ++It)
+    for (const FInputBinding &Binding : Plan.DefaultActions)
     {
-        FName ActionName = *It;
-        for (int32 i = 0; i < 2; ++i)
+        if (ActionNames.Contains(Binding.Name))
         {
-            FName FuncName = FName(*FString::Printf(TEXT("%s_%s"), *ActionName.ToString(), SReadableInputEvent[IEs[i]]));
-            if (LuaFunctions.Find(FuncName))
-            {
-                ULuaFunction::Override(InputActionFunc, Class, FuncName);
-                FInputActionBinding AB(ActionName, IEs[i]);
-                AB.ActionDelegate.BindDelegate(Actor, FuncName);
-                InputComponent->AddActionBinding(AB);
-            }
+            continue;
         }
+        ULuaFunction::Override(InputActionFunc, Class, Binding.FuncName);
+        FInputActionBinding AB(Binding.Name, Binding.Event);
+        AB.ActionDelegate.BindDelegate(Actor, Binding.FuncName);
+        InputComponent->AddActionBinding(AB);
     }
 }
 
 /**
  * Replace key inputs
  */
-void UUnLuaManager::ReplaceKeyInputs(AActor *Actor, UInputComponent *InputComponent, TSet<FName> &LuaFunctions)
+void UUnLuaManager::ReplaceKeyInputs(AActor *Actor, UInputComponent *InputComponent, const FClassBindInfo &BindInfo)
 {
     UClass *Class = Actor->GetClass();
+    const FInputBindingPlan &Plan = BindInfo.InputBindingPlan;
 
     TArray<FKey> Keys;
     TArray<bool> PairedKeys;
@@ -417,11 +487,10 @@ void UUnLuaManager::ReplaceKeyInputs(AActor *Actor, UInputComponent *InputCompon
             PairedKeys[Index] = true;
         }
 
-        FName FuncName = FName(*FString::Printf(TEXT("%s_%s"), *IKB.Chord.Key.ToString(), SReadableInputEvent[IKB.KeyEvent]));
-        if (LuaFunctions.Find(FuncName))
+        if (const FName *FuncName = Plan.FindEventFunction(IKB.Chord.Key.GetFName(), IKB.KeyEvent))
         {
-            ULuaFunction::Override(InputActionFunc, Class, FuncName);
-            IKB.KeyDelegate.BindDelegate(Actor, FuncName);
+            ULuaFunction::Override(InputActionFunc, Class, *FuncName);
+            IKB.KeyDelegate.BindDelegate(Actor, *FuncName);
         }
     }
 
@@ -430,42 +499,34 @@ void UUnLuaManager::ReplaceKeyInputs(AActor *Actor, UInputComponent *InputCompon
         if (!PairedKeys[i])
         {
             EInputEvent IE = InputEvents[i] == IE_Pressed ? IE_Released : IE_Pressed;
-            FName FuncName = FName(*FString::Printf(TEXT("%s_%s"), *Keys[i].ToString(), SReadableInputEvent[IE]));
-            if (LuaFunctions.Find(FuncName))
+            if (const FName *FuncName = Plan.FindEventFunction(Keys[i].GetFName(), IE))
             {
-                ULuaFunction::Override(InputActionFunc, Class, FuncName);
+                ULuaFunction::Override(InputActionFunc, Class, *FuncName);
                 FInputKeyBinding IKB(FInputChord(Keys[i]), IE);
-                IKB.KeyDelegate.BindDelegate(Actor, FuncName);
+                IKB.KeyDelegate.BindDelegate(Actor, *FuncName);
                 InputComponent->KeyBindings.Add(IKB);
             }
         }
     }
 
-    EInputEvent IEs[] = { IE_Pressed, IE_Released };
-    for (const FKey &Key : AllKeys)
+    for (const FInputBinding &Binding : Plan.DefaultKeys)
     {
+        const FKey Key(Binding.Name);
         if (Keys.Find(Key) != INDEX_NONE)
         {
             continue;
         }
-        for (int32 i = 0; i < 2; ++i)
-        {
-            FName FuncName = FName(*FString::Printf(TEXT("%s_%s"), *Key.ToString(), SReadableInputEvent[IEs[i]]));
-            if (LuaFunctions.Find(FuncName))
-            {
-                ULuaFunction::Override(InputActionFunc, Class, FuncName);
-                FInputKeyBinding IKB(FInputChord(Key), IEs[i]);
-                IKB.KeyDelegate.BindDelegate(Actor, FuncName);
-                InputComponent->KeyBindings.Add(IKB);
-            }
-        }
+        ULuaFunction::Override(InputActionFunc, Class, Binding.FuncName);
+        FInputKeyBinding IKB(FInputChord(Key), Binding.Event);
+        IKB.KeyDelegate.BindDelegate(Actor, Binding.FuncName);
+        InputComponent->KeyBindings.Add(IKB);
     }
 }
 
 /**
  * Replace axis inputs
  */
-void UUnLuaManager::ReplaceAxisInputs(AActor *Actor, UInputComponent *InputComponent, TSet<FName> &LuaFunctions)
+void UUnLuaManager::ReplaceAxisInputs(AActor *Actor, UInputComponent *InputComponent, const FClassBindInfo &BindInfo)
 {
     UClass *Class = Actor->GetClass();
 
@@ -473,52 +534,53 @@ void UUnLuaManager::ReplaceAxisInputs(AActor *Actor, UInputComponent *InputCompo
     for (FInputAxisBinding &IAB : InputComponent->AxisBindings)
     {
         AxisNames.Add(IAB.AxisName);
-        if (LuaFunctions.Find(IAB.AxisName))
+        if (BindInfo.LuaFunctions.Contains(IAB.AxisName))
         {
             ULuaFunction::Override(InputAxisFunc, Class, IAB.AxisName);
             IAB.AxisDelegate.BindDelegate(Actor, IAB.AxisName);
         }
     }
 
-    TSet<FName> DiffAxisNames = DefaultAxisNames.Difference(AxisNames);
-    for (TSet<FName>::TConstIterator It(DiffAxisNames); It; ++It)
+    for (const FName &AxisName : BindInfo.InputBindingPlan.DefaultAxes)
     {
-        if (LuaFunctions.Find(*It))
+        if (AxisNames.Contains(AxisName))
         {
-            ULuaFunction::Override(InputAxisFunc, Class, *It);
-            FInputAxisBinding &IAB = InputComponent->BindAxis(*It);
-            IAB.AxisDelegate.BindDelegate(Actor, *It);
+            continue;
         }
+        ULuaFunction::Override(InputAxisFunc, Class, AxisName);
+        FInputAxisBinding &IAB = InputComponent->BindAxis(AxisName);
+        IAB.AxisDelegate.BindDelegate(Actor, AxisName);
     }
 }
 
 /**
  * Replace touch inputs
  */
-void UUnLuaManager::ReplaceTouchInputs(AActor *Actor, UInputComponent *InputComponent, TSet<FName> &LuaFunctions)
+void UUnLuaManager::ReplaceTouchInputs(AActor *Actor, UInputComponent *InputComponent, const FClassBindInfo &BindInfo)
 {
+    static const FName TouchName(TEXT("Touch"));
+
     UClass *Class = Actor->GetClass();
+    const FInputBindingPlan &Plan = BindInfo.InputBindingPlan;
 
     TArray<EInputEvent> InputEvents = { IE_Pressed, IE_Released, IE_Repeat };        // IE_DoubleClick?
     for (FInputTouchBinding &ITB : InputComponent->TouchBindings)
     {
         InputEvents.Remove(ITB.KeyEvent);
-        FName FuncName = FName(*FString::Printf(TEXT("Touch_%s"), SReadableInputEvent[ITB.KeyEvent]));
-        if (LuaFunctions.Find(FuncName))
+        if (const FName *FuncName = Plan.FindEventFunction(TouchName, ITB.KeyEvent))
         {
-            ULuaFunction::Override(InputTouchFunc, Class, FuncName);
-            ITB.TouchDelegate.BindDelegate(Actor, FuncName);
+            ULuaFunction::Override(InputTouchFunc, Class, *FuncName);
+            ITB.TouchDelegate.BindDelegate(Actor, *FuncName);
         }
     }
 
     for (EInputEvent IE : InputEvents)
     {
-        FName FuncName = FName(*FString::Printf(TEXT("Touch_%s"), SReadableInputEvent[IE]));
-        if (LuaFunctions.Find(FuncName))
+        if (const FName *FuncName = Plan.FindEventFunction(TouchName, IE))
         {
-            ULuaFunction::Override(InputTouchFunc, Class, FuncName);
+            ULuaFunction::Override(InputTouchFunc, Class, *FuncName);
             FInputTouchBinding ITB(IE);
-            ITB.TouchDelegate.BindDelegate(Actor, FuncName);
+            ITB.TouchDelegate.BindDelegate(Actor, *FuncName);
             InputComponent->TouchBindings.Add(ITB);
         }
     }
@@ -527,13 +589,19 @@ void UUnLuaManager::ReplaceTouchInputs(AActor *Actor, UInputComponent *InputComp
 /**
  * Replace axis key inputs
  */
-void UUnLuaManager::ReplaceAxisKeyInputs(AActor *Actor, UInputComponent *InputComponent, TSet<FName> &LuaFunctions)
+void UUnLuaManager::ReplaceAxisKeyInputs(AActor *Actor, UInputComponent *InputComponent, const FClassBindInfo &BindInfo)
 {
+    const TSet<FName> &KeyFunctions = BindInfo.InputBindingPlan.KeyFunctions;
+    if (KeyFunctions.Num() == 0)
+    {
+        return;
+    }
+
     UClass *Class = Actor->GetClass();
     for (FInputAxisKeyBinding &IAKB : InputComponent->AxisKeyBindings)
     {
         FName FuncName = IAKB.AxisKey.GetFName();
-        if (LuaFunctions.Find(FuncName))
+        if (KeyFunctions.Contains(FuncName))
         {
             ULuaFunction::Override(InputAxisFunc, Class, FuncName);
             IAKB.AxisDelegate.BindDelegate(Actor, FuncName);
@@ -544,13 +612,19 @@ void UUnLuaManager::ReplaceAxisKeyInputs(AActor *Actor, UInputComponent *InputCo
 /**
  * Replace vector axis inputs
  */
-void UUnLuaManager::ReplaceVectorAxisInputs(AActor *Actor, UInputComponent *InputComponent, TSet<FName> &LuaFunctions)
+void UUnLuaManager::ReplaceVectorAxisInputs(AActor *Actor, UInputComponent *InputComponent, const FClassBindInfo &BindInfo)
 {
+    const TSet<FName> &KeyFunctions = BindInfo.InputBindingPlan.KeyFunctions;
+    if (KeyFunctions.Num() == 0)
+    {
+        return;
+    }
+
     UClass *Class = Actor->GetClass();
     for (FInputVectorAxisBinding &IVAB : InputComponent->VectorAxisBindings)
     {
         FName FuncName = IVAB.AxisKey.GetFName();
-        if (LuaFunctions.Find(FuncName))
+        if (KeyFunctions.Contains(FuncName))
         {
             ULuaFunction::Override(InputVectorAxisFunc, Class, FuncName);
             IVAB.AxisDelegate.BindDelegate(Actor, FuncName);
@@ -561,13 +635,19 @@ void UUnLuaManager::ReplaceVectorAxisInputs(AActor *Actor, UInputComponent *Inpu
 /**
  * Replace gesture inputs
  */
-void UUnLuaManager::ReplaceGestureInputs(AActor *Actor, UInputComponent *InputComponent, TSet<FName> &LuaFunctions)
+void UUnLuaManager::ReplaceGestureInputs(AActor *Actor, UInputComponent *InputComponent, const FClassBindInfo &BindInfo)
 {
+    const TSet<FName> &KeyFunctions = BindInfo.InputBindingPlan.KeyFunctions;
+    if (KeyFunctions.Num() == 0)
+    {
+        return;
+    }
+
     UClass *Class = Actor->GetClass();
     for (FInputGestureBinding &IGB : InputComponent->GestureBindings)
     {
         FName FuncName = IGB.GestureKey.GetFName();
-        if (LuaFunctions.Find(FuncName))
+        if (KeyFunctions.Contains(FuncName))
         {
             ULuaFunction::Override(InputGestureFunc, Class, FuncName);
             IGB.GestureDelegate.BindDelegate(Actor, FuncName);
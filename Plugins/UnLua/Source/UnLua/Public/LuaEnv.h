@@ -25,8 +25,10 @@
 #include "lua.hpp"
 #include "ObjectReferencer.h"
 #include "HAL/Platform.h"
+#include "LuaActorPool.h"
 #include "LuaDanglingCheck.h"
 #include "LuaDeadLoopCheck.h"
+#include "LuaMemoryTracker.h"
 #include "LuaModuleLocator.h"
 
 namespace UnLua
@@ -109,6 +111,10 @@ namespace UnLua
 
         FORCEINLINE FDeadLoopCheck* GetDeadLoopCheck() const { return DeadLoopCheck; }
 
+        FORCEINLINE FLuaMemoryTracker* GetMemoryTracker() const { return MemoryTracker; }
+
+        FORCEINLINE FActorPool* GetActorPool() const { return ActorPool; }
+
         void AddLoader(const FLuaFileLoader Loader);
 
         void AddBuiltInLoader(const FString InName, lua_CFunction Loader);
@@ -172,6 +178,8 @@ namespace UnLua
         FEnumRegistry* EnumRegistry;
         FDanglingCheck* DanglingCheck;
         FDeadLoopCheck* DeadLoopCheck;
+        FLuaMemoryTracker* MemoryTracker;
+        FActorPool* ActorPool;
         TMap<lua_State*, int32> ThreadToRef;
         TMap<int32, lua_State*> RefToThread;
         FDelegateHandle OnAsyncLoadingFlushUpdateHandle;
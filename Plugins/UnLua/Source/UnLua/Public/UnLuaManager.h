@@ -15,6 +15,7 @@
 #pragma once
 
 #include "InputCoreTypes.h"
+#include "Engine/EngineBaseTypes.h"
 #include "Engine/DynamicBlueprintBinding.h"
 #include "lua.hpp"
 #include "UnLuaCompatibility.h"
@@ -80,16 +81,28 @@ public:
     void TriggerAnimNotify();
 
 private:
-    /* 将一个UClass绑定到Lua模块，根据这个模块定义的函数列表来覆盖上面的UFunction */
-    bool BindClass(UClass *Class, const FString &InModuleName, FString &Error);
+    /* an input binding to add when the input component doesn't bind the input itself */
+    struct FInputBinding
+    {
+        FName Name;
+        EInputEvent Event;
+        FName FuncName;
+    };
 
-    void ReplaceActionInputs(AActor *Actor, UInputComponent *InputComponent, TSet<FName> &LuaFunctions);
-    void ReplaceKeyInputs(AActor *Actor, UInputComponent *InputComponent, TSet<FName> &LuaFunctions);
-    void ReplaceAxisInputs(AActor *Actor, UInputComponent *InputComponent, TSet<FName> &LuaFunctions);
-    void ReplaceTouchInputs(AActor *Actor, UInputComponent *InputComponent, TSet<FName> &LuaFunctions);
-    void ReplaceAxisKeyInputs(AActor *Actor, UInputComponent *InputComponent, TSet<FName> &LuaFunctions);
-    void ReplaceVectorAxisInputs(AActor *Actor, UInputComponent *InputComponent, TSet<FName> &LuaFunctions);
-    void ReplaceGestureInputs(AActor *Actor, UInputComponent *InputComponent, TSet<FName> &LuaFunctions);
+    /* Lua input handlers of a bound class, resolved once from the Lua function names when the class is bound */
+    struct FInputBindingPlan
+    {
+        TMap<FName, FName> EventFunctions[IE_MAX];  // input name -> Lua function, per input event
+        TArray<FInputBinding> DefaultActions;       // handled actions from the input settings
+        TArray<FInputBinding> DefaultKeys;          // handled key presses/releases
+        TArray<FName> DefaultAxes;                  // handled axes from the input settings
+        TSet<FName> KeyFunctions;                   // functions named after a key, for axis key/vector axis/gesture inputs
+
+        FORCEINLINE const FName* FindEventFunction(FName InputName, EInputEvent Event) const
+        {
+            return EventFunctions[Event].Find(InputName);
+        }
+    };
 
     struct FClassBindInfo
     {
@@ -98,13 +111,27 @@ private:
         int TableRef;
         TSet<FName> LuaFunctions;
         TMap<FName, UFunction*> UEFunctions;
+        FInputBindingPlan InputBindingPlan;
     };
 
+    /* 将一个UClass绑定到Lua模块，根据这个模块定义的函数列表来覆盖上面的UFunction */
+    bool BindClass(UClass *Class, const FString &InModuleName, FString &Error);
+
+    void BuildInputBindingPlan(FClassBindInfo &BindInfo) const;
+
+    void ReplaceActionInputs(AActor *Actor, UInputComponent *InputComponent, const FClassBindInfo &BindInfo);
+    void ReplaceKeyInputs(AActor *Actor, UInputComponent *InputComponent, const FClassBindInfo &BindInfo);
+    void ReplaceAxisInputs(AActor *Actor, UInputComponent *InputComponent, const FClassBindInfo &BindInfo);
+    void ReplaceTouchInputs(AActor *Actor, UInputComponent *InputComponent, const FClassBindInfo &BindInfo);
+    void ReplaceAxisKeyInputs(AActor *Actor, UInputComponent *InputComponent, const FClassBindInfo &BindInfo);
+    void ReplaceVectorAxisInputs(AActor *Actor, UInputComponent *InputComponent, const FClassBindInfo &BindInfo);
+    void ReplaceGestureInputs(AActor *Actor, UInputComponent *InputComponent, const FClassBindInfo &BindInfo);
+
     TMap<UClass*, FClassBindInfo> Classes;
 
     TSet<FName> DefaultAxisNames;
     TSet<FName> DefaultActionNames;
-    TArray<FKey> AllKeys;
+    TSet<FName> AllKeyNames;
 
     UFunction *InputActionFunc;
     UFunction *InputAxisFunc;
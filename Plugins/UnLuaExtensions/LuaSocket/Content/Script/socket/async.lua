@@ -0,0 +1,145 @@
+-----------------------------------------------------------------------------
+-- Non-blocking socket helpers
+-- Wraps LuaSocket objects so that blocking calls park the running coroutine
+-- in the socket reactor instead of blocking the game thread. The reactor is
+-- polled once per frame by the host, which resumes the coroutine when the
+-- socket becomes ready.
+-----------------------------------------------------------------------------
+
+-----------------------------------------------------------------------------
+-- Declare module and import dependencies
+-----------------------------------------------------------------------------
+local base = _G
+local coroutine = require("coroutine")
+local socket = require("socket")
+
+local _M = {}
+
+local wrapper = {}
+wrapper.__index = wrapper
+
+-----------------------------------------------------------------------------
+-- Internal helpers
+-----------------------------------------------------------------------------
+local function remaining(deadline)
+    if not deadline then return nil end
+    local left = deadline - socket.gettime()
+    if left < 0 then return 0 end
+    return left
+end
+
+local function deadline(self)
+    return self.timeout and socket.gettime() + self.timeout
+end
+
+-----------------------------------------------------------------------------
+-- Exported functions
+-----------------------------------------------------------------------------
+-- wraps a master, client or server socket, timeout is in seconds per call
+function _M.wrap(sock, timeout)
+    sock:settimeout(0)
+    -- unset timeouts are stored as false, so they never fall through to the
+    -- wrapped socket methods below
+    return base.setmetatable({ sock = sock, timeout = timeout or false }, wrapper)
+end
+
+-- creates a wrapped tcp socket
+function _M.tcp(timeout)
+    local sock, err = socket.tcp()
+    if not sock then return nil, err end
+    return _M.wrap(sock, timeout)
+end
+
+-- runs a function in a new coroutine, reporting errors through error
+function _M.spawn(f, ...)
+    local co = coroutine.create(f)
+    local ok, err = coroutine.resume(co, ...)
+    if not ok then base.error(err, 0) end
+    return co
+end
+
+-- number of coroutines parked in the reactor
+function _M.waiting()
+    return socket.waiting()
+end
+
+-----------------------------------------------------------------------------
+-- Wrapped socket methods
+-----------------------------------------------------------------------------
+function wrapper:settimeout(timeout)
+    self.timeout = timeout or false
+    return 1
+end
+
+function wrapper:getfd()
+    return self.sock:getfd()
+end
+
+function wrapper:dirty()
+    return self.sock:dirty()
+end
+
+function wrapper:unwrap()
+    return self.sock
+end
+
+function wrapper:close()
+    return self.sock:close()
+end
+
+function wrapper:connect(address, port)
+    local ok, err = self.sock:connect(address, port)
+    if ok or err ~= "timeout" then return ok, err end
+    ok, err = socket.wait(self.sock, "w", self.timeout or nil)
+    if not ok then return nil, err end
+    -- asking again reports the outcome of the pending connection
+    ok, err = self.sock:connect(address, port)
+    if ok or err == "already connected" then return 1 end
+    return nil, err
+end
+
+function wrapper:accept()
+    local limit = deadline(self)
+    while true do
+        local client, err = self.sock:accept()
+        if client then return _M.wrap(client, self.timeout) end
+        if err ~= "timeout" then return nil, err end
+        local ok, werr = socket.wait(self.sock, "r", remaining(limit))
+        if not ok then return nil, werr end
+    end
+end
+
+function wrapper:receive(pattern, prefix)
+    local limit = deadline(self)
+    while true do
+        local data, err, partial = self.sock:receive(pattern, prefix)
+        if data or err ~= "timeout" then return data, err, partial end
+        prefix = partial
+        local ok, werr = socket.wait(self.sock, "r", remaining(limit))
+        if not ok then return nil, werr, prefix end
+    end
+end
+
+function wrapper:send(data, i, j)
+    local limit = deadline(self)
+    i = i or 1
+    while true do
+        local last, err, sent = self.sock:send(data, i, j)
+        if last or err ~= "timeout" then return last, err, sent end
+        i = sent + 1
+        local ok, werr = socket.wait(self.sock, "w", remaining(limit))
+        if not ok then return nil, werr, sent end
+    end
+end
+
+-- everything else goes straight to the wrapped socket
+base.setmetatable(wrapper, {
+    __index = function(_, name)
+        return function(self, ...)
+            local sock = self.sock
+            return sock[name](sock, ...)
+        end
+    end
+})
+
+return _M
@@ -15,6 +15,9 @@
 #include "LuaSocketModule.h"
 #include "LuaEnv.h"
 #include "luasocket.h"
+#include "reactor.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogLuaSocket, Log, All);
 
 void FLuaSocketModule::StartupModule()
 {
@@ -22,11 +25,32 @@ void FLuaSocketModule::StartupModule()
 
     for (const auto& Pair : UnLua::FLuaEnv::GetAll())
         OnLuaEnvCreated(*Pair.Value);
+
+    TickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&FLuaSocketModule::Tick), 0.0f);
 }
 
 void FLuaSocketModule::ShutdownModule()
 {
     UnLua::FLuaEnv::OnCreated.RemoveAll(this);
+    FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+}
+
+bool FLuaSocketModule::Tick(float DeltaTime)
+{
+    QUICK_SCOPE_CYCLE_COUNTER(STAT_LuaSocketModule_Tick);
+
+    for (const auto& Pair : UnLua::FLuaEnv::GetAll())
+    {
+        const auto L = Pair.Key;
+        if (reactor_waiting(L) == 0)
+            continue;
+
+        reactor_tick(L, [](lua_State* Co, const char* Msg)
+        {
+            UE_LOG(LogLuaSocket, Error, TEXT("%s"), UTF8_TO_TCHAR(Msg ? Msg : "error in socket coroutine"));
+        });
+    }
+    return true;
 }
 
 void FLuaSocketModule::OnLuaEnvCreated(UnLua::FLuaEnv& Env)
@@ -0,0 +1,181 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+#include "CoreMinimal.h"
+#include "LuaEnv.h"
+#include "Misc/AutomationTest.h"
+#include "reactor.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// Echo server, clients and the edge cases of the reactor, all driven by socket.async on localhost.
+// The chunk only parks coroutines, the test ticks the reactor the way FLuaSocketModule does every frame.
+static const TCHAR* LuaSocketReactorTestChunk = TEXT(R"LUA(
+local socket = require("socket")
+local async = require("socket.async")
+
+local results = { echoed = 0 }
+local handlers = 0
+local finished = false
+
+-- parks the coroutine for a while on a socket that never becomes readable
+local idle = assert(socket.udp())
+assert(idle:setsockname("127.0.0.1", 0))
+local function sleep(t)
+    socket.wait(idle, "r", t)
+end
+
+local function until_true(f)
+    local limit = socket.gettime() + 5
+    while not f() and socket.gettime() < limit do sleep(0.01) end
+end
+
+local server = assert(async.tcp())
+assert(server:bind("127.0.0.1", 0))
+assert(server:listen(128))
+local _, port = server:getsockname()
+
+-- echoes lines until the peer goes away, never answers "silent"
+async.spawn(function()
+    while true do
+        local client = server:accept()
+        if not client then break end
+        handlers = handlers + 1
+        async.spawn(function()
+            while true do
+                local line = client:receive("*l")
+                if not line then break end
+                if line ~= "silent" then client:send(line .. "\n") end
+            end
+            client:close()
+            handlers = handlers - 1
+        end)
+    end
+end)
+
+async.spawn(function()
+    -- many clients serviced by the same ticks
+    local clients = 0
+    for i = 1, 64 do
+        async.spawn(function()
+            local c = async.tcp(5)
+            if c:connect("127.0.0.1", port) and c:send("hello " .. i .. "\n") and
+                    c:receive("*l") == "hello " .. i then
+                results.echoed = results.echoed + 1
+            end
+            c:close()
+            clients = clients + 1
+        end)
+    end
+    until_true(function() return clients == 64 and handlers == 0 end)
+
+    -- a wait that times out
+    local c = async.tcp(0.2)
+    assert(c:connect("127.0.0.1", port))
+    assert(c:send("silent\n"))
+    results.timeout = select(2, c:receive("*l"))
+    c:close()
+
+    -- a listener that timed out and one reusing its descriptor right away
+    local l = async.tcp(0.1)
+    assert(l:bind("127.0.0.1", 0))
+    assert(l:listen(1))
+    local fd = l:getfd()
+    l:accept()
+    l:close()
+    l = async.tcp(2)
+    assert(l:bind("127.0.0.1", 0))
+    assert(l:listen(1))
+    results.samefd = l:getfd() == fd
+    local _, lport = l:getsockname()
+    async.spawn(function()
+        sleep(0.05)
+        local peer = async.tcp(2)
+        peer:connect("127.0.0.1", lport)
+        peer:close()
+    end)
+    local accepted = l:accept()
+    results.reused = accepted ~= nil
+    if accepted then accepted:close() end
+    l:close()
+
+    -- closing a socket wakes the coroutine parked on it
+    c = async.tcp()
+    assert(c:connect("127.0.0.1", port))
+    async.spawn(function()
+        results.closed = select(2, c:receive("*l"))
+    end)
+    c:close()
+    until_true(function() return results.closed ~= nil end)
+
+    server:close()
+    idle:close()
+    finished = true
+end)
+
+function reactor_test_done() return finished end
+reactor_test_results = results
+)LUA");
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLuaSocketReactorTest, "UnLua.LuaSocket.Reactor", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FLuaSocketReactorTest::RunTest(const FString& Parameters)
+{
+    UnLua::FLuaEnv Env;
+    lua_State* L = Env.GetMainState();
+
+    if (!TestTrue(TEXT("Test chunk runs"), Env.DoString(LuaSocketReactorTestChunk, TEXT("LuaSocketReactorTest"))))
+        return false;
+
+    const auto IsDone = [L]()
+    {
+        lua_getglobal(L, "reactor_test_done");
+        lua_call(L, 0, 1);
+        const bool bDone = !!lua_toboolean(L, -1);
+        lua_pop(L, 1);
+        return bDone && reactor_waiting(L) == 0;
+    };
+
+    const double EndTime = FPlatformTime::Seconds() + 10.0;
+    while (!IsDone() && FPlatformTime::Seconds() < EndTime)
+    {
+        reactor_tick(L, [](lua_State* Co, const char* Msg)
+        {
+            UE_LOG(LogTemp, Error, TEXT("%s"), UTF8_TO_TCHAR(Msg ? Msg : "error in socket coroutine"));
+        });
+        FPlatformProcess::Sleep(0.001f);
+    }
+
+    TestTrue(TEXT("Every coroutine finished and left the reactor"), IsDone());
+
+    lua_getglobal(L, "reactor_test_results");
+    const auto GetResult = [L](const char* Name)
+    {
+        lua_getfield(L, -1, Name);
+        const FString Result = lua_isstring(L, -1) ? UTF8_TO_TCHAR(lua_tostring(L, -1)) : (lua_toboolean(L, -1) ? TEXT("true") : TEXT("false"));
+        lua_pop(L, 1);
+        return Result;
+    };
+
+    TestEqual(TEXT("Echo clients served"), GetResult("echoed"), TEXT("64"));
+    TestEqual(TEXT("Receive with a timeout"), GetResult("timeout"), TEXT("timeout"));
+    TestEqual(TEXT("Listener reused its descriptor"), GetResult("samefd"), TEXT("true"));
+    TestEqual(TEXT("Wait on a reused descriptor"), GetResult("reused"), TEXT("true"));
+    TestEqual(TEXT("Closing a socket wakes its waiter"), GetResult("closed"), TEXT("closed"));
+    lua_pop(L, 1);
+
+    return true;
+}
+
+#endif
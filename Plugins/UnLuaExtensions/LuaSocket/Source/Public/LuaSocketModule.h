@@ -16,6 +16,7 @@
 
 #include "CoreMinimal.h"
 #include "LuaEnv.h"
+#include "Containers/Ticker.h"
 #include "Modules/ModuleInterface.h"
 
 class LUASOCKET_API FLuaSocketModule : public IModuleInterface
@@ -25,4 +26,9 @@ class LUASOCKET_API FLuaSocketModule : public IModuleInterface
     virtual void ShutdownModule() override;
 
     static void OnLuaEnvCreated(UnLua::FLuaEnv& Env);
+
+    /** Polls the socket reactor of every lua env once per frame, resuming coroutines parked in socket.wait */
+    static bool Tick(float DeltaTime);
+
+    FTSTicker::FDelegateHandle TickHandle;
 };
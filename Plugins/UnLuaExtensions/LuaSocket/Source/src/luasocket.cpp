@@ -21,6 +21,7 @@
 #include "tcp.h"
 #include "udp.h"
 #include "select.h"
+#include "reactor.h"
 
 /*-------------------------------------------------------------------------*\
 * Internal function prototypes
@@ -41,6 +42,7 @@ static const luaL_Reg mod[] = {
     {"tcp", tcp_open},
     {"udp", udp_open},
     {"select", select_open},
+    {"reactor", reactor_open},
     {NULL, NULL}
 };
 
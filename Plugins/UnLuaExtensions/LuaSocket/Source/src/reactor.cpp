@@ -0,0 +1,488 @@
+/*=========================================================================*\
+* Readiness reactor
+* LuaSocket toolkit
+*
+* Sockets are registered level-triggered and one-shot, so a readiness
+* event disarms the descriptor until the next wait re-arms it. Events carry
+* both the descriptor and the slot index, which lets stale events (from a
+* closed and reused descriptor, or a waiter that already timed out) be
+* recognised and dropped.
+*
+* Closing a socket drops its registration before the descriptor is freed
+* and detaches its slot, so a new socket that reuses the descriptor always
+* starts from a fresh slot. Coroutines parked on the closed socket are
+* resumed with "closed" on the next tick.
+\*=========================================================================*/
+#include "luasocket.h"
+
+#include "socket.h"
+#include "timeout.h"
+#include "reactor.h"
+
+#include <string.h>
+
+#if defined(__linux__)
+#define REACTOR_EPOLL
+#include <sys/epoll.h>
+#define REACTOR_IN      EPOLLIN
+#define REACTOR_OUT     EPOLLOUT
+#define REACTOR_ERR     (EPOLLERR|EPOLLHUP)
+#define REACTOR_BACKEND "epoll"
+#else
+#ifdef _WIN32
+typedef WSAPOLLFD t_pollfd;
+#define reactor_poll    WSAPoll
+#else
+#include <poll.h>
+typedef struct pollfd t_pollfd;
+#define reactor_poll    poll
+#endif
+#define REACTOR_IN      POLLIN
+#define REACTOR_OUT     POLLOUT
+#define REACTOR_ERR     (POLLERR|POLLHUP|POLLNVAL)
+#define REACTOR_BACKEND "poll"
+#endif
+
+#define REACTOR_KEY         "socket.reactor"
+#define REACTOR_META        "socket{reactor}"
+#define REACTOR_MAXEVENTS   256
+
+#define WAIT_R 0
+#define WAIT_W 1
+
+/* coroutine parked on one direction of a socket */
+typedef struct t_waiter_ {
+    lua_State *co;      /* parked coroutine, NULL if none */
+    int ref;            /* registry reference keeping the coroutine alive */
+    double deadline;    /* absolute time to give up, < 0 to wait forever */
+} t_waiter;
+
+/* per socket state, one slot per descriptor being waited on */
+typedef struct t_slot_ {
+    t_socket fd;        /* SOCKET_INVALID if the slot is free */
+    t_waiter wait[2];   /* read and write waiters */
+    int armed;          /* events currently armed in the kernel */
+    int ready;          /* events reported by the last poll */
+    int closed;         /* socket closed while waiters were parked on it */
+    int next;           /* next free slot, if this one is free */
+} t_slot;
+
+typedef struct t_reactor_ {
+#ifdef REACTOR_EPOLL
+    int epfd;           /* epoll instance shared by all sockets */
+#else
+    t_pollfd *pfds;     /* poll set rebuilt on every tick */
+    int *pslots;        /* slot index of every poll set entry */
+#endif
+    t_slot *slots;
+    int nslots;         /* slots handed out so far, including free ones */
+    int maxslots;       /* allocated slots */
+    int freeslot;       /* head of the free slot list, -1 if empty */
+    int nwaiting;       /* parked coroutines */
+    int fds;            /* registry reference to the fd -> slot table */
+} t_reactor;
+
+/*=========================================================================*\
+* Internal function prototypes
+\*=========================================================================*/
+static int global_wait(lua_State *L);
+static int global_waiting(lua_State *L);
+static int reactor_gc(lua_State *L);
+static t_reactor *getreactor(lua_State *L);
+static t_socket checkfd(lua_State *L, int idx);
+static void *reactor_realloc(lua_State *L, void *ptr, size_t osize, size_t nsize);
+static int findslot(lua_State *L, t_reactor *r, t_socket fd);
+static int lookupslot(lua_State *L, t_reactor *r, t_socket fd);
+static void releaseslot(lua_State *L, t_reactor *r, int index);
+static void freeslot(t_reactor *r, int index);
+static int rearm(t_reactor *r, int index);
+static void wake(lua_State *L, t_reactor *r, int index, int dir,
+        const char *err, p_reactor_error error);
+
+/* functions in library namespace */
+static luaL_Reg func[] = {
+    {"wait",    global_wait},
+    {"waiting", global_waiting},
+    {NULL,      NULL}
+};
+
+/*-------------------------------------------------------------------------*\
+* Initializes module
+\*-------------------------------------------------------------------------*/
+int reactor_open(lua_State *L) {
+    if (!getreactor(L)) {
+        t_reactor *r = (t_reactor *) lua_newuserdatauv(L, sizeof(t_reactor), 0);
+        memset(r, 0, sizeof(t_reactor));
+#ifdef REACTOR_EPOLL
+        r->epfd = epoll_create1(EPOLL_CLOEXEC);
+#endif
+        r->freeslot = -1;
+        lua_newtable(L);
+        r->fds = luaL_ref(L, LUA_REGISTRYINDEX);
+        luaL_newmetatable(L, REACTOR_META);
+        lua_pushcfunction(L, reactor_gc);
+        lua_setfield(L, -2, "__gc");
+        lua_setmetatable(L, -2);
+        lua_setfield(L, LUA_REGISTRYINDEX, REACTOR_KEY);
+    }
+    lua_pushstring(L, "_REACTOR");
+    lua_pushstring(L, REACTOR_BACKEND);
+    lua_rawset(L, -3);
+    luaL_setfuncs(L, func, 0);
+    return 0;
+}
+
+/*=========================================================================*\
+* Host functions
+\*=========================================================================*/
+/*-------------------------------------------------------------------------*\
+* Polls every parked socket with a single non-blocking call, then resumes
+* the coroutines that became ready or timed out
+\*-------------------------------------------------------------------------*/
+int reactor_tick(lua_State *L, p_reactor_error error) {
+    t_reactor *r = getreactor(L);
+    int i, n, nslots, resumed = 0;
+    double now;
+    if (!r || r->nwaiting == 0) return 0;
+#ifdef REACTOR_EPOLL
+    {
+        struct epoll_event events[REACTOR_MAXEVENTS];
+        if (r->epfd < 0) return 0;
+        do n = epoll_wait(r->epfd, events, REACTOR_MAXEVENTS, 0);
+        while (n < 0 && errno == EINTR);
+        for (i = 0; i < n; i++) {
+            int index = (int) (events[i].data.u64 & 0xffffffffu);
+            t_socket fd = (t_socket) (events[i].data.u64 >> 32);
+            /* drop events of descriptors that changed slot since armed */
+            if (index >= r->nslots || r->slots[index].fd != fd ||
+                    r->slots[index].closed) continue;
+            r->slots[index].armed = 0;
+            r->slots[index].ready |= (int) events[i].events;
+        }
+    }
+#else
+    {
+        int count = 0;
+        for (i = 0; i < r->nslots; i++) {
+            t_slot *slot = &r->slots[i];
+            int events = (slot->wait[WAIT_R].co? REACTOR_IN: 0) |
+                (slot->wait[WAIT_W].co? REACTOR_OUT: 0);
+            if (slot->fd == SOCKET_INVALID || slot->closed || !events)
+                continue;
+            r->pfds[count].fd = slot->fd;
+            r->pfds[count].events = (short) events;
+            r->pfds[count].revents = 0;
+            r->pslots[count++] = i;
+        }
+        do n = reactor_poll(r->pfds, count, 0);
+        while (n < 0 && errno == EINTR);
+        for (i = 0; n > 0 && i < count; i++) {
+            if (r->pfds[i].revents)
+                r->slots[r->pslots[i]].ready |= r->pfds[i].revents;
+        }
+    }
+#endif
+    /* resumed coroutines may park again and grow the slot array, so only
+     * visit the slots that existed before and always index, never cache */
+    now = timeout_gettime();
+    nslots = r->nslots;
+    for (i = 0; i < nslots; i++) {
+        int dir;
+        if (r->slots[i].fd == SOCKET_INVALID) continue;
+        for (dir = WAIT_R; dir <= WAIT_W; dir++) {
+            t_waiter *w = &r->slots[i].wait[dir];
+            int want = dir == WAIT_R? REACTOR_IN: REACTOR_OUT;
+            if (!w->co) continue;
+            if (r->slots[i].closed) {
+                wake(L, r, i, dir, "closed", error);
+                resumed++;
+            } else if (r->slots[i].ready & (want|REACTOR_ERR)) {
+                r->slots[i].ready &= ~want;
+                wake(L, r, i, dir, NULL, error);
+                resumed++;
+            } else if (w->deadline >= 0 && now >= w->deadline) {
+                /* the registration is still armed for this direction, so
+                 * forget what the kernel has and re-register next time */
+                r->slots[i].armed = 0;
+                wake(L, r, i, dir, "timeout", error);
+                resumed++;
+            }
+        }
+        if (r->slots[i].fd == SOCKET_INVALID) continue;
+        r->slots[i].ready = 0;
+        if (r->slots[i].closed) {
+            /* a waiter that parked again before the close is woken on the
+             * next tick */
+            if (!r->slots[i].wait[WAIT_R].co && !r->slots[i].wait[WAIT_W].co)
+                freeslot(r, i);
+        } else if (!r->slots[i].wait[WAIT_R].co && !r->slots[i].wait[WAIT_W].co)
+            releaseslot(L, r, i);
+        else
+            rearm(r, i);
+    }
+    return resumed;
+}
+
+/*-------------------------------------------------------------------------*\
+* Called by socket objects right before their descriptor is closed
+\*-------------------------------------------------------------------------*/
+void reactor_close(lua_State *L, t_socket fd) {
+    t_reactor *r = getreactor(L);
+    int index;
+    if (!r || fd == SOCKET_INVALID || !r->slots) return;
+    if ((index = lookupslot(L, r, fd)) < 0) return;
+#ifdef REACTOR_EPOLL
+    /* the kernel only forgets the registration once every duplicate of the
+     * descriptor is closed, so drop it explicitly */
+    if (r->epfd >= 0) {
+        struct epoll_event ev;
+        memset(&ev, 0, sizeof(ev));
+        epoll_ctl(r->epfd, EPOLL_CTL_DEL, fd, &ev);
+    }
+#endif
+    /* detach the slot from the descriptor, which may be reused right away,
+     * and leave its waiters for the next tick to resume */
+    lua_rawgeti(L, LUA_REGISTRYINDEX, r->fds);
+    lua_pushnil(L);
+    lua_rawseti(L, -2, (lua_Integer) fd);
+    lua_pop(L, 1);
+    r->slots[index].armed = 0;
+    r->slots[index].closed = 1;
+}
+
+int reactor_waiting(lua_State *L) {
+    t_reactor *r = getreactor(L);
+    return r? r->nwaiting: 0;
+}
+
+/*=========================================================================*\
+* Global Lua functions
+\*=========================================================================*/
+/*-------------------------------------------------------------------------*\
+* Parks the running coroutine until the socket is ready for reading ("r")
+* or writing ("w"). Returns true when ready, nil and "timeout" or "closed"
+* otherwise.
+\*-------------------------------------------------------------------------*/
+static int global_wait(lua_State *L) {
+    t_reactor *r = getreactor(L);
+    t_socket fd = checkfd(L, 1);
+    const char *mode = luaL_optstring(L, 2, "r");
+    double t = luaL_optnumber(L, 3, -1);
+    int dir = mode[0] == 'w'? WAIT_W: WAIT_R;
+    int index, err;
+    t_waiter *w;
+    if (!lua_isyieldable(L))
+        return luaL_error(L, "socket.wait must be called from a coroutine");
+    if (fd == SOCKET_INVALID) {
+        lua_pushnil(L);
+        lua_pushstring(L, "closed");
+        return 2;
+    }
+#ifdef REACTOR_EPOLL
+    if (r->epfd < 0) {
+        lua_pushnil(L);
+        lua_pushstring(L, "reactor unavailable");
+        return 2;
+    }
+#endif
+    index = findslot(L, r, fd);
+    w = &r->slots[index].wait[dir];
+    if (w->co) {
+        lua_pushnil(L);
+        lua_pushstring(L, "busy");
+        return 2;
+    }
+    w->co = L;
+    if ((err = rearm(r, index)) != 0) {
+        w->co = NULL;
+        if (!r->slots[index].wait[!dir].co) releaseslot(L, r, index);
+        lua_pushnil(L);
+        lua_pushstring(L, socket_strerror(err));
+        return 2;
+    }
+    lua_pushthread(L);
+    w->ref = luaL_ref(L, LUA_REGISTRYINDEX);
+    w->deadline = t >= 0.0? timeout_gettime() + t: -1.0;
+    r->nwaiting++;
+    return lua_yield(L, 0);
+}
+
+/*-------------------------------------------------------------------------*\
+* Returns the number of parked coroutines
+\*-------------------------------------------------------------------------*/
+static int global_waiting(lua_State *L) {
+    lua_pushinteger(L, reactor_waiting(L));
+    return 1;
+}
+
+/*-------------------------------------------------------------------------*\
+* Releases the kernel resources when the owning state is closed
+\*-------------------------------------------------------------------------*/
+static int reactor_gc(lua_State *L) {
+    t_reactor *r = (t_reactor *) luaL_checkudata(L, 1, REACTOR_META);
+#ifdef REACTOR_EPOLL
+    if (r->epfd >= 0) close(r->epfd);
+    r->epfd = -1;
+#else
+    reactor_realloc(L, r->pfds, r->maxslots*sizeof(t_pollfd), 0);
+    reactor_realloc(L, r->pslots, r->maxslots*sizeof(int), 0);
+    r->pfds = NULL;
+    r->pslots = NULL;
+#endif
+    reactor_realloc(L, r->slots, r->maxslots*sizeof(t_slot), 0);
+    r->slots = NULL;
+    r->nslots = r->maxslots = r->nwaiting = 0;
+    return 0;
+}
+
+/*=========================================================================*\
+* Internal functions
+\*=========================================================================*/
+static t_reactor *getreactor(lua_State *L) {
+    t_reactor *r;
+    lua_getfield(L, LUA_REGISTRYINDEX, REACTOR_KEY);
+    r = (t_reactor *) lua_touserdata(L, -1);
+    lua_pop(L, 1);
+    return r;
+}
+
+/* accepts a raw descriptor or any object exporting getfd(), like select */
+static t_socket checkfd(lua_State *L, int idx) {
+    t_socket fd = SOCKET_INVALID;
+    if (lua_isnumber(L, idx)) {
+        double numfd = lua_tonumber(L, idx);
+        return (numfd >= 0.0)? (t_socket) numfd: SOCKET_INVALID;
+    }
+    luaL_checkany(L, idx);
+    lua_getfield(L, idx, "getfd");
+    if (!lua_isnil(L, -1)) {
+        lua_pushvalue(L, idx);
+        lua_call(L, 1, 1);
+        if (lua_isnumber(L, -1)) {
+            double numfd = lua_tonumber(L, -1);
+            fd = (numfd >= 0.0)? (t_socket) numfd: SOCKET_INVALID;
+        }
+    }
+    lua_pop(L, 1);
+    return fd;
+}
+
+/* slots live outside the Lua heap objects but are accounted to it */
+static void *reactor_realloc(lua_State *L, void *ptr, size_t osize, size_t nsize) {
+    void *ud;
+    lua_Alloc allocf = lua_getallocf(L, &ud);
+    if (!ptr && nsize == 0) return NULL;
+    return allocf(ud, ptr, osize, nsize);
+}
+
+/* returns the slot of the descriptor, -1 if it has none */
+static int lookupslot(lua_State *L, t_reactor *r, t_socket fd) {
+    int index = -1;
+    lua_rawgeti(L, LUA_REGISTRYINDEX, r->fds);
+    lua_rawgeti(L, -1, (lua_Integer) fd);
+    if (lua_isinteger(L, -1)) index = (int) lua_tointeger(L, -1);
+    lua_pop(L, 2);
+    return (index >= 0 && index < r->nslots)? index: -1;
+}
+
+/* returns the slot of the descriptor, creating it if needed */
+static int findslot(lua_State *L, t_reactor *r, t_socket fd) {
+    int index = lookupslot(L, r, fd);
+    if (index >= 0) return index;
+    lua_rawgeti(L, LUA_REGISTRYINDEX, r->fds);
+    if (r->freeslot >= 0) {
+        index = r->freeslot;
+        r->freeslot = r->slots[index].next;
+    } else {
+        if (r->nslots == r->maxslots) {
+            int grow = r->maxslots? r->maxslots*2: 16;
+            void *slots = reactor_realloc(L, r->slots,
+                r->maxslots*sizeof(t_slot), grow*sizeof(t_slot));
+#ifndef REACTOR_EPOLL
+            void *pfds = reactor_realloc(L, r->pfds,
+                r->maxslots*sizeof(t_pollfd), grow*sizeof(t_pollfd));
+            void *pslots = reactor_realloc(L, r->pslots,
+                r->maxslots*sizeof(int), grow*sizeof(int));
+            if (pfds) r->pfds = (t_pollfd *) pfds;
+            if (pslots) r->pslots = (int *) pslots;
+            if (!pfds || !pslots) slots = NULL;
+#endif
+            if (!slots) luaL_error(L, "not enough memory for socket reactor");
+            r->slots = (t_slot *) slots;
+            r->maxslots = grow;
+        }
+        index = r->nslots++;
+    }
+    memset(&r->slots[index], 0, sizeof(t_slot));
+    r->slots[index].fd = fd;
+    r->slots[index].next = -1;
+    lua_pushinteger(L, index);
+    lua_rawseti(L, -2, (lua_Integer) fd);
+    lua_pop(L, 1);
+    return index;
+}
+
+static void releaseslot(lua_State *L, t_reactor *r, int index) {
+    t_slot *slot = &r->slots[index];
+    lua_rawgeti(L, LUA_REGISTRYINDEX, r->fds);
+    lua_pushnil(L);
+    lua_rawseti(L, -2, (lua_Integer) slot->fd);
+    lua_pop(L, 1);
+    /* a still armed one-shot registration is harmless: its event will not
+     * match the slot anymore and is dropped */
+    freeslot(r, index);
+}
+
+/* puts a slot that no descriptor maps to anymore on the free list */
+static void freeslot(t_reactor *r, int index) {
+    t_slot *slot = &r->slots[index];
+    slot->fd = SOCKET_INVALID;
+    slot->armed = 0;
+    slot->closed = 0;
+    slot->next = r->freeslot;
+    r->freeslot = index;
+}
+
+/* makes the kernel watch exactly the directions that have waiters */
+static int rearm(t_reactor *r, int index) {
+    t_slot *slot = &r->slots[index];
+    int events = (slot->wait[WAIT_R].co? REACTOR_IN: 0) |
+        (slot->wait[WAIT_W].co? REACTOR_OUT: 0);
+#ifdef REACTOR_EPOLL
+    struct epoll_event ev;
+    if (!events || events == slot->armed) return 0;
+    ev.events = (unsigned int) events | EPOLLONESHOT;
+    ev.data.u64 = ((unsigned long long) (unsigned int) slot->fd << 32) |
+        (unsigned int) index;
+    /* descriptors stay registered (disarmed) after firing, but the kernel
+     * forgets them once closed, so fall back to adding */
+    if (epoll_ctl(r->epfd, EPOLL_CTL_MOD, slot->fd, &ev) != 0) {
+        if (errno != ENOENT) return errno;
+        if (epoll_ctl(r->epfd, EPOLL_CTL_ADD, slot->fd, &ev) != 0) return errno;
+    }
+#endif
+    slot->armed = events;
+    return 0;
+}
+
+/* detaches the waiter and resumes it with true, or nil and the error */
+static void wake(lua_State *L, t_reactor *r, int index, int dir,
+        const char *err, p_reactor_error error) {
+    t_waiter w = r->slots[index].wait[dir];
+    int nres = 0, status;
+    r->slots[index].wait[dir].co = NULL;
+    r->nwaiting--;
+    if (lua_status(w.co) == LUA_YIELD) {
+        int nargs = 1;
+        if (!err) lua_pushboolean(w.co, 1);
+        else {
+            lua_pushnil(w.co);
+            lua_pushstring(w.co, err);
+            nargs = 2;
+        }
+        status = lua_resume(w.co, L, nargs, &nres);
+        if (status == LUA_OK || status == LUA_YIELD) lua_pop(w.co, nres);
+        else if (error) error(w.co, lua_tostring(w.co, -1));
+    }
+    luaL_unref(L, LUA_REGISTRYINDEX, w.ref);
+}
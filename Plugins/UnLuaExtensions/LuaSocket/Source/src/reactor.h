@@ -0,0 +1,49 @@
+#ifndef REACTOR_H
+#define REACTOR_H
+/*=========================================================================*\
+* Readiness reactor
+* LuaSocket toolkit
+*
+* Lets coroutines park on socket readiness instead of blocking inside
+* socket_waitfd or spinning with zero timeouts. Every socket waited on in
+* a Lua state is multiplexed in a single epoll set (a single poll set on
+* platforms without epoll), owned by that state's registry. The host polls
+* it once per frame with reactor_tick, which resumes the coroutines whose
+* sockets became ready or whose wait timed out.
+\*=========================================================================*/
+#include "luasocket.h"
+
+/* called for every coroutine that raised an error when resumed */
+typedef void (*p_reactor_error) (
+    lua_State *co,      /* coroutine that failed, error message on top */
+    const char *msg     /* error message */
+);
+
+#ifndef _WIN32
+#pragma GCC visibility push(hidden)
+#endif
+
+int reactor_open(lua_State *L);
+
+/* must be called by socket objects before they close their descriptor, only
+ * declared after socket.h so host code doesn't see the platform headers */
+#ifdef SOCKET_H
+void reactor_close(lua_State *L, t_socket fd);
+#endif
+
+#ifndef _WIN32
+#pragma GCC visibility pop
+#endif
+
+/*-------------------------------------------------------------------------*\
+* Polls the reactor of the given main state without blocking and resumes
+* the ready coroutines. Returns the number of coroutines resumed.
+\*-------------------------------------------------------------------------*/
+LUASOCKET_API int reactor_tick(lua_State *L, p_reactor_error error);
+
+/*-------------------------------------------------------------------------*\
+* Number of coroutines currently parked in the reactor of the given state.
+\*-------------------------------------------------------------------------*/
+LUASOCKET_API int reactor_waiting(lua_State *L);
+
+#endif /* REACTOR_H */
@@ -9,6 +9,7 @@
 #include "inet.h"
 #include "options.h"
 #include "tcp.h"
+#include "reactor.h"
 
 #include <string.h>
 
@@ -292,6 +293,7 @@ static int meth_connect(lua_State *L) {
 static int meth_close(lua_State *L)
 {
     p_tcp tcp = (p_tcp) auxiliar_checkgroup(L, "tcp{any}", 1);
+    reactor_close(L, tcp->sock);
     socket_destroy(&tcp->sock);
     lua_pushnumber(L, 1);
     return 1;
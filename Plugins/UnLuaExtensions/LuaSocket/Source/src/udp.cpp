@@ -9,6 +9,7 @@
 #include "inet.h"
 #include "options.h"
 #include "udp.h"
+#include "reactor.h"
 
 #include <string.h>
 #include <stdlib.h>
@@ -423,6 +424,7 @@ static int meth_setpeername(lua_State *L) {
 \*-------------------------------------------------------------------------*/
 static int meth_close(lua_State *L) {
     p_udp udp = (p_udp) auxiliar_checkgroup(L, "udp{any}", 1);
+    reactor_close(L, udp->sock);
     socket_destroy(&udp->sock);
     lua_pushnumber(L, 1);
     return 1;
@@ -10,6 +10,7 @@
 #include "socket.h"
 #include "options.h"
 #include "unix.h"
+#include "reactor.h"
 
 #include <string.h>
 #include <stdlib.h>
@@ -355,6 +356,7 @@ static int meth_connect(lua_State *L)
 static int meth_close(lua_State *L)
 {
     p_unix un = (p_unix) auxiliar_checkgroup(L, "unixdgram{any}", 1);
+    reactor_close(L, un->sock);
     socket_destroy(&un->sock);
     lua_pushnumber(L, 1);
     return 1;
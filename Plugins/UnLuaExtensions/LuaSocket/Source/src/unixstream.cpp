@@ -9,6 +9,7 @@
 #include "socket.h"
 #include "options.h"
 #include "unixstream.h"
+#include "reactor.h"
 
 #include <string.h>
 #include <sys/un.h>
@@ -279,6 +280,7 @@ static int meth_connect(lua_State *L)
 static int meth_close(lua_State *L)
 {
     p_unix un = (p_unix) auxiliar_checkgroup(L, "unixstream{any}", 1);
+    reactor_close(L, un->sock);
     socket_destroy(&un->sock);
     lua_pushnumber(L, 1);
     return 1;
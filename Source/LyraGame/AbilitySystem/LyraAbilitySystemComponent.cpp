@@ -171,17 +171,69 @@ void ULyraAbilitySystemComponent::AbilitySpecInputReleased(FGameplayAbilitySpec&
 	}
 }
 
+void ULyraAbilitySystemComponent::OnGiveAbility(FGameplayAbilitySpec& AbilitySpec)
+{
+	Super::OnGiveAbility(AbilitySpec);
+
+	for (const FGameplayTag& DynamicTag : AbilitySpec.DynamicAbilityTags)
+	{
+		InputTagToSpecHandles.AddUnique(DynamicTag, AbilitySpec.Handle);
+	}
+
+	bSpecHandleToIndexStale = true;
+}
+
+void ULyraAbilitySystemComponent::OnRemoveAbility(FGameplayAbilitySpec& AbilitySpec)
+{
+	// Remove by handle rather than by the spec's current tags, in case they were changed after the ability was given
+	for (auto It = InputTagToSpecHandles.CreateIterator(); It; ++It)
+	{
+		if (It.Value() == AbilitySpec.Handle)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	bSpecHandleToIndexStale = true;
+
+	Super::OnRemoveAbility(AbilitySpec);
+}
+
+FGameplayAbilitySpec* ULyraAbilitySystemComponent::FindInputAbilitySpec(FGameplayAbilitySpecHandle Handle)
+{
+	if (bSpecHandleToIndexStale)
+	{
+		SpecHandleToIndex.Reset();
+		for (int32 Index = 0; Index < ActivatableAbilities.Items.Num(); ++Index)
+		{
+			SpecHandleToIndex.Add(ActivatableAbilities.Items[Index].Handle, Index);
+		}
+		bSpecHandleToIndexStale = false;
+	}
+
+	if (const int32* IndexPtr = SpecHandleToIndex.Find(Handle))
+	{
+		if (ActivatableAbilities.Items.IsValidIndex(*IndexPtr) && (ActivatableAbilities.Items[*IndexPtr].Handle == Handle))
+		{
+			return &ActivatableAbilities.Items[*IndexPtr];
+		}
+
+		// The list changed without going through OnGiveAbility/OnRemoveAbility, fall back and rebuild next time
+		bSpecHandleToIndexStale = true;
+		return FindAbilitySpecFromHandle(Handle);
+	}
+
+	return nullptr;
+}
+
 void ULyraAbilitySystemComponent::AbilityInputTagPressed(const FGameplayTag& InputTag)
 {
 	if (InputTag.IsValid())
 	{
-		for (const FGameplayAbilitySpec& AbilitySpec : ActivatableAbilities.Items)
+		for (auto It = InputTagToSpecHandles.CreateConstKeyIterator(InputTag); It; ++It)
 		{
-			if (AbilitySpec.Ability && (AbilitySpec.DynamicAbilityTags.HasTagExact(InputTag)))
-			{
-				InputPressedSpecHandles.AddUnique(AbilitySpec.Handle);
-				InputHeldSpecHandles.AddUnique(AbilitySpec.Handle);
-			}
+			InputPressedSpecHandles.AddUnique(It.Value());
+			InputHeldSpecHandles.AddUnique(It.Value());
 		}
 	}
 }
@@ -190,13 +242,10 @@ void ULyraAbilitySystemComponent::AbilityInputTagReleased(const FGameplayTag& In
 {
 	if (InputTag.IsValid())
 	{
-		for (const FGameplayAbilitySpec& AbilitySpec : ActivatableAbilities.Items)
+		for (auto It = InputTagToSpecHandles.CreateConstKeyIterator(InputTag); It; ++It)
 		{
-			if (AbilitySpec.Ability && (AbilitySpec.DynamicAbilityTags.HasTagExact(InputTag)))
-			{
-				InputReleasedSpecHandles.AddUnique(AbilitySpec.Handle);
-				InputHeldSpecHandles.Remove(AbilitySpec.Handle);
-			}
+			InputReleasedSpecHandles.AddUnique(It.Value());
+			InputHeldSpecHandles.Remove(It.Value());
 		}
 	}
 }
@@ -209,8 +258,7 @@ void ULyraAbilitySystemComponent::ProcessAbilityInput(float DeltaTime, bool bGam
 		return;
 	}
 
-	static TArray<FGameplayAbilitySpecHandle> AbilitiesToActivate;
-	AbilitiesToActivate.Reset();
+	TArray<FGameplayAbilitySpecHandle, TInlineAllocator<8>> AbilitiesToActivate;
 
 	//@TODO: See if we can use FScopedServerAbilityRPCBatcher ScopedRPCBatcher in some of these loops
 
@@ -219,7 +267,7 @@ void ULyraAbilitySystemComponent::ProcessAbilityInput(float DeltaTime, bool bGam
 	//
 	for (const FGameplayAbilitySpecHandle& SpecHandle : InputHeldSpecHandles)
 	{
-		if (const FGameplayAbilitySpec* AbilitySpec = FindAbilitySpecFromHandle(SpecHandle))
+		if (const FGameplayAbilitySpec* AbilitySpec = FindInputAbilitySpec(SpecHandle))
 		{
 			if (AbilitySpec->Ability && !AbilitySpec->IsActive())
 			{
@@ -238,7 +286,7 @@ void ULyraAbilitySystemComponent::ProcessAbilityInput(float DeltaTime, bool bGam
 	//
 	for (const FGameplayAbilitySpecHandle& SpecHandle : InputPressedSpecHandles)
 	{
-		if (FGameplayAbilitySpec* AbilitySpec = FindAbilitySpecFromHandle(SpecHandle))
+		if (FGameplayAbilitySpec* AbilitySpec = FindInputAbilitySpec(SpecHandle))
 		{
 			if (AbilitySpec->Ability)
 			{
@@ -277,7 +325,7 @@ void ULyraAbilitySystemComponent::ProcessAbilityInput(float DeltaTime, bool bGam
 	//
 	for (const FGameplayAbilitySpecHandle& SpecHandle : InputReleasedSpecHandles)
 	{
-		if (FGameplayAbilitySpec* AbilitySpec = FindAbilitySpecFromHandle(SpecHandle))
+		if (FGameplayAbilitySpec* AbilitySpec = FindInputAbilitySpec(SpecHandle))
 		{
 			if (AbilitySpec->Ability)
 			{
@@ -71,6 +71,9 @@ protected:
 
 	void TryActivateAbilitiesOnSpawn();
 
+	virtual void OnGiveAbility(FGameplayAbilitySpec& AbilitySpec) override;
+	virtual void OnRemoveAbility(FGameplayAbilitySpec& AbilitySpec) override;
+
 	virtual void AbilitySpecInputPressed(FGameplayAbilitySpec& Spec) override;
 	virtual void AbilitySpecInputReleased(FGameplayAbilitySpec& Spec) override;
 
@@ -85,6 +88,9 @@ protected:
 	void ClientNotifyAbilityFailed(const UGameplayAbility* Ability, const FGameplayTagContainer& FailureReason);
 
 	void HandleAbilityFailed(const UGameplayAbility* Ability, const FGameplayTagContainer& FailureReason);
+
+	// Finds a spec through SpecHandleToIndex, rebuilding it if abilities were added or removed since it was built.
+	FGameplayAbilitySpec* FindInputAbilitySpec(FGameplayAbilitySpecHandle Handle);
 protected:
 
 	// If set, this table is used to look up tag relationships for activate and cancel
@@ -92,13 +98,20 @@ protected:
 	ULyraAbilityTagRelationshipMapping* TagRelationshipMapping;
 
 	// Handles to abilities that had their input pressed this frame.
-	TArray<FGameplayAbilitySpecHandle> InputPressedSpecHandles;
+	TArray<FGameplayAbilitySpecHandle, TInlineAllocator<8>> InputPressedSpecHandles;
 
 	// Handles to abilities that had their input released this frame.
-	TArray<FGameplayAbilitySpecHandle> InputReleasedSpecHandles;
+	TArray<FGameplayAbilitySpecHandle, TInlineAllocator<8>> InputReleasedSpecHandles;
 
 	// Handles to abilities that have their input held.
-	TArray<FGameplayAbilitySpecHandle> InputHeldSpecHandles;
+	TArray<FGameplayAbilitySpecHandle, TInlineAllocator<8>> InputHeldSpecHandles;
+
+	// Dynamic ability tags (which hold the input tag) of every granted ability, maintained in OnGiveAbility/OnRemoveAbility.
+	TMultiMap<FGameplayTag, FGameplayAbilitySpecHandle> InputTagToSpecHandles;
+
+	// Index of each granted ability in ActivatableAbilities.Items, rebuilt lazily after abilities are added or removed.
+	TMap<FGameplayAbilitySpecHandle, int32> SpecHandleToIndex;
+	bool bSpecHandleToIndexStale = true;
 
 	// Number of abilities running in each activation group.
 	int32 ActivationGroupCounts[(uint8)ELyraAbilityActivationGroup::MAX];
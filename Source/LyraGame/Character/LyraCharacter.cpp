@@ -14,6 +14,7 @@
 #include "Player/LyraPlayerController.h"
 #include "Player/LyraPlayerState.h"
 #include "System/LyraSignificanceManager.h"
+#include "Weapons/LyraLagCompensationSubsystem.h"
 #include "Net/UnrealNetwork.h"
 #include "TimerManager.h"
 
@@ -89,7 +90,15 @@ void ALyraCharacter::BeginPlay()
 	{
 		if (ULyraSignificanceManager* SignificanceManager = USignificanceManager::Get<ULyraSignificanceManager>(World))
 		{
-//@TODO: SignificanceManager->RegisterObject(this, (EFortSignificanceType)SignificanceType);
+			SignificanceManager->RegisterWithProvider(this, ULyraSignificanceManager::CharacterTag);
+		}
+	}
+
+	if (HasAuthority())
+	{
+		if (ULyraLagCompensationSubsystem* LagCompensation = World->GetSubsystem<ULyraLagCompensationSubsystem>())
+		{
+			LagCompensation->RegisterPawn(this);
 		}
 	}
 }
@@ -108,6 +117,11 @@ void ALyraCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
 			SignificanceManager->UnregisterObject(this);
 		}
 	}
+
+	if (ULyraLagCompensationSubsystem* LagCompensation = World->GetSubsystem<ULyraLagCompensationSubsystem>())
+	{
+		LagCompensation->UnregisterPawn(this);
+	}
 }
 
 void ALyraCharacter::Reset()
@@ -189,12 +203,18 @@ void ALyraCharacter::OnAbilitySystemInitialized()
 
 	HealthComponent->InitializeWithAbilitySystem(LyraASC);
 
+	ULyraCharacterMovementComponent* LyraMoveComp = CastChecked<ULyraCharacterMovementComponent>(GetCharacterMovement());
+	LyraMoveComp->InitializeWithAbilitySystem(LyraASC);
+
 	InitializeGameplayTags();
 }
 
 void ALyraCharacter::OnAbilitySystemUninitialized()
 {
 	HealthComponent->UninitializeFromAbilitySystem();
+
+	ULyraCharacterMovementComponent* LyraMoveComp = CastChecked<ULyraCharacterMovementComponent>(GetCharacterMovement());
+	LyraMoveComp->UninitializeFromAbilitySystem();
 }
 
 void ALyraCharacter::PossessedBy(AController* NewController)
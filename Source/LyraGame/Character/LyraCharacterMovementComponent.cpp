@@ -4,9 +4,9 @@
 #include "GameFramework/Character.h"
 #include "CollisionQueryParams.h"
 #include "Components/CapsuleComponent.h"
-#include "AbilitySystemGlobals.h"
 #include "NativeGameplayTags.h"
 #include "AbilitySystemComponent.h"
+#include "LyraGroundProbeSubsystem.h"
 
 UE_DEFINE_GAMEPLAY_TAG(TAG_Gameplay_MovementStopped, "Gameplay.MovementStopped");
 
@@ -14,6 +14,9 @@ namespace LyraCharacter
 {
 	static float GroundTraceDistance = 100000.0f;
 	FAutoConsoleVariableRef CVar_GroundTraceDistance(TEXT("LyraCharacter.GroundTraceDistance"), GroundTraceDistance, TEXT("Distance to trace down when generating ground information."), ECVF_Cheat);
+
+	static bool bAsyncGroundProbes = true;
+	FAutoConsoleVariableRef CVar_AsyncGroundProbes(TEXT("LyraCharacter.AsyncGroundProbes"), bAsyncGroundProbes, TEXT("If set, airborne characters get their ground info from batched async traces instead of a synchronous trace each."), ECVF_Default);
 };
 
 
@@ -49,6 +52,92 @@ void ULyraCharacterMovementComponent::InitializeComponent()
 	Super::InitializeComponent();
 }
 
+void ULyraCharacterMovementComponent::OnUnregister()
+{
+	UninitializeFromAbilitySystem();
+
+	Super::OnUnregister();
+}
+
+void ULyraCharacterMovementComponent::InitializeWithAbilitySystem(UAbilitySystemComponent* InASC)
+{
+	UninitializeFromAbilitySystem();
+
+	if (!InASC)
+	{
+		return;
+	}
+
+	MovementTagASC = InASC;
+
+	auto RegisterTag = [this, InASC](const FGameplayTag& Tag)
+	{
+		if (Tag.IsValid() && !MovementTagEventHandles.ContainsByPredicate([&Tag](const TPair<FGameplayTag, FDelegateHandle>& Entry) { return Entry.Key == Tag; }))
+		{
+			const FDelegateHandle Handle = InASC->RegisterGameplayTagEvent(Tag, EGameplayTagEventType::NewOrRemoved).AddUObject(this, &ThisClass::OnMovementTagChanged);
+			MovementTagEventHandles.Emplace(Tag, Handle);
+		}
+	};
+
+	RegisterTag(TAG_Gameplay_MovementStopped);
+	for (const FLyraMovementTagModifier& Modifier : MovementTagModifiers)
+	{
+		RegisterTag(Modifier.Tag);
+	}
+
+	RefreshMovementTagModifiers();
+}
+
+void ULyraCharacterMovementComponent::UninitializeFromAbilitySystem()
+{
+	if (UAbilitySystemComponent* ASC = MovementTagASC.Get())
+	{
+		for (const TPair<FGameplayTag, FDelegateHandle>& Entry : MovementTagEventHandles)
+		{
+			ASC->UnregisterGameplayTagEvent(Entry.Value, Entry.Key, EGameplayTagEventType::NewOrRemoved);
+		}
+	}
+
+	MovementTagEventHandles.Reset();
+	MovementTagASC.Reset();
+
+	CachedMaxSpeedMultiplier = 1.0f;
+	bCachedRotationBlocked = false;
+}
+
+void ULyraCharacterMovementComponent::OnMovementTagChanged(const FGameplayTag Tag, int32 NewCount)
+{
+	RefreshMovementTagModifiers();
+}
+
+void ULyraCharacterMovementComponent::RefreshMovementTagModifiers()
+{
+	CachedMaxSpeedMultiplier = 1.0f;
+	bCachedRotationBlocked = false;
+
+	const UAbilitySystemComponent* ASC = MovementTagASC.Get();
+	if (!ASC)
+	{
+		return;
+	}
+
+	if (ASC->HasMatchingGameplayTag(TAG_Gameplay_MovementStopped))
+	{
+		CachedMaxSpeedMultiplier = 0.0f;
+		bCachedRotationBlocked = true;
+		return;
+	}
+
+	for (const FLyraMovementTagModifier& Modifier : MovementTagModifiers)
+	{
+		if (Modifier.Tag.IsValid() && ASC->HasMatchingGameplayTag(Modifier.Tag))
+		{
+			CachedMaxSpeedMultiplier *= Modifier.MaxSpeedMultiplier;
+			bCachedRotationBlocked |= Modifier.bBlocksRotation;
+		}
+	}
+}
+
 const FLyraCharacterGroundInfo& ULyraCharacterMovementComponent::GetGroundInfo()
 {
 	if (!CharacterOwner || (GFrameCounter == CachedGroundInfo.LastUpdateFrame))
@@ -60,35 +149,50 @@ const FLyraCharacterGroundInfo& ULyraCharacterMovementComponent::GetGroundInfo()
 	{
 		CachedGroundInfo.GroundHitResult = CurrentFloor.HitResult;
 		CachedGroundInfo.GroundDistance = 0.0f;
+		bHasGroundProbeResult = false;
 	}
-	else
+	else if (MovementMode == MOVE_NavWalking)
 	{
-		const UCapsuleComponent* CapsuleComp = CharacterOwner->GetCapsuleComponent();
-		check(CapsuleComp);
+		// Nav walking doesn't use the trace result for the distance, so there is no need to trace at all
+		CachedGroundInfo.GroundHitResult = FHitResult();
+		CachedGroundInfo.GroundDistance = 0.0f;
+	}
+	else if (ULyraGroundProbeSubsystem* GroundProbeSubsystem = (LyraCharacter::bAsyncGroundProbes ? GetWorld()->GetSubsystem<ULyraGroundProbeSubsystem>() : nullptr))
+	{
+		// Serve the previous batch's result and queue the next probe
+		GroundProbeSubsystem->RequestProbe(this);
 
-		const float CapsuleHalfHeight = CapsuleComp->GetUnscaledCapsuleHalfHeight();
-		const ECollisionChannel CollisionChannel = (UpdatedComponent ? UpdatedComponent->GetCollisionObjectType() : ECC_Pawn);
-		const FVector TraceStart(GetActorLocation());
-		const FVector TraceEnd(TraceStart.X, TraceStart.Y, (TraceStart.Z - LyraCharacter::GroundTraceDistance - CapsuleHalfHeight));
+		if (!bHasGroundProbeResult)
+		{
+			// Until the first probe comes back, estimate from the floor we were last standing on
+			const FHitResult& LastFloorHit = CachedGroundInfo.GroundHitResult;
+			if (LastFloorHit.bBlockingHit)
+			{
+				const UCapsuleComponent* CapsuleComp = CharacterOwner->GetCapsuleComponent();
+				check(CapsuleComp);
 
-		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(LyraCharacterMovementComponent_GetGroundInfo), false, CharacterOwner);
+				const float CapsuleBottomZ = GetActorLocation().Z - CapsuleComp->GetUnscaledCapsuleHalfHeight();
+				CachedGroundInfo.GroundDistance = FMath::Max((CapsuleBottomZ - LastFloorHit.ImpactPoint.Z), 0.0f);
+			}
+			else
+			{
+				CachedGroundInfo.GroundDistance = LyraCharacter::GroundTraceDistance;
+			}
+		}
+	}
+	else
+	{
+		FVector TraceStart;
+		FVector TraceEnd;
+		ECollisionChannel CollisionChannel;
+		FCollisionQueryParams QueryParams;
 		FCollisionResponseParams ResponseParam;
-		InitCollisionParams(QueryParams, ResponseParam);
+		GetGroundTraceParams(/*out*/ TraceStart, /*out*/ TraceEnd, /*out*/ CollisionChannel, /*out*/ QueryParams, /*out*/ ResponseParam);
 
 		FHitResult HitResult;
 		GetWorld()->LineTraceSingleByChannel(HitResult, TraceStart, TraceEnd, CollisionChannel, QueryParams, ResponseParam);
 
-		CachedGroundInfo.GroundHitResult = HitResult;
-		CachedGroundInfo.GroundDistance = LyraCharacter::GroundTraceDistance;
-
-		if (MovementMode == MOVE_NavWalking)
-		{
-			CachedGroundInfo.GroundDistance = 0.0f;
-		}
-		else if (HitResult.bBlockingHit)
-		{
-			CachedGroundInfo.GroundDistance = FMath::Max((HitResult.Distance - CapsuleHalfHeight), 0.0f);
-		}
+		UpdateGroundDistance(HitResult);
 	}
 
 	CachedGroundInfo.LastUpdateFrame = GFrameCounter;
@@ -96,6 +200,53 @@ const FLyraCharacterGroundInfo& ULyraCharacterMovementComponent::GetGroundInfo()
 	return CachedGroundInfo;
 }
 
+bool ULyraCharacterMovementComponent::GetGroundTraceParams(FVector& OutTraceStart, FVector& OutTraceEnd, ECollisionChannel& OutCollisionChannel, FCollisionQueryParams& OutQueryParams, FCollisionResponseParams& OutResponseParam) const
+{
+	if (!CharacterOwner)
+	{
+		return false;
+	}
+
+	const UCapsuleComponent* CapsuleComp = CharacterOwner->GetCapsuleComponent();
+	check(CapsuleComp);
+
+	const float CapsuleHalfHeight = CapsuleComp->GetUnscaledCapsuleHalfHeight();
+	OutCollisionChannel = (UpdatedComponent ? UpdatedComponent->GetCollisionObjectType() : ECC_Pawn);
+	OutTraceStart = GetActorLocation();
+	OutTraceEnd = FVector(OutTraceStart.X, OutTraceStart.Y, (OutTraceStart.Z - LyraCharacter::GroundTraceDistance - CapsuleHalfHeight));
+
+	OutQueryParams = FCollisionQueryParams(SCENE_QUERY_STAT(LyraCharacterMovementComponent_GetGroundInfo), false, CharacterOwner);
+	InitCollisionParams(OutQueryParams, OutResponseParam);
+
+	return true;
+}
+
+void ULyraCharacterMovementComponent::ApplyGroundProbeResult(const FHitResult& HitResult)
+{
+	// Landed while the probe was in flight, the floor is more accurate
+	if (!CharacterOwner || (MovementMode == MOVE_Walking) || (MovementMode == MOVE_NavWalking))
+	{
+		return;
+	}
+
+	UpdateGroundDistance(HitResult);
+	bHasGroundProbeResult = true;
+}
+
+void ULyraCharacterMovementComponent::UpdateGroundDistance(const FHitResult& HitResult)
+{
+	CachedGroundInfo.GroundHitResult = HitResult;
+	CachedGroundInfo.GroundDistance = LyraCharacter::GroundTraceDistance;
+
+	if (HitResult.bBlockingHit)
+	{
+		const UCapsuleComponent* CapsuleComp = CharacterOwner->GetCapsuleComponent();
+		check(CapsuleComp);
+
+		CachedGroundInfo.GroundDistance = FMath::Max((HitResult.Distance - CapsuleComp->GetUnscaledCapsuleHalfHeight()), 0.0f);
+	}
+}
+
 void ULyraCharacterMovementComponent::SetReplicatedAcceleration(const FVector& InAcceleration)
 {
 	bHasReplicatedAcceleration = true;
@@ -104,12 +255,9 @@ void ULyraCharacterMovementComponent::SetReplicatedAcceleration(const FVector& I
 
 FRotator ULyraCharacterMovementComponent::GetDeltaRotation(float DeltaTime) const
 {
-	if (UAbilitySystemComponent* ASC = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(GetOwner()))
+	if (bCachedRotationBlocked)
 	{
-		if (ASC->HasMatchingGameplayTag(TAG_Gameplay_MovementStopped))
-		{
-			return FRotator(0,0,0);
-		}
+		return FRotator(0,0,0);
 	}
 
 	return Super::GetDeltaRotation(DeltaTime);
@@ -117,13 +265,10 @@ FRotator ULyraCharacterMovementComponent::GetDeltaRotation(float DeltaTime) cons
 
 float ULyraCharacterMovementComponent::GetMaxSpeed() const
 {
-	if (UAbilitySystemComponent* ASC = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(GetOwner()))
+	if (CachedMaxSpeedMultiplier <= 0.0f)
 	{
-		if (ASC->HasMatchingGameplayTag(TAG_Gameplay_MovementStopped))
-		{
-			return 0;
-		}
+		return 0;
 	}
 
-	return Super::GetMaxSpeed();
+	return Super::GetMaxSpeed() * CachedMaxSpeedMultiplier;
 }
\ No newline at end of file
@@ -5,8 +5,13 @@
 #include "CoreMinimal.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "NativeGameplayTags.h"
+#include "GameplayTagContainer.h"
 #include "LyraCharacterMovementComponent.generated.h"
 
+class UAbilitySystemComponent;
+struct FCollisionQueryParams;
+struct FCollisionResponseParams;
+
 LYRAGAME_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(TAG_Gameplay_MovementStopped);
 
 /**
@@ -34,6 +39,30 @@ struct FLyraCharacterGroundInfo
 };
 
 
+/**
+ * FLyraMovementTagModifier
+ *
+ *	How a gameplay tag on the owner's ability system affects movement while it is present.
+ */
+USTRUCT(BlueprintType)
+struct FLyraMovementTagModifier
+{
+	GENERATED_BODY()
+
+	// Tag that enables this modifier, matched including child tags.
+	UPROPERTY(EditAnywhere, Category = "Lyra|CharacterMovement")
+	FGameplayTag Tag;
+
+	// Multiplier applied to the max speed while the tag is present.  Zero roots the character in place.
+	UPROPERTY(EditAnywhere, Category = "Lyra|CharacterMovement", meta = (ClampMin = "0.0"))
+	float MaxSpeedMultiplier = 1.0f;
+
+	// If set, the character can't rotate while the tag is present.
+	UPROPERTY(EditAnywhere, Category = "Lyra|CharacterMovement")
+	bool bBlocksRotation = false;
+};
+
+
 /**
  * ULyraCharacterMovementComponent
  *
@@ -53,11 +82,24 @@ public:
 	virtual bool CanAttemptJump() const override;
 
 	// Returns the current ground info.  Calling this will update the ground info if it's out of date.
+	// While airborne the ground distance may come from the previous frame's batched ground probe, see ULyraGroundProbeSubsystem.
 	UFUNCTION(BlueprintCallable, Category = "Lyra|CharacterMovement")
 	const FLyraCharacterGroundInfo& GetGroundInfo();
 
+	// Builds the trace used to find the ground under the character.  Returns false if there is nothing to trace for.
+	bool GetGroundTraceParams(FVector& OutTraceStart, FVector& OutTraceEnd, ECollisionChannel& OutCollisionChannel, FCollisionQueryParams& OutQueryParams, FCollisionResponseParams& OutResponseParam) const;
+
+	// Stores the result of a ground trace issued by ULyraGroundProbeSubsystem.
+	void ApplyGroundProbeResult(const FHitResult& HitResult);
+
 	void SetReplicatedAcceleration(const FVector& InAcceleration);
 
+	// Listens for the movement affecting tags on the ability system, caching their effect until they change.
+	void InitializeWithAbilitySystem(UAbilitySystemComponent* InASC);
+
+	// Stops listening for tag changes and clears the cached tag modifiers.
+	void UninitializeFromAbilitySystem();
+
 	//~UMovementComponent interface
 	virtual FRotator GetDeltaRotation(float DeltaTime) const override;
 	virtual float GetMaxSpeed() const override;
@@ -66,12 +108,40 @@ public:
 protected:
 
 	virtual void InitializeComponent() override;
+	virtual void OnUnregister() override;
+
+	void UpdateGroundDistance(const FHitResult& HitResult);
+
+	void OnMovementTagChanged(const FGameplayTag Tag, int32 NewCount);
+	void RefreshMovementTagModifiers();
 
 protected:
 
+	// Additional tags that slow, root or block the rotation of the character.  Gameplay.MovementStopped always stops movement and rotation.
+	UPROPERTY(EditDefaultsOnly, Category = "Lyra|CharacterMovement")
+	TArray<FLyraMovementTagModifier> MovementTagModifiers;
+
 	// Cached ground info for the character.  Do not access this directly!  It's only updated when accessed via GetGroundInfo().
 	FLyraCharacterGroundInfo CachedGroundInfo;
 
+	// Frame the last ground probe was queued on, used by ULyraGroundProbeSubsystem to throttle probes.
+	uint64 GroundProbeRequestFrame = 0;
+
+	// True once a ground probe result arrived since the character last walked.
+	bool bHasGroundProbeResult = false;
+
+	friend class ULyraGroundProbeSubsystem;
+
 	UPROPERTY(Transient)
 	bool bHasReplicatedAcceleration = false;
+
+	// Ability system the movement tags are read from, set between InitializeWithAbilitySystem and UninitializeFromAbilitySystem.
+	TWeakObjectPtr<UAbilitySystemComponent> MovementTagASC;
+
+	// Tag event registrations, so they can be removed again.
+	TArray<TPair<FGameplayTag, FDelegateHandle>> MovementTagEventHandles;
+
+	// Effect of the movement tags currently on the ability system, only updated when one of them changes.
+	float CachedMaxSpeedMultiplier = 1.0f;
+	bool bCachedRotationBlocked = false;
 };
@@ -0,0 +1,95 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LyraGroundProbeSubsystem.h"
+#include "LyraCharacterMovementComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+
+ULyraGroundProbeSubsystem::ULyraGroundProbeSubsystem()
+{
+	ProbeIntervalByLOD = { 1, 2, 4, 8 };
+}
+
+void ULyraGroundProbeSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &ThisClass::OnWorldPostActorTick);
+}
+
+void ULyraGroundProbeSubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+	PendingProbes.Empty();
+
+	Super::Deinitialize();
+}
+
+void ULyraGroundProbeSubsystem::RequestProbe(ULyraCharacterMovementComponent* MovementComponent)
+{
+	check(MovementComponent);
+
+	if (MovementComponent->GroundProbeRequestFrame == GFrameCounter)
+	{
+		return;
+	}
+
+	int32 ProbeInterval = 1;
+	if (ProbeIntervalByLOD.Num() > 0)
+	{
+		const ACharacter* Character = MovementComponent->GetCharacterOwner();
+		const USkeletalMeshComponent* Mesh = Character ? Character->GetMesh() : nullptr;
+		const int32 LODIndex = Mesh ? Mesh->GetPredictedLODLevel() : 0;
+		ProbeInterval = FMath::Max(ProbeIntervalByLOD[FMath::Clamp(LODIndex, 0, ProbeIntervalByLOD.Num() - 1)], 1);
+	}
+
+	if ((GFrameCounter - MovementComponent->GroundProbeRequestFrame) < (uint64)ProbeInterval)
+	{
+		return;
+	}
+
+	MovementComponent->GroundProbeRequestFrame = GFrameCounter;
+	PendingProbes.Add(MovementComponent);
+}
+
+void ULyraGroundProbeSubsystem::OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if ((World != GetWorld()) || (PendingProbes.Num() == 0))
+	{
+		return;
+	}
+
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_LyraGroundProbe_IssueTraces);
+
+	for (const TWeakObjectPtr<ULyraCharacterMovementComponent>& WeakMovementComponent : PendingProbes)
+	{
+		const ULyraCharacterMovementComponent* MovementComponent = WeakMovementComponent.Get();
+		if (!MovementComponent)
+		{
+			continue;
+		}
+
+		FVector TraceStart;
+		FVector TraceEnd;
+		ECollisionChannel CollisionChannel;
+		FCollisionQueryParams QueryParams;
+		FCollisionResponseParams ResponseParam;
+		if (MovementComponent->GetGroundTraceParams(/*out*/ TraceStart, /*out*/ TraceEnd, /*out*/ CollisionChannel, /*out*/ QueryParams, /*out*/ ResponseParam))
+		{
+			const FTraceDelegate TraceDelegate = FTraceDelegate::CreateUObject(this, &ThisClass::OnProbeTraceDone, WeakMovementComponent);
+			World->AsyncLineTraceByChannel(EAsyncTraceType::Single, TraceStart, TraceEnd, CollisionChannel, QueryParams, ResponseParam, &TraceDelegate);
+		}
+	}
+
+	PendingProbes.Reset();
+}
+
+void ULyraGroundProbeSubsystem::OnProbeTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum, TWeakObjectPtr<ULyraCharacterMovementComponent> WeakMovementComponent)
+{
+	if (ULyraCharacterMovementComponent* MovementComponent = WeakMovementComponent.Get())
+	{
+		const FHitResult* HitResult = TraceDatum.OutHits.Num() > 0 ? &TraceDatum.OutHits[0] : nullptr;
+		MovementComponent->ApplyGroundProbeResult(HitResult ? *HitResult : FHitResult(TraceDatum.Start, TraceDatum.End));
+	}
+}
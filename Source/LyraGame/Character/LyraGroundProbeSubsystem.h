@@ -0,0 +1,52 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+
+#include "LyraGroundProbeSubsystem.generated.h"
+
+class ULyraCharacterMovementComponent;
+
+/**
+ * ULyraGroundProbeSubsystem
+ *
+ * Gathers the ground traces requested by airborne characters during the frame and issues them as one batch
+ * of async traces after actors have ticked. Results arrive the following frame, so characters serve their
+ * ground info from the previous batch instead of each running a synchronous scene query.
+ *
+ * Characters with lower detail mesh LODs are probed less often, see ProbeIntervalByLOD.
+ */
+UCLASS(Config=Game)
+class LYRAGAME_API ULyraGroundProbeSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	ULyraGroundProbeSubsystem();
+
+	//~USubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~End of USubsystem interface
+
+	/** Queues a ground probe for the movement component if its LOD's interval has passed since its last probe */
+	void RequestProbe(ULyraCharacterMovementComponent* MovementComponent);
+
+protected:
+	/** Frames between probes for each mesh LOD, the last entry is used for any higher LOD */
+	UPROPERTY(Config, EditAnywhere, Category = "Ground Probe")
+	TArray<int32> ProbeIntervalByLOD;
+
+private:
+	void OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+
+	void OnProbeTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum, TWeakObjectPtr<ULyraCharacterMovementComponent> WeakMovementComponent);
+
+	/** Movement components waiting for the next batch */
+	TArray<TWeakObjectPtr<ULyraCharacterMovementComponent>> PendingProbes;
+
+	FDelegateHandle PostActorTickHandle;
+};
@@ -0,0 +1,262 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LyraCharacterPartPoolSubsystem.h"
+#include "LyraLogChannels.h"
+#include "Engine/SkeletalMesh.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Components/MeshComponent.h"
+#include "Materials/MaterialInterface.h"
+#include "SkeletalMeshMerge.h"
+
+DECLARE_STATS_GROUP(TEXT("Lyra Character Parts"), STATGROUP_LyraCharacterParts, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Acquire Part Actor"), STAT_LyraCharacterParts_Acquire, STATGROUP_LyraCharacterParts);
+DECLARE_CYCLE_STAT(TEXT("Merge Meshes"), STAT_LyraCharacterParts_MergeMeshes, STATGROUP_LyraCharacterParts);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Active Part Actors"), STAT_LyraCharacterParts_ActiveActors, STATGROUP_LyraCharacterParts);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pooled Part Actors"), STAT_LyraCharacterParts_PooledActors, STATGROUP_LyraCharacterParts);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Active Part Components"), STAT_LyraCharacterParts_Components, STATGROUP_LyraCharacterParts);
+
+namespace LyraCharacterParts
+{
+	static bool bPoolPartActors = true;
+	static FAutoConsoleVariableRef CVarPoolPartActors(TEXT("lyra.CharacterParts.PoolActors"), bPoolPartActors, TEXT("If set, released character part actors are kept to be reused by the next pawn instead of being destroyed."), ECVF_Default);
+
+	static FAutoConsoleCommandWithWorld CmdDumpPool(
+		TEXT("lyra.CharacterParts.DumpPool"),
+		TEXT("Logs the character part actor pools, spawn times and component counts of the current world."),
+		FConsoleCommandWithWorldDelegate::CreateStatic([](UWorld* World)
+		{
+			if (const ULyraCharacterPartPoolSubsystem* PoolSubsystem = World ? World->GetSubsystem<ULyraCharacterPartPoolSubsystem>() : nullptr)
+			{
+				PoolSubsystem->DumpStats();
+			}
+		}));
+
+	// Puts the materials of the part's meshes back to the ones of its class, dropping any dynamic instances the previous owner created (e.g., for team colors)
+	static void ResetPartActorMaterials(AActor* PartActor)
+	{
+		PartActor->ForEachComponent<UMeshComponent>(/*bIncludeFromChildActors=*/ true, [](UMeshComponent* MeshComponent)
+		{
+			const UMeshComponent* Archetype = Cast<UMeshComponent>(MeshComponent->GetArchetype());
+			for (int32 MaterialIndex = 0; MaterialIndex < MeshComponent->GetNumMaterials(); ++MaterialIndex)
+			{
+				UMaterialInterface* DefaultMaterial = (Archetype && Archetype->OverrideMaterials.IsValidIndex(MaterialIndex)) ? Archetype->OverrideMaterials[MaterialIndex] : nullptr;
+				if (MeshComponent->OverrideMaterials.IsValidIndex(MaterialIndex) && (MeshComponent->OverrideMaterials[MaterialIndex] != DefaultMaterial))
+				{
+					MeshComponent->SetMaterial(MaterialIndex, DefaultMaterial);
+				}
+			}
+		});
+	}
+
+	// Pooled actors are hidden and don't tick or collide, and their materials are reset on release.
+	// Any other state changed by the previous owner (Niagara parameters, Blueprint variables, etc.) carries over to the next one.
+	static void SetPartActorActive(AActor* PartActor, bool bActive)
+	{
+		PartActor->SetActorHiddenInGame(!bActive);
+		PartActor->SetActorTickEnabled(bActive && PartActor->PrimaryActorTick.bStartWithTickEnabled);
+		PartActor->ForEachComponent<UActorComponent>(/*bIncludeFromChildActors=*/ false, [bActive](UActorComponent* Component)
+		{
+			Component->SetComponentTickEnabled(bActive && Component->PrimaryComponentTick.bStartWithTickEnabled);
+		});
+
+		if (!bActive)
+		{
+			PartActor->SetActorEnableCollision(false);
+			ResetPartActorMaterials(PartActor);
+		}
+	}
+}
+
+void ULyraCharacterPartPoolSubsystem::Deinitialize()
+{
+	Pools.Empty();
+	MergedMeshes.Empty();
+	ActiveActorComponentCounts.Empty();
+	NumActiveComponents = 0;
+	UpdateStats();
+
+	Super::Deinitialize();
+}
+
+AActor* ULyraCharacterPartPoolSubsystem::AcquirePartActor(TSubclassOf<AActor> PartClass, USceneComponent* AttachTo, FName SocketName)
+{
+	check(PartClass);
+	check(AttachTo);
+
+	SCOPE_CYCLE_COUNTER(STAT_LyraCharacterParts_Acquire);
+	const double StartTime = FPlatformTime::Seconds();
+
+	FLyraPooledCharacterParts& Pool = Pools.FindOrAdd(PartClass);
+
+	AActor* PartActor = nullptr;
+	while (!PartActor && (Pool.FreeActors.Num() > 0))
+	{
+		// Pooled actors can still be destroyed by someone else, e.g. a level unloading
+		PartActor = Pool.FreeActors.Pop(/*bAllowShrinking=*/ false);
+		if (!IsValid(PartActor))
+		{
+			PartActor = nullptr;
+		}
+	}
+
+	if (PartActor)
+	{
+		LyraCharacterParts::SetPartActorActive(PartActor, true);
+		PartActor->SetActorEnableCollision(true);
+		PartActor->SetOwner(AttachTo->GetOwner());
+		++Pool.NumReused;
+	}
+	else
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.Owner = AttachTo->GetOwner();
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		SpawnParams.ObjectFlags |= RF_Transient;
+
+		PartActor = GetWorld()->SpawnActor<AActor>(PartClass, AttachTo->GetSocketTransform(SocketName), SpawnParams);
+		++Pool.NumSpawned;
+	}
+
+	if (PartActor)
+	{
+		PartActor->AttachToComponent(AttachTo, FAttachmentTransformRules::SnapToTargetNotIncludingScale, SocketName);
+
+		// Set up a direct tick dependency so the part follows the pose of the component it's attached to
+		if (USceneComponent* PartRootComponent = PartActor->GetRootComponent())
+		{
+			PartRootComponent->AddTickPrerequisiteComponent(AttachTo);
+		}
+
+		const int32 NumComponents = PartActor->GetComponents().Num();
+		ActiveActorComponentCounts.Add(PartActor, NumComponents);
+		NumActiveComponents += NumComponents;
+	}
+
+	Pool.AcquireSeconds += FPlatformTime::Seconds() - StartTime;
+	UpdateStats();
+
+	return PartActor;
+}
+
+void ULyraCharacterPartPoolSubsystem::ReleasePartActor(AActor* PartActor)
+{
+	if (!IsValid(PartActor))
+	{
+		return;
+	}
+
+	int32 NumComponents = 0;
+	if (ActiveActorComponentCounts.RemoveAndCopyValue(PartActor, NumComponents))
+	{
+		NumActiveComponents -= NumComponents;
+	}
+
+	if (USceneComponent* PartRootComponent = PartActor->GetRootComponent())
+	{
+		if (USceneComponent* AttachParent = PartRootComponent->GetAttachParent())
+		{
+			PartRootComponent->RemoveTickPrerequisiteComponent(AttachParent);
+		}
+	}
+
+	PartActor->DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
+
+	FLyraPooledCharacterParts& Pool = Pools.FindOrAdd(PartActor->GetClass());
+	if (LyraCharacterParts::bPoolPartActors && (Pool.FreeActors.Num() < MaxPooledActorsPerClass) && !GetWorld()->bIsTearingDown)
+	{
+		LyraCharacterParts::SetPartActorActive(PartActor, false);
+		PartActor->SetOwner(nullptr);
+		Pool.FreeActors.Add(PartActor);
+	}
+	else
+	{
+		PartActor->Destroy();
+	}
+
+	UpdateStats();
+}
+
+USkeletalMesh* ULyraCharacterPartPoolSubsystem::FindOrCreateMergedMesh(USkeletalMesh* BodyMesh, const TArray<USkeletalMesh*>& PartMeshes)
+{
+	check(BodyMesh);
+
+	TArray<USkeletalMesh*> SourceMeshes;
+	SourceMeshes.Reserve(PartMeshes.Num() + 1);
+	SourceMeshes.Add(BodyMesh);
+	SourceMeshes.Append(PartMeshes);
+
+	for (const FLyraMergedCharacterMesh& Existing : MergedMeshes)
+	{
+		if (Existing.SourceMeshes.Num() != SourceMeshes.Num())
+		{
+			continue;
+		}
+
+		bool bSameMeshes = true;
+		for (int32 MeshIndex = 0; bSameMeshes && (MeshIndex < SourceMeshes.Num()); ++MeshIndex)
+		{
+			bSameMeshes = (Existing.SourceMeshes[MeshIndex] == SourceMeshes[MeshIndex]);
+		}
+
+		if (bSameMeshes)
+		{
+			return Existing.MergedMesh;
+		}
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_LyraCharacterParts_MergeMeshes);
+
+	USkeletalMesh* MergedMesh = NewObject<USkeletalMesh>(this, NAME_None, RF_Transient);
+	MergedMesh->SetSkeleton(BodyMesh->GetSkeleton());
+
+	// The source meshes need CPU access in cooked builds for their vertices to be read here
+	const TArray<FSkelMeshMergeSectionMapping> SectionMappings;
+	FSkeletalMeshMerge Merger(MergedMesh, SourceMeshes, SectionMappings, /*StripTopLODs=*/ 0);
+	if (Merger.DoMerge())
+	{
+		MergedMesh->SetPhysicsAsset(BodyMesh->GetPhysicsAsset());
+	}
+	else
+	{
+		UE_LOG(LogLyra, Warning, TEXT("Failed to merge character part meshes onto %s, the parts will stay separate."), *GetNameSafe(BodyMesh));
+		MergedMesh = nullptr;
+	}
+
+	// Failures are remembered too, so a combination that can't be merged isn't retried by every pawn
+	FLyraMergedCharacterMesh& NewEntry = MergedMeshes.AddDefaulted_GetRef();
+	NewEntry.SourceMeshes.Append(SourceMeshes);
+	NewEntry.MergedMesh = MergedMesh;
+
+	return MergedMesh;
+}
+
+void ULyraCharacterPartPoolSubsystem::UpdateStats() const
+{
+	int32 NumPooledActors = 0;
+	for (const auto& KVP : Pools)
+	{
+		NumPooledActors += KVP.Value.FreeActors.Num();
+	}
+
+	SET_DWORD_STAT(STAT_LyraCharacterParts_ActiveActors, ActiveActorComponentCounts.Num());
+	SET_DWORD_STAT(STAT_LyraCharacterParts_PooledActors, NumPooledActors);
+	SET_DWORD_STAT(STAT_LyraCharacterParts_Components, NumActiveComponents);
+}
+
+void ULyraCharacterPartPoolSubsystem::DumpStats() const
+{
+	UE_LOG(LogLyra, Log, TEXT("Character part pools in %s:"), *GetNameSafe(GetWorld()));
+
+	for (const auto& KVP : Pools)
+	{
+		const FLyraPooledCharacterParts& Pool = KVP.Value;
+		const int32 NumAcquired = Pool.NumSpawned + Pool.NumReused;
+		const double AverageAcquireMs = (NumAcquired > 0) ? (Pool.AcquireSeconds * 1000.0 / NumAcquired) : 0.0;
+
+		UE_LOG(LogLyra, Log, TEXT("  %s: %d free, %d spawned, %d reused, %.3f ms average acquire"),
+			*GetNameSafe(KVP.Key), Pool.FreeActors.Num(), Pool.NumSpawned, Pool.NumReused, AverageAcquireMs);
+	}
+
+	UE_LOG(LogLyra, Log, TEXT("  %d active part actors with %d components, %d merged meshes"), ActiveActorComponentCounts.Num(), NumActiveComponents, MergedMeshes.Num());
+}
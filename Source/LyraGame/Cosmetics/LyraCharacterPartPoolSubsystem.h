@@ -0,0 +1,92 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+
+#include "LyraCharacterPartPoolSubsystem.generated.h"
+
+class USkeletalMesh;
+
+// Inactive actors of a single character part class
+USTRUCT()
+struct FLyraPooledCharacterParts
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<TObjectPtr<AActor>> FreeActors;
+
+	// How many actors were spawned for and reused from this pool, for reporting
+	int32 NumSpawned = 0;
+	int32 NumReused = 0;
+
+	// Time spent acquiring actors from this pool, for reporting
+	double AcquireSeconds = 0.0;
+};
+
+// A merged body + cosmetic parts mesh, shared by every pawn wearing the same combination
+USTRUCT()
+struct FLyraMergedCharacterMesh
+{
+	GENERATED_BODY()
+
+	// The body mesh followed by the part meshes, in the order they were merged
+	UPROPERTY()
+	TArray<TObjectPtr<USkeletalMesh>> SourceMeshes;
+
+	UPROPERTY()
+	TObjectPtr<USkeletalMesh> MergedMesh = nullptr;
+};
+
+/**
+ * ULyraCharacterPartPoolSubsystem
+ *
+ * Keeps the actors of released character parts around per part class, so respawning pawns reuse them instead
+ * of spawning (and later garbage collecting) a fresh actor for every cosmetic part.
+ *
+ * Also owns the merged meshes used when character parts are merged into the body mesh, see
+ * ULyraPawnComponent_CharacterParts::bMergeCosmeticMeshes.
+ */
+UCLASS(Config=Game)
+class LYRAGAME_API ULyraCharacterPartPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~USubsystem interface
+	virtual void Deinitialize() override;
+	//~End of USubsystem interface
+
+	// Returns an actor of the part class attached to the component, reusing a released one when possible
+	AActor* AcquirePartActor(TSubclassOf<AActor> PartClass, USceneComponent* AttachTo, FName SocketName);
+
+	// Detaches and hides the actor so it can be acquired again (or destroys it if its pool is full)
+	void ReleasePartActor(AActor* PartActor);
+
+	// Returns the body mesh merged with the part meshes, merging them the first time the combination is seen
+	USkeletalMesh* FindOrCreateMergedMesh(USkeletalMesh* BodyMesh, const TArray<USkeletalMesh*>& PartMeshes);
+
+	// Logs the pool sizes, spawn times and component counts
+	void DumpStats() const;
+
+protected:
+	// Released actors kept per part class, any beyond this are destroyed
+	UPROPERTY(Config, EditAnywhere, Category = "Character Parts")
+	int32 MaxPooledActorsPerClass = 64;
+
+private:
+	void UpdateStats() const;
+
+	UPROPERTY(Transient)
+	TMap<TSubclassOf<AActor>, FLyraPooledCharacterParts> Pools;
+
+	UPROPERTY(Transient)
+	TArray<FLyraMergedCharacterMesh> MergedMeshes;
+
+	// Acquired part actors and the components they had when acquired, for reporting
+	TMap<TObjectKey<AActor>, int32> ActiveActorComponentCounts;
+	int32 NumActiveComponents = 0;
+};
@@ -3,15 +3,23 @@
 #include "LyraPawnComponent_CharacterParts.h"
 #include "GameFramework/Character.h"
 #include "Components/SkeletalMeshComponent.h"
-#include "Components/ChildActorComponent.h"
 #include "Net/UnrealNetwork.h"
 #include "GameplayTagAssetInterface.h"
+#include "LyraCharacterPartPoolSubsystem.h"
+#include "Engine/SkeletalMesh.h"
+#include "Algo/Sort.h"
+
+namespace LyraCharacterParts
+{
+	static bool bMergeCosmeticMeshes = true;
+	static FAutoConsoleVariableRef CVarMergeCosmeticMeshes(TEXT("lyra.CharacterParts.MergeMeshes"), bMergeCosmeticMeshes, TEXT("If set, pawns that opt in merge the meshes of their character parts into the body mesh."), ECVF_Default);
+}
 
 //////////////////////////////////////////////////////////////////////
 
 FString FLyraAppliedCharacterPartEntry::GetDebugString() const
 {
-	return FString::Printf(TEXT("(PartClass: %s, Socket: %s, Instance: %s)"), *GetPathNameSafe(Part.PartClass), *Part.SocketName.ToString(), *GetPathNameSafe(SpawnedComponent));
+	return FString::Printf(TEXT("(PartClass: %s, Socket: %s, Instance: %s)"), *GetPathNameSafe(Part.PartClass), *Part.SocketName.ToString(), *GetPathNameSafe(SpawnedActor));
 }
 
 //////////////////////////////////////////////////////////////////////
@@ -130,12 +138,9 @@ FGameplayTagContainer FLyraCharacterPartList::CollectCombinedTags() const
 
 	for (const FLyraAppliedCharacterPartEntry& Entry : Entries)
 	{
-		if (Entry.SpawnedComponent != nullptr)
+		if (IGameplayTagAssetInterface* TagInterface = Cast<IGameplayTagAssetInterface>(Entry.SpawnedActor))
 		{
-			if (IGameplayTagAssetInterface* TagInterface = Cast<IGameplayTagAssetInterface>(Entry.SpawnedComponent->GetChildActor()))
-			{
-				TagInterface->GetOwnedGameplayTags(/*inout*/ Result);
-			}
+			TagInterface->GetOwnedGameplayTags(/*inout*/ Result);
 		}
 	}
 
@@ -150,19 +155,12 @@ bool FLyraCharacterPartList::SpawnActorForEntry(FLyraAppliedCharacterPartEntry&
 	{
 		if (Entry.Part.PartClass != nullptr)
 		{
-			UWorld* World = OwnerComponent->GetWorld();
+			ULyraCharacterPartPoolSubsystem* PoolSubsystem = OwnerComponent->GetWorld()->GetSubsystem<ULyraCharacterPartPoolSubsystem>();
+			USceneComponent* ComponentToAttachTo = OwnerComponent->GetSceneComponentToAttachTo();
 
-			if (USceneComponent* ComponentToAttachTo = OwnerComponent->GetSceneComponentToAttachTo())
+			if (PoolSubsystem && ComponentToAttachTo)
 			{
-				const FTransform SpawnTransform = ComponentToAttachTo->GetSocketTransform(Entry.Part.SocketName);
-
-				UChildActorComponent* PartComponent = NewObject<UChildActorComponent>(OwnerComponent->GetOwner());
-
-				PartComponent->SetupAttachment(ComponentToAttachTo, Entry.Part.SocketName);
-				PartComponent->SetChildActorClass(Entry.Part.PartClass);
-				PartComponent->RegisterComponent();
-
-				if (AActor* SpawnedActor = PartComponent->GetChildActor())
+				if (AActor* SpawnedActor = PoolSubsystem->AcquirePartActor(Entry.Part.PartClass, ComponentToAttachTo, Entry.Part.SocketName))
 				{
 					switch (Entry.Part.CollisionMode)
 					{
@@ -175,15 +173,9 @@ bool FLyraCharacterPartList::SpawnActorForEntry(FLyraAppliedCharacterPartEntry&
 						break;
 					}
 
-					// Set up a direct tick dependency to work around the child actor component not providing one
-					if (USceneComponent* SpawnedRootComponent = SpawnedActor->GetRootComponent())
-					{
-						SpawnedRootComponent->AddTickPrerequisiteComponent(ComponentToAttachTo);
-					}
+					Entry.SpawnedActor = SpawnedActor;
+					bCreatedAnyActors = true;
 				}
-
-				Entry.SpawnedComponent = PartComponent;
-				bCreatedAnyActors = true;
 			}
 		}
 	}
@@ -195,16 +187,76 @@ bool FLyraCharacterPartList::DestroyActorForEntry(FLyraAppliedCharacterPartEntry
 {
 	bool bDestroyedAnyActors = false;
 
-	if (Entry.SpawnedComponent != nullptr)
+	if (Entry.SpawnedActor != nullptr)
 	{
-		Entry.SpawnedComponent->DestroyComponent();
-		Entry.SpawnedComponent = nullptr;
+		SetMergedIntoParentMesh(Entry, false);
+
+		if (ULyraCharacterPartPoolSubsystem* PoolSubsystem = OwnerComponent->GetWorld()->GetSubsystem<ULyraCharacterPartPoolSubsystem>())
+		{
+			PoolSubsystem->ReleasePartActor(Entry.SpawnedActor);
+		}
+		else
+		{
+			Entry.SpawnedActor->Destroy();
+		}
+
+		Entry.SpawnedActor = nullptr;
 		bDestroyedAnyActors = true;
 	}
 
 	return bDestroyedAnyActors;
 }
 
+bool FLyraCharacterPartList::GetMergeableMeshes(const FLyraAppliedCharacterPartEntry& Entry, const USkeleton* ParentSkeleton, TArray<USkeletalMesh*>& OutMeshes)
+{
+	// Parts on sockets are offset from the body's reference pose, so they can't be merged into it
+	if ((Entry.SpawnedActor == nullptr) || (Entry.Part.SocketName != NAME_None))
+	{
+		return false;
+	}
+
+	const int32 NumMeshesBefore = OutMeshes.Num();
+	bool bCanMerge = true;
+
+	Entry.SpawnedActor->ForEachComponent<UPrimitiveComponent>(/*bIncludeFromChildActors=*/ false, [&](UPrimitiveComponent* PrimitiveComponent)
+	{
+		const USkeletalMeshComponent* MeshComponent = Cast<USkeletalMeshComponent>(PrimitiveComponent);
+		USkeletalMesh* Mesh = MeshComponent ? MeshComponent->SkeletalMesh : nullptr;
+		if (Mesh && (Mesh->GetSkeleton() == ParentSkeleton) && MeshComponent->IsVisible())
+		{
+			OutMeshes.Add(Mesh);
+		}
+		else
+		{
+			bCanMerge = false;
+		}
+	});
+
+	if (!bCanMerge)
+	{
+		OutMeshes.SetNum(NumMeshesBefore, /*bAllowShrinking=*/ false);
+	}
+
+	return bCanMerge && (OutMeshes.Num() > NumMeshesBefore);
+}
+
+void FLyraCharacterPartList::SetMergedIntoParentMesh(FLyraAppliedCharacterPartEntry& Entry, bool bMerged)
+{
+	if ((Entry.bMergedIntoParentMesh == bMerged) || (Entry.SpawnedActor == nullptr))
+	{
+		return;
+	}
+
+	// The meshes are drawn (and posed) by the parent now, only hide them so unmerging is cheap
+	Entry.SpawnedActor->ForEachComponent<USkeletalMeshComponent>(/*bIncludeFromChildActors=*/ false, [bMerged](USkeletalMeshComponent* MeshComponent)
+	{
+		MeshComponent->SetVisibility(!bMerged);
+		MeshComponent->SetComponentTickEnabled(!bMerged && MeshComponent->PrimaryComponentTick.bStartWithTickEnabled);
+	});
+
+	Entry.bMergedIntoParentMesh = bMerged;
+}
+
 //////////////////////////////////////////////////////////////////////
 
 ULyraPawnComponent_CharacterParts::ULyraPawnComponent_CharacterParts(const FObjectInitializer& ObjectInitializer)
@@ -255,12 +307,9 @@ TArray<AActor*> ULyraPawnComponent_CharacterParts::GetCharacterPartActors() cons
 
 	for (const FLyraAppliedCharacterPartEntry& Entry : CharacterPartList.Entries)
 	{
-		if (UChildActorComponent* PartComponent = Entry.SpawnedComponent)
+		if (AActor* SpawnedActor = Entry.SpawnedActor)
 		{
-			if (AActor* SpawnedActor = PartComponent->GetChildActor())
-			{
-				Result.Add(SpawnedActor);
-			}
+			Result.Add(SpawnedActor);
 		}
 	}
 
@@ -321,7 +370,7 @@ void ULyraPawnComponent_CharacterParts::BroadcastChanged()
 	{
 		// Determine the mesh to use based on cosmetic part tags
 		const FGameplayTagContainer MergedTags = GetCombinedTags(FGameplayTag());
-		USkeletalMesh* DesiredMesh = BodyMeshes.SelectBestBodyStyle(MergedTags);
+		USkeletalMesh* DesiredMesh = MergeCosmeticMeshes(BodyMeshes.SelectBestBodyStyle(MergedTags));
 
 		// Apply the desired mesh (this call is a no-op if the mesh hasn't changed)
 		MeshComponent->SetSkeletalMesh(DesiredMesh, /*bReinitPose=*/ bReinitPose);
@@ -337,3 +386,53 @@ void ULyraPawnComponent_CharacterParts::BroadcastChanged()
 	OnCharacterPartsChanged.Broadcast(this);
 }
 
+USkeletalMesh* ULyraPawnComponent_CharacterParts::MergeCosmeticMeshes(USkeletalMesh* BodyMesh)
+{
+	// Start from separate parts, the set of parts (or the body) may have changed since the last merge
+	for (FLyraAppliedCharacterPartEntry& Entry : CharacterPartList.Entries)
+	{
+		FLyraCharacterPartList::SetMergedIntoParentMesh(Entry, false);
+	}
+
+	if (!bMergeCosmeticMeshes || !LyraCharacterParts::bMergeCosmeticMeshes || (BodyMesh == nullptr) || IsNetMode(NM_DedicatedServer))
+	{
+		return BodyMesh;
+	}
+
+	ULyraCharacterPartPoolSubsystem* PoolSubsystem = GetWorld()->GetSubsystem<ULyraCharacterPartPoolSubsystem>();
+	if (PoolSubsystem == nullptr)
+	{
+		return BodyMesh;
+	}
+
+	TArray<USkeletalMesh*> PartMeshes;
+	TArray<FLyraAppliedCharacterPartEntry*, TInlineAllocator<8>> MergedEntries;
+	for (FLyraAppliedCharacterPartEntry& Entry : CharacterPartList.Entries)
+	{
+		if (FLyraCharacterPartList::GetMergeableMeshes(Entry, BodyMesh->GetSkeleton(), /*out*/ PartMeshes))
+		{
+			MergedEntries.Add(&Entry);
+		}
+	}
+
+	if (PartMeshes.Num() == 0)
+	{
+		return BodyMesh;
+	}
+
+	// Entries can replicate in any order, sorting lets every pawn with the same parts share one merged mesh
+	Algo::Sort(PartMeshes);
+
+	USkeletalMesh* MergedMesh = PoolSubsystem->FindOrCreateMergedMesh(BodyMesh, PartMeshes);
+	if (MergedMesh == nullptr)
+	{
+		return BodyMesh;
+	}
+
+	for (FLyraAppliedCharacterPartEntry* Entry : MergedEntries)
+	{
+		FLyraCharacterPartList::SetMergedIntoParentMesh(*Entry, true);
+	}
+
+	return MergedMesh;
+}
@@ -11,8 +11,9 @@
 
 #include "LyraPawnComponent_CharacterParts.generated.h"
 
+class USkeleton;
+class USkeletalMesh;
 class USkeletalMeshComponent;
-class UChildActorComponent;
 class ULyraPawnComponent_CharacterParts;
 struct FLyraCharacterPartList;
 
@@ -44,9 +45,12 @@ private:
 	UPROPERTY(NotReplicated)
 	int32 PartHandle = INDEX_NONE;
 
-	// The spawned actor instance (client only)
+	// The spawned actor instance, acquired from the character part pool (client only)
 	UPROPERTY(NotReplicated)
-	TObjectPtr<UChildActorComponent> SpawnedComponent = nullptr;
+	TObjectPtr<AActor> SpawnedActor = nullptr;
+
+	// Whether the spawned actor's meshes are hidden because they were merged into the parent mesh (client only)
+	bool bMergedIntoParentMesh = false;
 };
 
 //////////////////////////////////////////////////////////////////////
@@ -90,6 +94,10 @@ private:
 	bool SpawnActorForEntry(FLyraAppliedCharacterPartEntry& Entry);
 	bool DestroyActorForEntry(FLyraAppliedCharacterPartEntry& Entry);
 
+	// Finds the meshes of the entry's actor if it can be merged into a parent mesh using the skeleton, returns false if it can't
+	static bool GetMergeableMeshes(const FLyraAppliedCharacterPartEntry& Entry, const USkeleton* ParentSkeleton, TArray<USkeletalMesh*>& OutMeshes);
+	static void SetMergedIntoParentMesh(FLyraAppliedCharacterPartEntry& Entry, bool bMerged);
+
 private:
 	// Replicated list of equipment entries
 	UPROPERTY()
@@ -154,6 +162,10 @@ public:
 
 	void BroadcastChanged();
 
+private:
+	// Returns the body mesh merged with the meshes of the parts that can be merged (hiding their own), or BodyMesh if there are none
+	USkeletalMesh* MergeCosmeticMeshes(USkeletalMesh* BodyMesh);
+
 public:
 	// Delegate that will be called when the list of spawned character parts has changed
 	UPROPERTY(BlueprintAssignable, Category=Cosmetics, BlueprintCallable)
@@ -167,4 +179,10 @@ private:
 	// Rules for how to pick a body style mesh for animation to play on, based on character part cosmetics tags
 	UPROPERTY(EditAnywhere, Category=Cosmetics)
 	FLyraAnimBodyStyleSelectionSet BodyMeshes;
+
+	// Merge the skeletal meshes of parts that only contain meshes using the body's skeleton (attached without a socket) into the
+	// body mesh on clients, so they render as one component.  Per-part material changes (e.g., team colors) don't apply to
+	// merged parts, and the part meshes need CPU access enabled in cooked builds.
+	UPROPERTY(EditAnywhere, Category=Cosmetics)
+	bool bMergeCosmeticMeshes = false;
 };
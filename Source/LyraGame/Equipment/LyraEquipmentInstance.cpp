@@ -5,6 +5,7 @@
 #include "GameFramework/Character.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "Net/UnrealNetwork.h"
+#include "System/LyraSignificanceManager.h"
 
 ULyraEquipmentInstance::ULyraEquipmentInstance(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -67,12 +68,15 @@ void ULyraEquipmentInstance::SpawnEquipmentActors(const TArray<FLyraEquipmentAct
 			NewActor->AttachToComponent(AttachTarget, FAttachmentTransformRules::KeepRelativeTransform, SpawnInfo.AttachSocket);
 
 			SpawnedActors.Add(NewActor);
+
+			RegisterWithSignificanceManager(NewActor);
 		}
 	}
 }
 
 void ULyraEquipmentInstance::DestroyEquipmentActors()
 {
+	// Destroyed actors are unregistered from the significance manager by the manager itself
 	for (AActor* Actor : SpawnedActors)
 	{
 		if (Actor)
@@ -82,6 +86,26 @@ void ULyraEquipmentInstance::DestroyEquipmentActors()
 	}
 }
 
+void ULyraEquipmentInstance::RegisterWithSignificanceManager(AActor* SpawnedActor) const
+{
+	const APawn* OwningPawn = GetPawn();
+	if ((SpawnedActor == nullptr) || (OwningPawn == nullptr) || OwningPawn->IsNetMode(NM_DedicatedServer))
+	{
+		return;
+	}
+
+	// The server simulates remote players' weapons for everyone, throttling them would starve hit validation and anim notifies
+	if (ULyraSignificanceManager::IsRemotelyControlledOnServer(OwningPawn))
+	{
+		return;
+	}
+
+	if (ULyraSignificanceManager* SignificanceManager = USignificanceManager::Get<ULyraSignificanceManager>(GetWorld()))
+	{
+		SignificanceManager->RegisterWithProvider(SpawnedActor, ULyraSignificanceManager::WeaponTag);
+	}
+}
+
 void ULyraEquipmentInstance::OnEquipped()
 {
 	K2_OnEquipped();
@@ -95,3 +119,12 @@ void ULyraEquipmentInstance::OnUnequipped()
 void ULyraEquipmentInstance::OnRep_Instigator()
 {
 }
+
+void ULyraEquipmentInstance::OnRep_SpawnedActors()
+{
+	// Remote clients only see the replicated actors, entries can also arrive (or resolve) one at a time
+	for (AActor* Actor : SpawnedActors)
+	{
+		RegisterWithSignificanceManager(Actor);
+	}
+}
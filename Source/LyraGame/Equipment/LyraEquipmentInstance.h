@@ -59,10 +59,16 @@ private:
 	UFUNCTION()
 	void OnRep_Instigator();
 
+	UFUNCTION()
+	void OnRep_SpawnedActors();
+
+	// Lets the significance manager throttle the actor on machines that only display it
+	void RegisterWithSignificanceManager(AActor* SpawnedActor) const;
+
 private:
 	UPROPERTY(ReplicatedUsing=OnRep_Instigator)
 	UObject* Instigator;
 
-	UPROPERTY(Replicated)
+	UPROPERTY(ReplicatedUsing=OnRep_SpawnedActors)
 	TArray<AActor*> SpawnedActors;
 };
@@ -4,8 +4,10 @@
 #include "LyraContextEffectComponent.h"
 #include "LyraContextEffectsLibrary.h"
 #include "LyraContextEffectsSubsystem.h"
-#include "NiagaraFunctionLibrary.h"
+#include "NiagaraComponent.h"
+#include "Components/AudioComponent.h"
 #include "PhysicalMaterials/PhysicalMaterial.h"
+#include "System/LyraSignificanceManager.h"
 
 
 
@@ -35,6 +37,12 @@ void ULyraContextEffectComponent::BeginPlay()
 		{
 			LyraContextEffectsSubsystem->LoadAndAddContextEffectsLibraries(GetOwner(), CurrentContextEffectsLibraries);
 		}
+
+		ULyraSignificanceManager* SignificanceManager = !IsNetMode(NM_DedicatedServer) ? USignificanceManager::Get<ULyraSignificanceManager>(World) : nullptr;
+		if (SignificanceManager)
+		{
+			SignificanceManager->RegisterWithProvider(this, ULyraSignificanceManager::ContextEffectsTag);
+		}
 	}
 }
 
@@ -47,6 +55,11 @@ void ULyraContextEffectComponent::EndPlay(const EEndPlayReason::Type EndPlayReas
 		{
 			LyraContextEffectsSubsystem->UnloadAndRemoveContextEffectsLibraries(GetOwner());
 		}
+
+		if (ULyraSignificanceManager* SignificanceManager = USignificanceManager::Get<ULyraSignificanceManager>(World))
+		{
+			SignificanceManager->UnregisterObject(this);
+		}
 	}
 
 	Super::EndPlay(EndPlayReason);
@@ -58,9 +71,17 @@ void ULyraContextEffectComponent::AnimMotionEffect_Implementation(const FName Bo
 	const bool bHitSuccess, const FHitResult HitResult, FGameplayTagContainer Contexts,
 	FVector VFXScale, float AudioVolume, float AudioPitch)
 {
-	// Prep Components
-	TArray<UAudioComponent*> AudioComponentsToAdd;
-	TArray<UNiagaraComponent*> NiagaraComponentsToAdd;
+	// Less significant characters are limited in how often they spawn effects
+	if (EffectSpawnInterval > 0.0f)
+	{
+		const double CurrentTime = GetWorld()->GetTimeSeconds();
+		if ((CurrentTime - LastEffectSpawnTime) < EffectSpawnInterval)
+		{
+			return;
+		}
+
+		LastEffectSpawnTime = CurrentTime;
+	}
 
 	FGameplayTagContainer TotalContexts;
 
@@ -94,23 +115,9 @@ void ULyraContextEffectComponent::AnimMotionEffect_Implementation(const FName Bo
 		}
 	}
 
-	// Cycle through Active Audio Components and cache
-	for (UAudioComponent* ActiveAudioComponent : ActiveAudioComponents)
-	{
-		if (ActiveAudioComponent)
-		{
-			AudioComponentsToAdd.Add(ActiveAudioComponent);
-		}
-	}
-
-	// Cycle through Active Niagara Components and cache
-	for (UNiagaraComponent* ActiveNiagaraComponent : ActiveNiagaraComponents)
-	{
-		if (ActiveNiagaraComponent)
-		{
-			NiagaraComponentsToAdd.Add(ActiveNiagaraComponent);
-		}
-	}
+	// Drop components that finished, pooled ones are handed out again once they do
+	ActiveAudioComponents.RemoveAllSwap([](const UAudioComponent* AudioComponent) { return !IsValid(AudioComponent) || !AudioComponent->IsPlaying(); });
+	ActiveNiagaraComponents.RemoveAllSwap([](const UNiagaraComponent* NiagaraComponent) { return !IsValid(NiagaraComponent) || !NiagaraComponent->IsActive(); });
 
 	// Get World
 	if (const UWorld* World = GetWorld())
@@ -118,29 +125,12 @@ void ULyraContextEffectComponent::AnimMotionEffect_Implementation(const FName Bo
 		// Get Subsystem
 		if (ULyraContextEffectsSubsystem* LyraContextEffectsSubsystem = World->GetSubsystem<ULyraContextEffectsSubsystem>())
 		{
-			// Set up Audio Components and Niagara
-			TArray<UAudioComponent*> AudioComponents;
-			TArray<UNiagaraComponent*> NiagaraComponents;
-
-			// Spawn effects
+			// Spawn effects, appending them to the Active Components
 			LyraContextEffectsSubsystem->SpawnContextEffects(GetOwner(), StaticMeshComponent, Bone, 
 				LocationOffset, RotationOffset, MotionEffect, TotalContexts,
-				AudioComponents, NiagaraComponents, VFXScale, AudioVolume, AudioPitch);
-
-			// Append resultant effects
-			AudioComponentsToAdd.Append(AudioComponents);
-			NiagaraComponentsToAdd.Append(NiagaraComponents);
+				ActiveAudioComponents, ActiveNiagaraComponents, VFXScale, AudioVolume, AudioPitch);
 		}
 	}
-
-	// Append Active Audio Components
-	ActiveAudioComponents.Empty();
-	ActiveAudioComponents.Append(AudioComponentsToAdd);
-
-	// Append Active
-	ActiveNiagaraComponents.Empty();
-	ActiveNiagaraComponents.Append(NiagaraComponentsToAdd);
-
 }
 
 void ULyraContextEffectComponent::UpdateEffectContexts(FGameplayTagContainer NewEffectContexts)
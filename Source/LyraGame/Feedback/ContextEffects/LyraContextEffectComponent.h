@@ -55,6 +55,9 @@ public:
 	UFUNCTION(BlueprintCallable)
 	void UpdateLibraries(TSet<TSoftObjectPtr<ULyraContextEffectsLibrary>> NewContextEffectsLibraries);
 
+	// Minimum time between spawned effects, set by the significance manager.  0 is unlimited.
+	void SetEffectSpawnInterval(float InEffectSpawnInterval) { EffectSpawnInterval = InEffectSpawnInterval; }
+
 private:
 	UPROPERTY(Transient)
 	FGameplayTagContainer CurrentContexts;
@@ -67,4 +70,7 @@ private:
 
 	UPROPERTY(Transient)
 	TArray<UNiagaraComponent*> ActiveNiagaraComponents;
+
+	float EffectSpawnInterval = 0.0f;
+	double LastEffectSpawnTime = -DBL_MAX;
 };
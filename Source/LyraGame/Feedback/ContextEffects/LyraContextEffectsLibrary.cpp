@@ -45,7 +45,7 @@ void ULyraContextEffectsLibrary::LoadEffects()
 	}
 }
 
-EContextEffectsLibraryLoadState ULyraContextEffectsLibrary::GetContextEffectsLibraryLoadState()
+EContextEffectsLibraryLoadState ULyraContextEffectsLibrary::GetContextEffectsLibraryLoadState() const
 {
 	// Return current Load State
 	return EffectsLoadState;
@@ -111,6 +111,7 @@ void ULyraContextEffectsLibrary::LyraContextEffectLibraryLoadingComplete(
 {
 	// Flag data as loaded
 	EffectsLoadState = EContextEffectsLibraryLoadState::Loaded;
+	++LoadSerial;
 
 	// Append incoming Context Effects Array to current list of Active Context Effects
 	ActiveContextEffects.Append(LyraActiveContextEffects);
@@ -83,7 +83,10 @@ public:
 	UFUNCTION(BlueprintCallable)
 	void LoadEffects();
 
-	EContextEffectsLibraryLoadState GetContextEffectsLibraryLoadState();
+	EContextEffectsLibraryLoadState GetContextEffectsLibraryLoadState() const;
+
+	/** Bumped every time loading completes, so cached lookups can tell the Active Context Effects were rebuilt */
+	uint32 GetLoadSerial() const { return LoadSerial; }
 
 private:
 	void LoadEffectsInternal();
@@ -95,4 +98,6 @@ private:
 
 	UPROPERTY(Transient)
 	EContextEffectsLibraryLoadState EffectsLoadState = EContextEffectsLibraryLoadState::Unloaded;
+
+	uint32 LoadSerial = 0;
 };
@@ -2,9 +2,115 @@
 
 
 #include "LyraContextEffectsSubsystem.h"
-#include "Kismet/GameplayStatics.h"
 #include "NiagaraFunctionLibrary.h"
 #include "LyraContextEffectsLibrary.h"
+#include "Components/AudioComponent.h"
+#include "AudioDevice.h"
+#include "Sound/SoundBase.h"
+
+namespace LyraConsoleVariables
+{
+	static int32 MaxFreeContextEffectAudioComponents = 64;
+	static FAutoConsoleVariableRef CVarMaxFreeContextEffectAudioComponents(
+		TEXT("lyra.ContextEffects.MaxFreeAudioComponents"),
+		MaxFreeContextEffectAudioComponents,
+		TEXT("Number of finished context effect audio components kept around for reuse, any extra are destroyed"),
+		ECVF_Default);
+}
+
+FLyraContextEffectsCacheKey::FLyraContextEffectsCacheKey(const FGameplayTag InEffect, const FGameplayTagContainer& InContexts)
+	: Effect(InEffect)
+	, Contexts(InContexts)
+{
+	// Combine the context tags with a sum so the hash does not depend on the order they were added in
+	uint32 ContextsHash = 0;
+	for (const FGameplayTag& Context : Contexts.GetGameplayTagArray())
+	{
+		ContextsHash += GetTypeHash(Context);
+	}
+
+	Hash = HashCombine(GetTypeHash(Effect), ContextsHash);
+}
+
+const FLyraResolvedContextEffects& ULyraContextEffectsSet::ResolveEffects(const FGameplayTag Effect, const FGameplayTagContainer& Contexts)
+{
+	bool bAllLoaded = false;
+	const uint32 LoadSerial = GetLibrariesLoadSerial(/*out*/ bAllLoaded);
+
+	// Any library finishing a (re)load invalidates everything resolved so far
+	if (LoadSerial != ResolvedLibrariesLoadSerial)
+	{
+		ResolvedEffects.Reset();
+		ResolvedLibrariesLoadSerial = LoadSerial;
+	}
+
+	FLyraContextEffectsCacheKey Key(Effect, Contexts);
+	if (bAllLoaded)
+	{
+		if (const FLyraResolvedContextEffects* CachedEffects = ResolvedEffects.Find(Key))
+		{
+			return *CachedEffects;
+		}
+	}
+
+	// Gather Sounds and Niagara Systems from every loaded library
+	TArray<USoundBase*> Sounds;
+	TArray<UNiagaraSystem*> NiagaraSystems;
+
+	for (ULyraContextEffectsLibrary* EffectLibrary : LyraContextEffectsLibraries)
+	{
+		if (EffectLibrary && EffectLibrary->GetContextEffectsLibraryLoadState() == EContextEffectsLibraryLoadState::Loaded)
+		{
+			EffectLibrary->GetEffects(Effect, Contexts, Sounds, NiagaraSystems);
+		}
+		else if (EffectLibrary && EffectLibrary->GetContextEffectsLibraryLoadState() == EContextEffectsLibraryLoadState::Unloaded)
+		{
+			EffectLibrary->LoadEffects();
+		}
+	}
+
+	FLyraResolvedContextEffects& Resolved = bAllLoaded ? ResolvedEffects.Add(MoveTemp(Key)) : UncachedEffects;
+	Resolved.Sounds.Reset();
+	Resolved.Sounds.Append(Sounds);
+	Resolved.NiagaraSystems.Reset();
+	Resolved.NiagaraSystems.Append(NiagaraSystems);
+
+	return Resolved;
+}
+
+uint32 ULyraContextEffectsSet::GetLibrariesLoadSerial(bool& bOutAllLoaded) const
+{
+	bOutAllLoaded = true;
+
+	uint32 LoadSerial = 0;
+	for (const ULyraContextEffectsLibrary* EffectLibrary : LyraContextEffectsLibraries)
+	{
+		if (EffectLibrary)
+		{
+			bOutAllLoaded &= (EffectLibrary->GetContextEffectsLibraryLoadState() == EContextEffectsLibraryLoadState::Loaded);
+			LoadSerial = HashCombine(LoadSerial, EffectLibrary->GetLoadSerial());
+		}
+	}
+
+	return LoadSerial;
+}
+
+void ULyraContextEffectsSubsystem::Deinitialize()
+{
+	for (UAudioComponent* AudioComponent : PooledAudioComponents)
+	{
+		if (IsValid(AudioComponent))
+		{
+			AudioComponent->OnAudioFinishedNative.RemoveAll(this);
+			AudioComponent->DestroyComponent();
+		}
+	}
+
+	PooledAudioComponents.Empty();
+	FreeAudioComponents.Empty();
+
+	Super::Deinitialize();
+}
 
 void ULyraContextEffectsSubsystem::SpawnContextEffects(
 	const AActor* SpawningActor
@@ -20,56 +126,33 @@ void ULyraContextEffectsSubsystem::SpawnContextEffects(
 	, float AudioVolume
 	, float AudioPitch)
 {
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_LyraContextEffects_SpawnContextEffects);
+
 	// First determine if this Actor has a matching Set of Libraries
 	if (ULyraContextEffectsSet** EffectsLibrariesSetPtr = ActiveActorEffectsMap.Find(SpawningActor))
 	{
 		// Validate the pointers from the Map Find
 		if (ULyraContextEffectsSet* EffectsLibraries = *EffectsLibrariesSetPtr)
 		{
-			// Prepare Arrays for Sounds and Niagara Systems
-			TArray<USoundBase*> TotalSounds;
-			TArray<UNiagaraSystem*> TotalNiagaraSystems;
+			// Look up the Sounds and Niagara Systems for this Effect and Contexts
+			const FLyraResolvedContextEffects& ResolvedEffects = EffectsLibraries->ResolveEffects(Effect, Contexts);
 
-			// Cycle through Effect Libraries
-			for (ULyraContextEffectsLibrary* EffectLibrary : EffectsLibraries->LyraContextEffectsLibraries)
+			// Cycle through found Sounds
+			for (USoundBase* Sound : ResolvedEffects.Sounds)
 			{
-				// Check if the Effect Library is valid and data Loaded
-				if (EffectLibrary && EffectLibrary->GetContextEffectsLibraryLoadState() == EContextEffectsLibraryLoadState::Loaded)
-				{
-					// Set up local list of Sounds and Niagara Systems
-					TArray<USoundBase*> Sounds;
-					TArray<UNiagaraSystem*> NiagaraSystems;
-
-					// Get Sounds and Niagara Systems
-					EffectLibrary->GetEffects(Effect, Contexts, Sounds, NiagaraSystems);
-
-					// Append to accumulating array
-					TotalSounds.Append(Sounds);
-					TotalNiagaraSystems.Append(NiagaraSystems);
-				}
-				else if (EffectLibrary && EffectLibrary->GetContextEffectsLibraryLoadState() == EContextEffectsLibraryLoadState::Unloaded)
+				// Play Sounds Attached on a pooled Audio Component, add it to List of ACs
+				if (UAudioComponent* AudioComponent = PlayPooledSound(Sound, AttachToComponent, AttachPoint, LocationOffset, RotationOffset, AudioVolume, AudioPitch))
 				{
-					// Else load effects
-					EffectLibrary->LoadEffects();
+					AudioOut.Add(AudioComponent);
 				}
 			}
 
-			// Cycle through found Sounds
-			for (USoundBase* Sound : TotalSounds)
-			{
-				// Spawn Sounds Attached, add Audio Component to List of ACs
-				UAudioComponent* AudioComponent = UGameplayStatics::SpawnSoundAttached(Sound, AttachToComponent, AttachPoint, LocationOffset, RotationOffset, EAttachLocation::KeepRelativeOffset,
-					false, AudioVolume, AudioPitch, 0.0f, nullptr, nullptr, true);
-
-				AudioOut.Add(AudioComponent);
-			}
-
 			// Cycle through found Niagara Systems
-			for (UNiagaraSystem* NiagaraSystem : TotalNiagaraSystems)
+			for (UNiagaraSystem* NiagaraSystem : ResolvedEffects.NiagaraSystems)
 			{
-				// Spawn Niagara Systems Attached, add Niagara Component to List of NCs
+				// Spawn Niagara Systems Attached from the world's component pool, add Niagara Component to List of NCs
 				UNiagaraComponent* NiagaraComponent = UNiagaraFunctionLibrary::SpawnSystemAttached(NiagaraSystem, AttachToComponent, AttachPoint, LocationOffset,
-					RotationOffset, VFXScale, EAttachLocation::KeepRelativeOffset, true, ENCPoolMethod::None, true, true);
+					RotationOffset, VFXScale, EAttachLocation::KeepRelativeOffset, true, ENCPoolMethod::AutoRelease, true, true);
 
 				NiagaraOut.Add(NiagaraComponent);
 			}
@@ -77,6 +160,85 @@ void ULyraContextEffectsSubsystem::SpawnContextEffects(
 	}
 }
 
+UAudioComponent* ULyraContextEffectsSubsystem::PlayPooledSound(USoundBase* Sound, USceneComponent* AttachToComponent, const FName AttachPoint,
+	const FVector& LocationOffset, const FRotator& RotationOffset, float AudioVolume, float AudioPitch)
+{
+	UWorld* World = GetWorld();
+	if (Sound == nullptr || AttachToComponent == nullptr || World == nullptr)
+	{
+		return nullptr;
+	}
+
+	FAudioDeviceHandle AudioDevice = World->GetAudioDevice();
+	if (!AudioDevice.IsValid())
+	{
+		return nullptr;
+	}
+
+	// Like SpawnSoundAttached, don't bother with one shots that nobody can hear
+	if (!Sound->IsLooping())
+	{
+		const FVector TestLocation = AttachToComponent->GetSocketTransform(AttachPoint).TransformPosition(LocationOffset);
+		if (!AudioDevice->LocationIsAudible(TestLocation, Sound->GetMaxDistance()))
+		{
+			return nullptr;
+		}
+	}
+
+	UAudioComponent* AudioComponent = nullptr;
+	while (AudioComponent == nullptr && FreeAudioComponents.Num() > 0)
+	{
+		AudioComponent = FreeAudioComponents.Pop(/*bAllowShrinking=*/ false);
+		if (!IsValid(AudioComponent))
+		{
+			PooledAudioComponents.RemoveSwap(AudioComponent);
+			AudioComponent = nullptr;
+		}
+	}
+
+	if (AudioComponent == nullptr)
+	{
+		AudioComponent = NewObject<UAudioComponent>(World);
+		AudioComponent->bAutoActivate = false;
+		AudioComponent->bAutoDestroy = false;
+		AudioComponent->bStopWhenOwnerDestroyed = false;
+		AudioComponent->OnAudioFinishedNative.AddUObject(this, &ThisClass::OnPooledAudioFinished);
+		AudioComponent->RegisterComponentWithWorld(World);
+
+		PooledAudioComponents.Add(AudioComponent);
+	}
+
+	AudioComponent->AttachToComponent(AttachToComponent, FAttachmentTransformRules::KeepRelativeTransform, AttachPoint);
+	AudioComponent->SetRelativeLocationAndRotation(LocationOffset, RotationOffset);
+	AudioComponent->SetSound(Sound);
+	AudioComponent->SetVolumeMultiplier(AudioVolume);
+	AudioComponent->SetPitchMultiplier(AudioPitch);
+	AudioComponent->Play();
+
+	return AudioComponent;
+}
+
+void ULyraContextEffectsSubsystem::OnPooledAudioFinished(UAudioComponent* AudioComponent)
+{
+	if (!IsValid(AudioComponent))
+	{
+		return;
+	}
+
+	AudioComponent->DetachFromComponent(FDetachmentTransformRules::KeepRelativeTransform);
+
+	if (FreeAudioComponents.Num() < LyraConsoleVariables::MaxFreeContextEffectAudioComponents)
+	{
+		FreeAudioComponents.AddUnique(AudioComponent);
+	}
+	else
+	{
+		AudioComponent->OnAudioFinishedNative.RemoveAll(this);
+		PooledAudioComponents.RemoveSwap(AudioComponent);
+		AudioComponent->DestroyComponent();
+	}
+}
+
 bool ULyraContextEffectsSubsystem::GetContextFromSurfaceType(
 	TEnumAsByte<EPhysicalSurface> PhysicalSurface, FGameplayTag& Context)
 {
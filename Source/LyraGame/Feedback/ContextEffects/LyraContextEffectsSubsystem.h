@@ -12,6 +12,9 @@
 
 class ULyraContextEffectsLibrary;
 class UNiagaraComponent;
+class UNiagaraSystem;
+class USoundBase;
+class UAudioComponent;
 
 /**
  *
@@ -27,6 +30,36 @@ public:
 	TMap<TEnumAsByte<EPhysicalSurface>, FGameplayTag> SurfaceTypeToContextMap;
 };
 
+/** Sounds and Niagara Systems gathered from every library of a set for one effect and context combination */
+struct FLyraResolvedContextEffects
+{
+	TArray<USoundBase*, TInlineAllocator<4>> Sounds;
+	TArray<UNiagaraSystem*, TInlineAllocator<4>> NiagaraSystems;
+};
+
+/** Cache key for resolved effects, contexts compare as a set so tag order does not matter */
+struct FLyraContextEffectsCacheKey
+{
+	FLyraContextEffectsCacheKey(const FGameplayTag InEffect, const FGameplayTagContainer& InContexts);
+
+	bool operator==(const FLyraContextEffectsCacheKey& Other) const
+	{
+		return Hash == Other.Hash
+			&& Effect == Other.Effect
+			&& Contexts.Num() == Other.Contexts.Num()
+			&& Contexts.HasAllExact(Other.Contexts);
+	}
+
+	friend uint32 GetTypeHash(const FLyraContextEffectsCacheKey& Key)
+	{
+		return Key.Hash;
+	}
+
+	FGameplayTag Effect;
+	FGameplayTagContainer Contexts;
+	uint32 Hash;
+};
+
 /**
  *
  */
@@ -38,6 +71,23 @@ class LYRAGAME_API ULyraContextEffectsSet : public UObject
 public:
 	UPROPERTY(Transient)
 	TSet<ULyraContextEffectsLibrary*> LyraContextEffectsLibraries;
+
+	/**
+	 * Returns the effects matching Effect and Contexts across all libraries, caching the result.
+	 * Libraries that are not loaded yet are asked to load, and nothing is cached until all of them are.
+	 */
+	const FLyraResolvedContextEffects& ResolveEffects(const FGameplayTag Effect, const FGameplayTagContainer& Contexts);
+
+private:
+	uint32 GetLibrariesLoadSerial(bool& bOutAllLoaded) const;
+
+	// Resolved effects are raw pointers, they are kept alive by the Active Context Effects of our libraries
+	TMap<FLyraContextEffectsCacheKey, FLyraResolvedContextEffects> ResolvedEffects;
+
+	// Used when the libraries are still loading and the result can't be cached
+	FLyraResolvedContextEffects UncachedEffects;
+
+	uint32 ResolvedLibrariesLoadSerial = 0;
 };
 
 
@@ -50,7 +100,15 @@ class LYRAGAME_API ULyraContextEffectsSubsystem : public UWorldSubsystem
 	GENERATED_BODY()
 	
 public:
-	/** */
+	//~USubsystem interface
+	virtual void Deinitialize() override;
+	//~End of USubsystem interface
+
+	/**
+	 * Spawns the effects matching Effect and Contexts for the libraries registered to SpawningActor.
+	 * Audio components come from a pool owned by this subsystem and Niagara components from the world's
+	 * Niagara component pool, so the returned components are reused once they finish and should not be held on to.
+	 */
 	UFUNCTION(BlueprintCallable, Category = "ContextEffects")
 	void SpawnContextEffects(
 		const AActor* SpawningActor
@@ -79,8 +137,19 @@ public:
 	void UnloadAndRemoveContextEffectsLibraries(AActor* OwningActor);
 
 private:
+	UAudioComponent* PlayPooledSound(USoundBase* Sound, USceneComponent* AttachToComponent, const FName AttachPoint,
+		const FVector& LocationOffset, const FRotator& RotationOffset, float AudioVolume, float AudioPitch);
+
+	void OnPooledAudioFinished(UAudioComponent* AudioComponent);
 
 	UPROPERTY(Transient)
 	TMap<AActor*, ULyraContextEffectsSet*> ActiveActorEffectsMap;
 
+	// Every audio component created by the pool, playing or not
+	UPROPERTY(Transient)
+	TArray<UAudioComponent*> PooledAudioComponents;
+
+	// Pooled audio components that finished playing and can be reused
+	UPROPERTY(Transient)
+	TArray<UAudioComponent*> FreeAudioComponents;
 };
\ No newline at end of file
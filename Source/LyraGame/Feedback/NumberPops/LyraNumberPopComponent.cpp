@@ -5,4 +5,39 @@
 ULyraNumberPopComponent::ULyraNumberPopComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
+	for (double& LastPopTime : LastPopTimeByBucket)
+	{
+		LastPopTime = -DBL_MAX;
+	}
+}
+
+bool ULyraNumberPopComponent::ConsumeNumberPopBudget(const FLyraNumberPopRequest& NewRequest)
+{
+	if (NewRequest.bIsCriticalDamage)
+	{
+		return true;
+	}
+
+	const ULyraSignificanceManager* SignificanceManager = USignificanceManager::Get<ULyraSignificanceManager>(GetWorld());
+	if (!SignificanceManager)
+	{
+		return true;
+	}
+
+	const ELyraSignificanceBucket Bucket = SignificanceManager->GetBucketForLocation(NewRequest.WorldLocation);
+	const float SpawnInterval = SignificanceManager->GetBucketSettings(Bucket).EffectSpawnInterval;
+	if (SpawnInterval <= 0.0f)
+	{
+		return true;
+	}
+
+	const double CurrentTime = GetWorld()->GetTimeSeconds();
+	double& LastPopTime = LastPopTimeByBucket[(uint8)Bucket];
+	if ((CurrentTime - LastPopTime) < SpawnInterval)
+	{
+		return false;
+	}
+
+	LastPopTime = CurrentTime;
+	return true;
 }
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "Components/ControllerComponent.h"
 #include "GameplayTagContainer.h"
+#include "System/LyraSignificanceManager.h"
 
 #include "LyraNumberPopComponent.generated.h"
 
@@ -52,4 +53,14 @@ public:
 	/** Adds a damage number to the damage number list for visualization */
 	UFUNCTION(BlueprintCallable, Category = Foo)
 	virtual void AddNumberPop(const FLyraNumberPopRequest& NewRequest) {}
+
+protected:
+	/**
+	 * Returns false if the pop should be dropped because another one spawned too recently at a similar significance.
+	 * Critical hits are always shown.
+	 */
+	bool ConsumeNumberPopBudget(const FLyraNumberPopRequest& NewRequest);
+
+private:
+	double LastPopTimeByBucket[(uint8)ELyraSignificanceBucket::MAX];
 };
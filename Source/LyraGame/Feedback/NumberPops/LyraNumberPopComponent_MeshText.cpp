@@ -46,6 +46,11 @@ void ULyraNumberPopComponent_MeshText::AddNumberPop(const FLyraNumberPopRequest&
 		}
 	}
 
+	if (!ConsumeNumberPopBudget(NewRequest))
+	{
+		return;
+	}
+
 	FTempNumberPopInfo PreparedNumberInfo;
 
 	// Prepare the DamageNumberArray with the digits from the damage.
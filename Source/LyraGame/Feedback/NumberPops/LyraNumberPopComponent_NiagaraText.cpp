@@ -14,6 +14,11 @@ ULyraNumberPopComponent_NiagaraText::ULyraNumberPopComponent_NiagaraText(const F
 
 void ULyraNumberPopComponent_NiagaraText::AddNumberPop(const FLyraNumberPopRequest& NewRequest)
 {
+	if (!ConsumeNumberPopBudget(NewRequest))
+	{
+		return;
+	}
+
 	int32 LocalDamage = NewRequest.NumberToDisplay;
 
 	//Change Damage to negative to differentiate Critial vs Normal hit
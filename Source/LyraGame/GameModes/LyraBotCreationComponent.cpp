@@ -1,6 +1,7 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "LyraBotCreationComponent.h"
+#include "LyraLogChannels.h"
 #include "LyraGameMode.h"
 #include "Engine/World.h"
 #include "GameFramework/PlayerState.h"
@@ -13,6 +14,11 @@
 #include "AIController.h"
 #include "Kismet/GameplayStatics.h"
 #include "Character/LyraHealthComponent.h"
+#include "AbilitySystem/LyraAbilitySystemComponent.h"
+#include "BrainComponent.h"
+#include "Engine/Engine.h"
+#include "Navigation/PathFollowingComponent.h"
+#include "TimerManager.h"
 
 ULyraBotCreationComponent::ULyraBotCreationComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -30,6 +36,22 @@ void ULyraBotCreationComponent::BeginPlay()
 	ExperienceComponent->CallOrRegister_OnExperienceLoaded_LowPriority(FOnLyraExperienceLoaded::FDelegate::CreateUObject(this, &ThisClass::OnExperienceLoaded));
 }
 
+void ULyraBotCreationComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+#if WITH_SERVER_CODE
+	if (LoadTestRecorder.IsValid())
+	{
+		// The step in progress is incomplete, so it isn't written
+		GetWorld()->GetTimerManager().ClearTimer(LoadTestStepTimerHandle);
+		GetWorld()->GetTimerManager().ClearTimer(LoadTestBehaviorTimerHandle);
+		GEngine->RemovePerformanceDataConsumer(LoadTestRecorder);
+		LoadTestRecorder.Reset();
+	}
+#endif
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void ULyraBotCreationComponent::OnExperienceLoaded(const ULyraExperienceDefinition* Experience)
 {
 #if WITH_SERVER_CODE
@@ -51,6 +73,16 @@ void ULyraBotCreationComponent::ServerCreateBots()
 
 	RemainingBotNames = RandomBotNames;
 
+	// Load tests add their own bots in steps
+	if (AGameModeBase* GameModeBase = GetGameMode<AGameModeBase>())
+	{
+		if (UGameplayStatics::HasOption(GameModeBase->OptionsString, TEXT("BotLoadTest")))
+		{
+			ServerStartLoadTest();
+			return;
+		}
+	}
+
 	// Determine how many bots to spawn
 	int32 EffectiveBotCount = NumBotsToCreate;
 
@@ -163,4 +195,178 @@ void ULyraBotCreationComponent::RemoveOneBot()
 	}
 }
 
-#endif
\ No newline at end of file
+void ULyraBotCreationComponent::ServerStartLoadTest()
+{
+	AGameModeBase* GameModeBase = GetGameMode<AGameModeBase>();
+	check(GameModeBase);
+
+	LoadTestSettings = FLyraBotLoadTestSettings();
+	LoadTestSettings.ParseOptions(GameModeBase->OptionsString);
+
+	if (!LoadTestFireInputTag.IsValid())
+	{
+		LoadTestFireInputTag = FGameplayTag::RequestGameplayTag(TEXT("InputTag.Weapon.Fire"), /*ErrorIfNotFound=*/ false);
+	}
+	if (!LoadTestInteractInputTag.IsValid())
+	{
+		LoadTestInteractInputTag = FGameplayTag::RequestGameplayTag(TEXT("InputTag.Ability.Interact"), /*ErrorIfNotFound=*/ false);
+	}
+
+	LoadTestRecorder = MakeShared<FLyraBotLoadTestRecorder>(GetWorld(), LoadTestSettings);
+	GEngine->AddPerformanceDataConsumer(LoadTestRecorder);
+
+	UE_LOG(LogLyra, Log, TEXT("Starting bot load test: %d to %d bots in steps of %d, %.1f s per step, writing to %s"),
+		LoadTestSettings.StartBots, LoadTestSettings.MaxBots, LoadTestSettings.BotStep, LoadTestSettings.StepSeconds, *LoadTestRecorder->GetFilename());
+
+	if (LoadTestSettings.Behaviors != ELyraBotLoadTestBehavior::None)
+	{
+		GetWorld()->GetTimerManager().SetTimer(LoadTestBehaviorTimerHandle, this, &ThisClass::UpdateLoadTestBehaviors, LoadTestSettings.BehaviorInterval, /*bLoop=*/ true);
+	}
+
+	LoadTestStepIndex = 0;
+	StartNextLoadTestStep();
+}
+
+void ULyraBotCreationComponent::StartNextLoadTestStep()
+{
+	const int32 TargetBotCount = FMath::Min(LoadTestSettings.StartBots + (LoadTestStepIndex * LoadTestSettings.BotStep), LoadTestSettings.MaxBots);
+	for (int32 Count = SpawnedBotList.Num(); Count < TargetBotCount; ++Count)
+	{
+		SpawnOneBot();
+	}
+
+	// Spawning (and the new bots finding their feet) shouldn't count towards the step
+	if (LoadTestSettings.WarmupSeconds > 0.0f)
+	{
+		GetWorld()->GetTimerManager().SetTimer(LoadTestStepTimerHandle, this, &ThisClass::BeginLoadTestMeasurement, LoadTestSettings.WarmupSeconds, /*bLoop=*/ false);
+	}
+	else
+	{
+		BeginLoadTestMeasurement();
+	}
+}
+
+void ULyraBotCreationComponent::BeginLoadTestMeasurement()
+{
+	LoadTestRecorder->BeginStep(SpawnedBotList.Num());
+	GetWorld()->GetTimerManager().SetTimer(LoadTestStepTimerHandle, this, &ThisClass::EndLoadTestStep, LoadTestSettings.StepSeconds, /*bLoop=*/ false);
+}
+
+void ULyraBotCreationComponent::EndLoadTestStep()
+{
+	LoadTestRecorder->EndStep();
+
+	const bool bReachedMaxBots = (LoadTestSettings.StartBots + (LoadTestStepIndex * LoadTestSettings.BotStep)) >= LoadTestSettings.MaxBots;
+	++LoadTestStepIndex;
+
+	if (bReachedMaxBots)
+	{
+		FinishLoadTest();
+	}
+	else
+	{
+		StartNextLoadTestStep();
+	}
+}
+
+void ULyraBotCreationComponent::FinishLoadTest()
+{
+	GetWorld()->GetTimerManager().ClearTimer(LoadTestStepTimerHandle);
+	GetWorld()->GetTimerManager().ClearTimer(LoadTestBehaviorTimerHandle);
+
+	UE_LOG(LogLyra, Log, TEXT("Bot load test finished after %d steps, results written to %s"), LoadTestStepIndex, *LoadTestRecorder->GetFilename());
+
+	GEngine->RemovePerformanceDataConsumer(LoadTestRecorder);
+	LoadTestRecorder.Reset();
+
+	if (LoadTestSettings.bExitWhenDone)
+	{
+		FPlatformMisc::RequestExit(/*Force=*/ false);
+	}
+}
+
+void ULyraBotCreationComponent::UpdateLoadTestBehaviors()
+{
+	// Fire in bursts of one update, interact every few updates
+	const bool bPressFire = (LoadTestBehaviorUpdateCount % 2) == 0;
+	const bool bInteract = (LoadTestBehaviorUpdateCount % 4) == 0;
+	++LoadTestBehaviorUpdateCount;
+
+	TArray<APawn*> BotPawns;
+	BotPawns.Reserve(SpawnedBotList.Num());
+	for (AAIController* Bot : SpawnedBotList)
+	{
+		BotPawns.Add(Bot ? Bot->GetPawn() : nullptr);
+	}
+
+	for (int32 BotIndex = 0; BotIndex < SpawnedBotList.Num(); ++BotIndex)
+	{
+		AAIController* Bot = SpawnedBotList[BotIndex];
+		if ((Bot == nullptr) || (BotPawns[BotIndex] == nullptr))
+		{
+			continue;
+		}
+
+		// Any other bot will do as a target, the point is to generate the movement and combat traffic
+		APawn* TargetPawn = nullptr;
+		if (BotPawns.Num() > 1)
+		{
+			int32 TargetIndex = FMath::RandRange(0, BotPawns.Num() - 2);
+			if (TargetIndex >= BotIndex)
+			{
+				++TargetIndex;
+			}
+			TargetPawn = BotPawns[TargetIndex];
+		}
+
+		UpdateLoadTestBot(Bot, TargetPawn, bPressFire, bInteract);
+	}
+}
+
+void ULyraBotCreationComponent::UpdateLoadTestBot(AAIController* Bot, APawn* TargetPawn, bool bPressFire, bool bInteract)
+{
+	// The behavior tree would fight the scripted behaviors, and it's started again on every possession
+	if (UBrainComponent* BrainComponent = Bot->GetBrainComponent())
+	{
+		if (BrainComponent->IsRunning())
+		{
+			BrainComponent->StopLogic(TEXT("Bot load test"));
+		}
+	}
+
+	if (EnumHasAnyFlags(LoadTestSettings.Behaviors, ELyraBotLoadTestBehavior::Move) && TargetPawn && (Bot->GetMoveStatus() == EPathFollowingStatus::Idle))
+	{
+		Bot->MoveToActor(TargetPawn, /*AcceptanceRadius=*/ 500.0f);
+	}
+
+	ULyraPawnExtensionComponent* PawnExtComponent = ULyraPawnExtensionComponent::FindPawnExtensionComponent(Bot->GetPawn());
+	ULyraAbilitySystemComponent* LyraASC = PawnExtComponent ? PawnExtComponent->GetLyraAbilitySystemComponent() : nullptr;
+	if (LyraASC == nullptr)
+	{
+		return;
+	}
+
+	// Bots have no player controller to process ability input for them, so it's pressed and processed here
+	if (EnumHasAnyFlags(LoadTestSettings.Behaviors, ELyraBotLoadTestBehavior::Fire) && LoadTestFireInputTag.IsValid())
+	{
+		if (bPressFire && TargetPawn)
+		{
+			Bot->SetFocus(TargetPawn);
+			LyraASC->AbilityInputTagPressed(LoadTestFireInputTag);
+		}
+		else
+		{
+			LyraASC->AbilityInputTagReleased(LoadTestFireInputTag);
+		}
+	}
+
+	if (EnumHasAnyFlags(LoadTestSettings.Behaviors, ELyraBotLoadTestBehavior::Interact) && bInteract && LoadTestInteractInputTag.IsValid())
+	{
+		LyraASC->AbilityInputTagPressed(LoadTestInteractInputTag);
+		LyraASC->AbilityInputTagReleased(LoadTestInteractInputTag);
+	}
+
+	LyraASC->ProcessAbilityInput(LoadTestSettings.BehaviorInterval, /*bGamePaused=*/ false);
+}
+
+#endif
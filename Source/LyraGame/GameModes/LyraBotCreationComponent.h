@@ -4,12 +4,15 @@
 
 #include "CoreMinimal.h"
 #include "Components/GameStateComponent.h"
+#include "GameplayTagContainer.h"
+#include "Performance/LyraBotLoadTestRecorder.h"
 
 #include "LyraBotCreationComponent.generated.h"
 
 class ULyraExperienceDefinition;
 class ULyraPawnData;
 class AAIController;
+class APawn;
 
 UCLASS(Blueprintable, Abstract)
 class ULyraBotCreationComponent : public UGameStateComponent
@@ -21,6 +24,7 @@ public:
 
 	//~UActorComponent interface
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	//~End of UActorComponent interface
 
 private:
@@ -38,6 +42,14 @@ protected:
 
 	TArray<FString> RemainingBotNames;
 
+	// Input tag pressed by bots that fire during a bot load test (InputTag.Weapon.Fire if not set)
+	UPROPERTY(EditDefaultsOnly, Category=LoadTest, meta=(Categories="InputTag"))
+	FGameplayTag LoadTestFireInputTag;
+
+	// Input tag pressed by bots that interact during a bot load test (InputTag.Ability.Interact if not set)
+	UPROPERTY(EditDefaultsOnly, Category=LoadTest, meta=(Categories="InputTag"))
+	FGameplayTag LoadTestInteractInputTag;
+
 protected:
 	UPROPERTY(Transient)
 	TArray<TObjectPtr<AAIController>> SpawnedBotList;
@@ -54,5 +66,26 @@ protected:
 	virtual void RemoveOneBot();
 
 	FString CreateBotName(int32 PlayerIndex);
+
+	// Bot load test, started instead of the normal bots with ?BotLoadTest on the URL (see FLyraBotLoadTestSettings).
+	// Adds bots in steps and records the server frame times of each step to a CSV in the profiling directory, works
+	// the same on a headless dedicated server.
+	virtual void ServerStartLoadTest();
+	void StartNextLoadTestStep();
+	void BeginLoadTestMeasurement();
+	void EndLoadTestStep();
+	void FinishLoadTest();
+
+	// Drives the bots with the scripted load test behaviors in place of their AI
+	void UpdateLoadTestBehaviors();
+	void UpdateLoadTestBot(AAIController* Bot, APawn* TargetPawn, bool bPressFire, bool bInteract);
+
+private:
+	FLyraBotLoadTestSettings LoadTestSettings;
+	TSharedPtr<FLyraBotLoadTestRecorder> LoadTestRecorder;
+	FTimerHandle LoadTestStepTimerHandle;
+	FTimerHandle LoadTestBehaviorTimerHandle;
+	int32 LoadTestStepIndex = 0;
+	int32 LoadTestBehaviorUpdateCount = 0;
 #endif
 };
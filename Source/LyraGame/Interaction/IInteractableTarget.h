@@ -46,6 +46,12 @@ public:
 	/**  */
 	virtual void GatherInteractionOptions(const FInteractionQuery& InteractQuery, FInteractionOptionBuilder& OptionBuilder) = 0;
 
+	/**
+	 * Return true if the options gathered don't depend on the query, so the interaction subsystem can cache them.
+	 * Call ULyraInteractionSubsystem::NotifyInteractionOptionsChanged when they change.
+	 */
+	virtual bool CanCacheInteractionOptions() const { return false; }
+
 	/**  */
 	virtual void CustomizeInteractionEventData(const FGameplayTag& InteractionEventTag, FGameplayEventData& InOutEventData) { }
 };
@@ -0,0 +1,302 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LyraInteractionSubsystem.h"
+#include "Interaction/IInteractableTarget.h"
+#include "Interaction/InteractionQuery.h"
+#include "Interaction/InteractionStatics.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+namespace LyraInteraction
+{
+	static bool bSpatialQueries = true;
+	static FAutoConsoleVariableRef CVarSpatialQueries(TEXT("lyra.Interaction.SpatialQueries"), bSpatialQueries, TEXT("If set, interaction scans query the interaction subsystem's spatial hash instead of running an overlap or trace per pawn."), ECVF_Default);
+}
+
+bool ULyraInteractionSubsystem::AreSpatialQueriesEnabled()
+{
+	return LyraInteraction::bSpatialQueries;
+}
+
+void ULyraInteractionSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &ThisClass::OnWorldPostActorTick);
+}
+
+void ULyraInteractionSubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+
+	Interactables.Empty();
+	InteractableIndices.Empty();
+	Cells.Empty();
+	CachedOptions.Empty();
+	Scans.Empty();
+
+	Super::Deinitialize();
+}
+
+void ULyraInteractionSubsystem::RegisterInteractable(TScriptInterface<IInteractableTarget> Target)
+{
+	UObject* TargetObject = Target.GetObject();
+	if (!TargetObject || InteractableIndices.Contains(TargetObject))
+	{
+		return;
+	}
+
+	AActor* Actor = UInteractionStatics::GetActorFromInteractableTarget(Target);
+	if (!Actor)
+	{
+		return;
+	}
+
+	// The bounds stand in for the shape the interaction overlap used to hit
+	FVector BoundsOrigin;
+	FVector BoundsExtent;
+	Actor->GetActorBounds(/*bOnlyCollidingComponents=*/ true, /*out*/ BoundsOrigin, /*out*/ BoundsExtent);
+
+	const int32 InteractableIndex = Interactables.Add(FRegisteredInteractable());
+	FRegisteredInteractable& Entry = Interactables[InteractableIndex];
+	Entry.TargetObject = TargetObject;
+	Entry.TargetKey = TargetObject;
+	Entry.Actor = Actor;
+	Entry.BoundsOffset = BoundsOrigin - Actor->GetActorLocation();
+	Entry.Location = BoundsOrigin;
+	Entry.Radius = BoundsExtent.Size();
+	Entry.Cell = GetCell(Entry.Location);
+
+	InteractableIndices.Add(TargetObject, InteractableIndex);
+	Cells.FindOrAdd(Entry.Cell).Add(InteractableIndex);
+	MaxInteractableRadius = FMath::Max(MaxInteractableRadius, Entry.Radius);
+}
+
+void ULyraInteractionSubsystem::UnregisterInteractable(TScriptInterface<IInteractableTarget> Target)
+{
+	int32 InteractableIndex = INDEX_NONE;
+	if (InteractableIndices.RemoveAndCopyValue(Target.GetObject(), InteractableIndex))
+	{
+		RemoveInteractable(InteractableIndex);
+	}
+}
+
+void ULyraInteractionSubsystem::RemoveInteractable(int32 InteractableIndex)
+{
+	FRegisteredInteractable& Entry = Interactables[InteractableIndex];
+
+	if (TArray<int32>* CellInteractables = Cells.Find(Entry.Cell))
+	{
+		CellInteractables->RemoveSingleSwap(InteractableIndex, false);
+		if (CellInteractables->IsEmpty())
+		{
+			Cells.Remove(Entry.Cell);
+		}
+	}
+
+	CachedOptions.Remove(Entry.TargetKey);
+	Interactables.RemoveAt(InteractableIndex);
+}
+
+void ULyraInteractionSubsystem::NotifyInteractionOptionsChanged(UObject* TargetObject)
+{
+	CachedOptions.Remove(TargetObject);
+}
+
+void ULyraInteractionSubsystem::GatherInteractionOptions(const TScriptInterface<IInteractableTarget>& Target, const FInteractionQuery& InteractQuery, TArray<FInteractionOption>& OutOptions)
+{
+	UObject* TargetObject = Target.GetObject();
+	if (!TargetObject)
+	{
+		return;
+	}
+
+	// Only registered targets are cached, unregistering is what clears their entry
+	if (!Target->CanCacheInteractionOptions() || !InteractableIndices.Contains(TargetObject))
+	{
+		FInteractionOptionBuilder InteractionBuilder(Target, OutOptions);
+		Target->GatherInteractionOptions(InteractQuery, InteractionBuilder);
+		return;
+	}
+
+	TArray<FInteractionOption>* Options = CachedOptions.Find(TargetObject);
+	if (!Options)
+	{
+		Options = &CachedOptions.Add(TargetObject);
+		FInteractionOptionBuilder InteractionBuilder(Target, *Options);
+		Target->GatherInteractionOptions(InteractQuery, InteractionBuilder);
+	}
+
+	OutOptions.Append(*Options);
+}
+
+FIntPoint ULyraInteractionSubsystem::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
+
+template <typename FunctionType>
+void ULyraInteractionSubsystem::ForEachInteractableNear(const FVector& Center, float Radius, FunctionType&& Function) const
+{
+	const float PaddedRadius = Radius + MaxInteractableRadius;
+	const FIntPoint MinCell = GetCell(Center - FVector(PaddedRadius, PaddedRadius, 0.0f));
+	const FIntPoint MaxCell = GetCell(Center + FVector(PaddedRadius, PaddedRadius, 0.0f));
+
+	for (int32 CellX = MinCell.X; CellX <= MaxCell.X; ++CellX)
+	{
+		for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; ++CellY)
+		{
+			const TArray<int32>* CellInteractables = Cells.Find(FIntPoint(CellX, CellY));
+			if (!CellInteractables)
+			{
+				continue;
+			}
+
+			for (const int32 InteractableIndex : *CellInteractables)
+			{
+				const FRegisteredInteractable& Entry = Interactables[InteractableIndex];
+				if (FVector::DistSquared(Center, Entry.Location) <= FMath::Square(Radius + Entry.Radius))
+				{
+					if (!Function(Entry))
+					{
+						return;
+					}
+				}
+			}
+		}
+	}
+}
+
+void ULyraInteractionSubsystem::QueryInteractables(const FVector& Center, float Radius, TArray<TScriptInterface<IInteractableTarget>>& OutTargets) const
+{
+	ForEachInteractableNear(Center, Radius, [&OutTargets](const FRegisteredInteractable& Entry)
+	{
+		if (UObject* TargetObject = Entry.TargetObject.Get())
+		{
+			OutTargets.Emplace(TargetObject);
+		}
+		return true;
+	});
+}
+
+bool ULyraInteractionSubsystem::HasInteractablesNear(const FVector& Center, float Radius) const
+{
+	bool bFound = false;
+	ForEachInteractableNear(Center, Radius, [&bFound](const FRegisteredInteractable& Entry)
+	{
+		bFound = Entry.TargetObject.IsValid();
+		return !bFound;
+	});
+
+	return bFound;
+}
+
+int32 ULyraInteractionSubsystem::RegisterScan(AActor* Avatar, float ScanRange, float ScanRate, FLyraInteractionScanDelegate Delegate)
+{
+	check(Avatar);
+
+	const int32 ScanHandle = Scans.Add(FInteractionScan());
+	FInteractionScan& Scan = Scans[ScanHandle];
+	Scan.Avatar = Avatar;
+	Scan.ScanRange = ScanRange;
+	Scan.ScanRate = ScanRate;
+	Scan.NextScanTime = GetWorld()->GetTimeSeconds();
+	Scan.Delegate = MoveTemp(Delegate);
+
+	return ScanHandle;
+}
+
+void ULyraInteractionSubsystem::UnregisterScan(int32 ScanHandle)
+{
+	if (Scans.IsValidIndex(ScanHandle))
+	{
+		Scans.RemoveAt(ScanHandle);
+	}
+}
+
+void ULyraInteractionSubsystem::RefreshInteractableLocations()
+{
+	for (auto It = Interactables.CreateIterator(); It; ++It)
+	{
+		FRegisteredInteractable& Entry = *It;
+		const AActor* Actor = Entry.Actor.Get();
+		if (!Actor || !Entry.TargetObject.IsValid())
+		{
+			// Targets that were destroyed without unregistering
+			InteractableIndices.Remove(Entry.TargetKey);
+			RemoveInteractable(It.GetIndex());
+			continue;
+		}
+
+		Entry.Location = Actor->GetActorLocation() + Entry.BoundsOffset;
+
+		const FIntPoint NewCell = GetCell(Entry.Location);
+		if (NewCell != Entry.Cell)
+		{
+			if (TArray<int32>* OldCellInteractables = Cells.Find(Entry.Cell))
+			{
+				OldCellInteractables->RemoveSingleSwap(It.GetIndex(), false);
+				if (OldCellInteractables->IsEmpty())
+				{
+					Cells.Remove(Entry.Cell);
+				}
+			}
+
+			Cells.FindOrAdd(NewCell).Add(It.GetIndex());
+			Entry.Cell = NewCell;
+		}
+	}
+}
+
+void ULyraInteractionSubsystem::OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if ((World != GetWorld()) || (Scans.Num() == 0))
+	{
+		return;
+	}
+
+	const double CurrentTime = World->GetTimeSeconds();
+
+	DueScans.Reset();
+	for (auto It = Scans.CreateConstIterator(); It; ++It)
+	{
+		if (It->NextScanTime <= CurrentTime)
+		{
+			DueScans.Add(It.GetIndex());
+		}
+	}
+
+	if (DueScans.Num() == 0)
+	{
+		return;
+	}
+
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_LyraInteractionSubsystem_Scan);
+
+	RefreshInteractableLocations();
+
+	for (const int32 ScanHandle : DueScans)
+	{
+		// Earlier callbacks in this pass may have unregistered (or replaced) the scan
+		if (!Scans.IsValidIndex(ScanHandle) || (Scans[ScanHandle].NextScanTime > CurrentTime))
+		{
+			continue;
+		}
+
+		FInteractionScan& Scan = Scans[ScanHandle];
+		Scan.NextScanTime = CurrentTime + Scan.ScanRate;
+
+		const AActor* Avatar = Scan.Avatar.Get();
+		if (!Avatar)
+		{
+			continue;
+		}
+
+		ScanResults.Reset();
+		QueryInteractables(Avatar->GetActorLocation(), Scan.ScanRange, /*out*/ ScanResults);
+
+		// Copied, the callback is allowed to unregister its scan
+		const FLyraInteractionScanDelegate Delegate = Scan.Delegate;
+		Delegate.ExecuteIfBound(ScanResults);
+	}
+}
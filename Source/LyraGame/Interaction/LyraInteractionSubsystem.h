@@ -0,0 +1,116 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "Interaction/InteractionOption.h"
+
+#include "LyraInteractionSubsystem.generated.h"
+
+class IInteractableTarget;
+struct FInteractionQuery;
+
+/** Called with the interactables in range of a scan's avatar, the array is only valid for the duration of the call */
+DECLARE_DELEGATE_OneParam(FLyraInteractionScanDelegate, const TArray<TScriptInterface<IInteractableTarget>>& /*InteractableTargets*/);
+
+/**
+ * ULyraInteractionSubsystem
+ *
+ * Keeps the interactable targets of a world in a spatial hash so "interactables near X" can be answered without
+ * a scene query.  Pawns register a scan instead of each running a sphere overlap on their own timer; all scans
+ * that are due are answered in a single pass after actors have ticked.
+ *
+ * Interactable targets must register themselves to be found.  Targets whose options don't depend on the query
+ * can opt in to having their options cached (see IInteractableTarget::CanCacheInteractionOptions), and call
+ * NotifyInteractionOptionsChanged when they change.
+ */
+UCLASS(Config=Game)
+class LYRAGAME_API ULyraInteractionSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Returns false if the old per-pawn overlaps and traces should be used instead (lyra.Interaction.SpatialQueries) */
+	static bool AreSpatialQueriesEnabled();
+
+	//~USubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~End of USubsystem interface
+
+	void RegisterInteractable(TScriptInterface<IInteractableTarget> Target);
+	void UnregisterInteractable(TScriptInterface<IInteractableTarget> Target);
+
+	/** Drops the cached options of the target, so they are gathered again the next time they are needed */
+	void NotifyInteractionOptionsChanged(UObject* TargetObject);
+
+	/** Appends the interaction options of the target to OutOptions, from the cache if the target allows it */
+	void GatherInteractionOptions(const TScriptInterface<IInteractableTarget>& Target, const FInteractionQuery& InteractQuery, TArray<FInteractionOption>& OutOptions);
+
+	/** Appends the registered targets whose bounds are within Radius of Center */
+	void QueryInteractables(const FVector& Center, float Radius, TArray<TScriptInterface<IInteractableTarget>>& OutTargets) const;
+
+	/** Returns true if any registered target has bounds within Radius of Center */
+	bool HasInteractablesNear(const FVector& Center, float Radius) const;
+
+	/** Starts calling Delegate every ScanRate seconds with the interactables in ScanRange of the avatar, returns a handle for UnregisterScan */
+	int32 RegisterScan(AActor* Avatar, float ScanRange, float ScanRate, FLyraInteractionScanDelegate Delegate);
+	void UnregisterScan(int32 ScanHandle);
+
+protected:
+	/** Size of the spatial hash cells on the XY plane, roughly the largest interaction scan range works well */
+	UPROPERTY(Config, EditAnywhere, Category = "Interaction")
+	float CellSize = 500.0f;
+
+private:
+	struct FRegisteredInteractable
+	{
+		TWeakObjectPtr<UObject> TargetObject;
+		TObjectKey<UObject> TargetKey;
+		TWeakObjectPtr<AActor> Actor;
+		FVector BoundsOffset = FVector::ZeroVector;
+		FVector Location = FVector::ZeroVector;
+		float Radius = 0.0f;
+		FIntPoint Cell = FIntPoint::ZeroValue;
+	};
+
+	struct FInteractionScan
+	{
+		TWeakObjectPtr<AActor> Avatar;
+		float ScanRange = 0.0f;
+		float ScanRate = 0.0f;
+		double NextScanTime = 0.0;
+		FLyraInteractionScanDelegate Delegate;
+	};
+
+	FIntPoint GetCell(const FVector& Location) const;
+
+	template <typename FunctionType>
+	void ForEachInteractableNear(const FVector& Center, float Radius, FunctionType&& Function) const;
+
+	void RemoveInteractable(int32 InteractableIndex);
+
+	/** Moves registered targets whose actor has moved into their new cell, done once per scan pass */
+	void RefreshInteractableLocations();
+
+	void OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+
+	TSparseArray<FRegisteredInteractable> Interactables;
+	TMap<TObjectKey<UObject>, int32> InteractableIndices;
+	TMap<FIntPoint, TArray<int32>> Cells;
+
+	/** Largest bounds radius of any registered target, used to pad the queried cells */
+	float MaxInteractableRadius = 0.0f;
+
+	TMap<TObjectKey<UObject>, TArray<FInteractionOption>> CachedOptions;
+
+	TSparseArray<FInteractionScan> Scans;
+
+	/** Reused by every scan pass */
+	TArray<int32> DueScans;
+	TArray<TScriptInterface<IInteractableTarget>> ScanResults;
+
+	FDelegateHandle PostActorTickHandle;
+};
@@ -6,6 +6,7 @@
 #include "Interaction/IInteractableTarget.h"
 #include "Interaction/InteractionStatics.h"
 #include "Interaction/InteractionQuery.h"
+#include "Interaction/LyraInteractionSubsystem.h"
 #include "AbilitySystemComponent.h"
 #include "TimerManager.h"
 #include "GameFramework/Controller.h"
@@ -28,7 +29,17 @@ void UAbilityTask_GrantNearbyInteraction::Activate()
 	SetWaitingOnAvatar();
 
 	UWorld* World = GetWorld();
-	World->GetTimerManager().SetTimer(QueryTimerHandle, this, &ThisClass::QueryInteractables, InteractionScanRate, true);
+	AActor* ActorOwner = GetAvatarActor();
+
+	ULyraInteractionSubsystem* InteractionSubsystem = World->GetSubsystem<ULyraInteractionSubsystem>();
+	if (InteractionSubsystem && ActorOwner && ULyraInteractionSubsystem::AreSpatialQueriesEnabled())
+	{
+		ScanHandle = InteractionSubsystem->RegisterScan(ActorOwner, InteractionScanRange, InteractionScanRate, FLyraInteractionScanDelegate::CreateUObject(this, &ThisClass::OnInteractablesScanned));
+	}
+	else
+	{
+		World->GetTimerManager().SetTimer(QueryTimerHandle, this, &ThisClass::QueryInteractables, InteractionScanRate, true);
+	}
 }
 
 void UAbilityTask_GrantNearbyInteraction::OnDestroy(bool AbilityEnded)
@@ -37,6 +48,12 @@ void UAbilityTask_GrantNearbyInteraction::OnDestroy(bool AbilityEnded)
 
 	UWorld* World = GetWorld();
 	World->GetTimerManager().ClearTimer(QueryTimerHandle);
+
+	if (ULyraInteractionSubsystem* InteractionSubsystem = World->GetSubsystem<ULyraInteractionSubsystem>())
+	{
+		InteractionSubsystem->UnregisterScan(ScanHandle);
+	}
+	ScanHandle = INDEX_NONE;
 }
 
 void UAbilityTask_GrantNearbyInteraction::QueryInteractables()
@@ -55,32 +72,60 @@ void UAbilityTask_GrantNearbyInteraction::QueryInteractables()
 		{
 			TArray<TScriptInterface<IInteractableTarget>> InteractableTargets;
 			UInteractionStatics::AppendInteractableTargetsFromOverlapResults(OverlapResults, OUT InteractableTargets);
-			
-			FInteractionQuery InteractionQuery;
-			InteractionQuery.RequestingAvatar = ActorOwner;
-			InteractionQuery.RequestingController = Cast<AController>(ActorOwner->GetOwner());
 
-			TArray<FInteractionOption> Options;
-			for (TScriptInterface<IInteractableTarget>& InteractiveTarget : InteractableTargets)
-			{
-				FInteractionOptionBuilder InteractionBuilder(InteractiveTarget, Options);
-				InteractiveTarget->GatherInteractionOptions(InteractionQuery, InteractionBuilder);
-			}
+			GrantAbilitiesForInteractables(InteractableTargets);
+		}
+	}
+}
 
-			// Check if any of the options need to grant the ability to the user before they can be used.
-			for (FInteractionOption& Option : Options)
+void UAbilityTask_GrantNearbyInteraction::OnInteractablesScanned(const TArray<TScriptInterface<IInteractableTarget>>& InteractableTargets)
+{
+	if (InteractableTargets.Num() > 0)
+	{
+		GrantAbilitiesForInteractables(InteractableTargets);
+	}
+}
+
+void UAbilityTask_GrantNearbyInteraction::GrantAbilitiesForInteractables(const TArray<TScriptInterface<IInteractableTarget>>& InteractableTargets)
+{
+	AActor* ActorOwner = GetAvatarActor();
+	if (!ActorOwner)
+	{
+		return;
+	}
+
+	FInteractionQuery InteractionQuery;
+	InteractionQuery.RequestingAvatar = ActorOwner;
+	InteractionQuery.RequestingController = Cast<AController>(ActorOwner->GetOwner());
+
+	ULyraInteractionSubsystem* InteractionSubsystem = GetWorld()->GetSubsystem<ULyraInteractionSubsystem>();
+
+	Options.Reset();
+	for (const TScriptInterface<IInteractableTarget>& InteractiveTarget : InteractableTargets)
+	{
+		if (InteractionSubsystem)
+		{
+			InteractionSubsystem->GatherInteractionOptions(InteractiveTarget, InteractionQuery, OUT Options);
+		}
+		else
+		{
+			FInteractionOptionBuilder InteractionBuilder(InteractiveTarget, Options);
+			InteractiveTarget->GatherInteractionOptions(InteractionQuery, InteractionBuilder);
+		}
+	}
+
+	// Check if any of the options need to grant the ability to the user before they can be used.
+	for (FInteractionOption& Option : Options)
+	{
+		if (Option.InteractionAbilityToGrant)
+		{
+			// Grant the ability to the GAS, otherwise it won't be able to do whatever the interaction is.
+			FObjectKey ObjectKey(Option.InteractionAbilityToGrant);
+			if (!InteractionAbilityCache.Find(ObjectKey))
 			{
-				if (Option.InteractionAbilityToGrant)
-				{
-					// Grant the ability to the GAS, otherwise it won't be able to do whatever the interaction is.
-					FObjectKey ObjectKey(Option.InteractionAbilityToGrant);
-					if (!InteractionAbilityCache.Find(ObjectKey))
-					{
-						FGameplayAbilitySpec Spec(Option.InteractionAbilityToGrant, 1, INDEX_NONE, this);
-						FGameplayAbilitySpecHandle Handle = AbilitySystemComponent->GiveAbility(Spec);
-						InteractionAbilityCache.Add(ObjectKey, Handle);
-					}
-				}
+				FGameplayAbilitySpec Spec(Option.InteractionAbilityToGrant, 1, INDEX_NONE, this);
+				FGameplayAbilitySpecHandle Handle = AbilitySystemComponent->GiveAbility(Spec);
+				InteractionAbilityCache.Add(ObjectKey, Handle);
 			}
 		}
 	}
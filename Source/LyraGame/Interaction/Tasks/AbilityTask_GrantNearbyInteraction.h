@@ -4,10 +4,12 @@
 #include "CoreMinimal.h"
 #include "UObject/ObjectMacros.h"
 #include "Abilities/Tasks/AbilityTask.h"
+#include "Interaction/InteractionOption.h"
 #include "AbilityTask_GrantNearbyInteraction.generated.h"
 
 class AActor;
 class UPrimitiveComponent;
+class IInteractableTarget;
 
 UCLASS()
 class UAbilityTask_GrantNearbyInteraction : public UAbilityTask
@@ -26,10 +28,20 @@ private:
 
 	void QueryInteractables();
 
+	/** Scan results from the interaction subsystem, replaces QueryInteractables when spatial queries are enabled */
+	void OnInteractablesScanned(const TArray<TScriptInterface<IInteractableTarget>>& InteractableTargets);
+
+	void GrantAbilitiesForInteractables(const TArray<TScriptInterface<IInteractableTarget>>& InteractableTargets);
+
 	float InteractionScanRange = 100;
 	float InteractionScanRate = 0.100;
 
 	FTimerHandle QueryTimerHandle;
 
+	int32 ScanHandle = INDEX_NONE;
+
+	/** Reused between scans */
+	TArray<FInteractionOption> Options;
+
 	TMap<FObjectKey, FGameplayAbilitySpecHandle> InteractionAbilityCache;
 };
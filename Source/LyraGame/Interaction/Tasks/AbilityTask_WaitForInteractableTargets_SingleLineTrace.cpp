@@ -6,6 +6,7 @@
 #include "Interaction/IInteractableTarget.h"
 #include "Interaction/InteractionStatics.h"
 #include "Interaction/InteractionQuery.h"
+#include "Interaction/LyraInteractionSubsystem.h"
 #include "AbilitySystemComponent.h"
 #include "TimerManager.h"
 
@@ -53,6 +54,19 @@ void UAbilityTask_WaitForInteractableTargets_SingleLineTrace::PerformTrace()
 
 	UWorld* World = GetWorld();
 
+	FVector TraceStart = StartLocation.GetTargetingTransform().GetLocation();
+
+	// Nothing registered can be hit, skip the trace
+	if (ULyraInteractionSubsystem::AreSpatialQueriesEnabled())
+	{
+		const ULyraInteractionSubsystem* InteractionSubsystem = World->GetSubsystem<ULyraInteractionSubsystem>();
+		if (InteractionSubsystem && !InteractionSubsystem->HasInteractablesNear(TraceStart, InteractionScanRange))
+		{
+			UpdateInteractableOptions(InteractionQuery, TArray<TScriptInterface<IInteractableTarget>>());
+			return;
+		}
+	}
+
 	TArray<AActor*> ActorsToIgnore;
 	ActorsToIgnore.Add(AvatarActor);
 
@@ -60,7 +74,6 @@ void UAbilityTask_WaitForInteractableTargets_SingleLineTrace::PerformTrace()
 	FCollisionQueryParams Params(SCENE_QUERY_STAT(UAbilityTask_WaitForInteractableTargets_SingleLineTrace), bTraceComplex);
 	Params.AddIgnoredActors(ActorsToIgnore);
 
-	FVector TraceStart = StartLocation.GetTargetingTransform().GetLocation();
 	FVector TraceEnd;
 	AimWithPlayerController(AvatarActor, Params, TraceStart, InteractionScanRange, OUT TraceEnd);
 
@@ -30,6 +30,9 @@ FString FLyraInventoryEntry::GetDebugString() const
 
 void FLyraInventoryList::PreReplicatedRemove(const TArrayView<int32> RemovedIndices, int32 FinalSize)
 {
+	// The removed entries are swapped out after this, so every index can change
+	bDefinitionIndexStale = true;
+
 	for (int32 Index : RemovedIndices)
 	{
 		FLyraInventoryEntry& Stack = Entries[Index];
@@ -40,6 +43,8 @@ void FLyraInventoryList::PreReplicatedRemove(const TArrayView<int32> RemovedIndi
 
 void FLyraInventoryList::PostReplicatedAdd(const TArrayView<int32> AddedIndices, int32 FinalSize)
 {
+	bDefinitionIndexStale = true;
+
 	for (int32 Index : AddedIndices)
 	{
 		FLyraInventoryEntry& Stack = Entries[Index];
@@ -50,6 +55,8 @@ void FLyraInventoryList::PostReplicatedAdd(const TArrayView<int32> AddedIndices,
 
 void FLyraInventoryList::PostReplicatedChange(const TArrayView<int32> ChangedIndices, int32 FinalSize)
 {
+	bDefinitionIndexStale = true;
+
 	for (int32 Index : ChangedIndices)
 	{
 		FLyraInventoryEntry& Stack = Entries[Index];
@@ -95,6 +102,11 @@ ULyraInventoryItemInstance* FLyraInventoryList::AddEntry(TSubclassOf<ULyraInvent
 	NewEntry.StackCount = StackCount;
 	Result = NewEntry.Instance;
 
+	if (!bDefinitionIndexStale)
+	{
+		DefinitionToEntryIndices.FindOrAdd(ItemDef).Add(Entries.Num() - 1);
+	}
+
 	//const ULyraInventoryItemDefinition* ItemCDO = GetDefault<ULyraInventoryItemDefinition>(ItemDef);
 	MarkItemDirty(NewEntry);
 
@@ -108,15 +120,171 @@ void FLyraInventoryList::AddEntry(ULyraInventoryItemInstance* Instance)
 
 void FLyraInventoryList::RemoveEntry(ULyraInventoryItemInstance* Instance)
 {
-	for (auto EntryIt = Entries.CreateIterator(); EntryIt; ++EntryIt)
+	if (Instance == nullptr)
+	{
+		return;
+	}
+
+	if (const TArray<int32>* EntryIndices = FindEntryIndices(Instance->GetItemDef()))
+	{
+		for (const int32 Index : *EntryIndices)
+		{
+			if (Entries[Index].Instance == Instance)
+			{
+				RemoveEntryAt(Index);
+				MarkArrayDirty();
+				return;
+			}
+		}
+	}
+}
+
+ULyraInventoryItemInstance* FLyraInventoryList::FindFirstInstance(TSubclassOf<ULyraInventoryItemDefinition> ItemDef) const
+{
+	if (const TArray<int32>* EntryIndices = FindEntryIndices(ItemDef))
+	{
+		for (const int32 Index : *EntryIndices)
+		{
+			ULyraInventoryItemInstance* Instance = Entries[Index].Instance;
+			if (IsValid(Instance))
+			{
+				return Instance;
+			}
+		}
+	}
+
+	return nullptr;
+}
+
+int32 FLyraInventoryList::GetEntryCount(TSubclassOf<ULyraInventoryItemDefinition> ItemDef) const
+{
+	int32 TotalCount = 0;
+	if (const TArray<int32>* EntryIndices = FindEntryIndices(ItemDef))
+	{
+		for (const int32 Index : *EntryIndices)
+		{
+			if (IsValid(Entries[Index].Instance))
+			{
+				++TotalCount;
+			}
+		}
+	}
+
+	return TotalCount;
+}
+
+int32 FLyraInventoryList::RemoveEntries(TSubclassOf<ULyraInventoryItemDefinition> ItemDef, int32 MaxToRemove)
+{
+	const TArray<int32>* EntryIndices = FindEntryIndices(ItemDef);
+	if (!EntryIndices || (MaxToRemove <= 0))
+	{
+		return 0;
+	}
+
+	// Copied since removing fixes up the index, highest first so each swap only moves an entry that is staying
+	TArray<int32, TInlineAllocator<16>> IndicesToRemove(*EntryIndices);
+	IndicesToRemove.Sort(TGreater<int32>());
+	IndicesToRemove.SetNum(FMath::Min(IndicesToRemove.Num(), MaxToRemove), false);
+
+	for (const int32 Index : IndicesToRemove)
+	{
+		RemoveEntryAt(Index);
+	}
+
+	if (IndicesToRemove.Num() > 0)
+	{
+		MarkArrayDirty();
+	}
+
+	return IndicesToRemove.Num();
+}
+
+const TArray<int32>* FLyraInventoryList::FindEntryIndices(TSubclassOf<ULyraInventoryItemDefinition> ItemDef) const
+{
+	if (bDefinitionIndexStale)
+	{
+		RebuildDefinitionIndex();
+	}
+
+	const TArray<int32>* EntryIndices = DefinitionToEntryIndices.Find(ItemDef);
+	if (EntryIndices)
+	{
+		// Instances replicate separately from the entries, so never trust a cached index that no longer matches its entry
+		for (const int32 Index : *EntryIndices)
+		{
+			const ULyraInventoryItemInstance* Instance = Entries.IsValidIndex(Index) ? Entries[Index].Instance : nullptr;
+			if ((Instance == nullptr) || (Instance->GetItemDef() != ItemDef))
+			{
+				RebuildDefinitionIndex();
+				EntryIndices = DefinitionToEntryIndices.Find(ItemDef);
+				break;
+			}
+		}
+	}
+
+	return EntryIndices;
+}
+
+void FLyraInventoryList::RebuildDefinitionIndex() const
+{
+	DefinitionToEntryIndices.Reset();
+
+	bool bAllEntriesResolved = true;
+	for (int32 Index = 0; Index < Entries.Num(); ++Index)
+	{
+		const ULyraInventoryItemInstance* Instance = Entries[Index].Instance;
+		const TSubclassOf<ULyraInventoryItemDefinition> ItemDef = Instance ? Instance->GetItemDef() : nullptr;
+		if (ItemDef == nullptr)
+		{
+			bAllEntriesResolved = false;
+			continue;
+		}
+
+		DefinitionToEntryIndices.FindOrAdd(ItemDef).Add(Index);
+	}
+
+	// Entries whose instance or item definition hasn't replicated yet are missing, so keep rebuilding until they arrive
+	bDefinitionIndexStale = !bAllEntriesResolved;
+}
+
+void FLyraInventoryList::RemoveEntryAt(int32 Index)
+{
+	const int32 LastIndex = Entries.Num() - 1;
+
+	// A stale index is rebuilt by the next lookup, so there is nothing to fix up
+	if (bDefinitionIndexStale)
+	{
+		Entries.RemoveAtSwap(Index, 1, false);
+		return;
+	}
+
+	const FLyraInventoryEntry& Entry = Entries[Index];
+	const TSubclassOf<ULyraInventoryItemDefinition> ItemDef = Entry.Instance ? Entry.Instance->GetItemDef() : nullptr;
+	if (TArray<int32>* EntryIndices = DefinitionToEntryIndices.Find(ItemDef))
 	{
-		FLyraInventoryEntry& Entry = *EntryIt;
-		if (Entry.Instance == Instance)
+		EntryIndices->RemoveSingleSwap(Index, false);
+		if (EntryIndices->Num() == 0)
 		{
-			EntryIt.RemoveCurrent();
-			MarkArrayDirty();
+			DefinitionToEntryIndices.Remove(ItemDef);
+		}
+	}
+
+	// Order doesn't matter to the fast array, so fill the hole with the last entry and fix up its index
+	if (Index != LastIndex)
+	{
+		const FLyraInventoryEntry& LastEntry = Entries[LastIndex];
+		const TSubclassOf<ULyraInventoryItemDefinition> LastItemDef = LastEntry.Instance ? LastEntry.Instance->GetItemDef() : nullptr;
+		if (TArray<int32>* EntryIndices = DefinitionToEntryIndices.Find(LastItemDef))
+		{
+			const int32 Position = EntryIndices->Find(LastIndex);
+			if (Position != INDEX_NONE)
+			{
+				(*EntryIndices)[Position] = Index;
+			}
 		}
 	}
+
+	Entries.RemoveAtSwap(Index, 1, false);
 }
 
 TArray<ULyraInventoryItemInstance*> FLyraInventoryList::GetAllItems() const
@@ -183,39 +351,12 @@ TArray<ULyraInventoryItemInstance*> ULyraInventoryManagerComponent::GetAllItems(
 
 ULyraInventoryItemInstance* ULyraInventoryManagerComponent::FindFirstItemStackByDefinition(TSubclassOf<ULyraInventoryItemDefinition> ItemDef) const
 {
-	for (const FLyraInventoryEntry& Entry : InventoryList.Entries)
-	{
-		ULyraInventoryItemInstance* Instance = Entry.Instance;
-
-		if (IsValid(Instance))
-		{
-			if (Instance->GetItemDef() == ItemDef)
-			{
-				return Instance;
-			}
-		}
-	}
-
-	return nullptr;
+	return InventoryList.FindFirstInstance(ItemDef);
 }
 
 int32 ULyraInventoryManagerComponent::GetTotalItemCountByDefinition(TSubclassOf<ULyraInventoryItemDefinition> ItemDef) const
 {
-	int32 TotalCount = 0;
-	for (const FLyraInventoryEntry& Entry : InventoryList.Entries)
-	{
-		ULyraInventoryItemInstance* Instance = Entry.Instance;
-
-		if (IsValid(Instance))
-		{
-			if (Instance->GetItemDef() == ItemDef)
-			{
-				++TotalCount;
-			}
-		}
-	}
-
-	return TotalCount;
+	return InventoryList.GetEntryCount(ItemDef);
 }
 
 bool ULyraInventoryManagerComponent::ConsumeItemsByDefinition(TSubclassOf<ULyraInventoryItemDefinition> ItemDef, int32 NumToConsume)
@@ -226,20 +367,8 @@ bool ULyraInventoryManagerComponent::ConsumeItemsByDefinition(TSubclassOf<ULyraI
 		return false;
 	}
 
-	//@TODO: N squared right now as there's no acceleration structure
-	int32 TotalConsumed = 0;
-	while (TotalConsumed < NumToConsume)
-	{
-		if (ULyraInventoryItemInstance* Instance = ULyraInventoryManagerComponent::FindFirstItemStackByDefinition(ItemDef))
-		{
-			InventoryList.RemoveEntry(Instance);
-			++TotalConsumed;
-		}
-		else
-		{
-			return false;
-		}
-	}
+	// Consumes as many as there are even if that's short, like removing them one at a time would
+	const int32 TotalConsumed = InventoryList.RemoveEntries(ItemDef, NumToConsume);
 
 	return TotalConsumed == NumToConsume;
 }
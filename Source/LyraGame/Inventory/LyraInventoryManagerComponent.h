@@ -93,9 +93,26 @@ public:
 
 	void RemoveEntry(ULyraInventoryItemInstance* Instance);
 
+	// Returns the first instance of the item definition, or nullptr if there are none
+	ULyraInventoryItemInstance* FindFirstInstance(TSubclassOf<ULyraInventoryItemDefinition> ItemDef) const;
+
+	// Returns the number of entries of the item definition
+	int32 GetEntryCount(TSubclassOf<ULyraInventoryItemDefinition> ItemDef) const;
+
+	// Removes up to MaxToRemove entries of the item definition in one pass, returns how many were removed
+	int32 RemoveEntries(TSubclassOf<ULyraInventoryItemDefinition> ItemDef, int32 MaxToRemove);
+
 private:
 	void BroadcastChangeMessage(FLyraInventoryEntry& Entry, int32 OldCount, int32 NewCount);
 
+	// Returns the indices of the entries of the item definition, rebuilding the index first if replication changed the entries
+	const TArray<int32>* FindEntryIndices(TSubclassOf<ULyraInventoryItemDefinition> ItemDef) const;
+
+	void RebuildDefinitionIndex() const;
+
+	// Removes the entry without marking the array dirty, fixing up the index of the entry moved into its place
+	void RemoveEntryAt(int32 Index);
+
 private:
 	friend ULyraInventoryManagerComponent;
 
@@ -106,6 +123,12 @@ private:
 
 	UPROPERTY()
 	UActorComponent* OwnerComponent;
+
+	// Indices of each item definition's entries in Entries, for lookups and counts without scanning
+	mutable TMap<TSubclassOf<ULyraInventoryItemDefinition>, TArray<int32>> DefinitionToEntryIndices;
+
+	// Set on clients when replication changes the entries, and kept while an entry's instance (or its item definition) hasn't arrived yet
+	mutable bool bDefinitionIndexStale = false;
 };
 
 template<>
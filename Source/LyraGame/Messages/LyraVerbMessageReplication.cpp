@@ -6,9 +6,141 @@
 //////////////////////////////////////////////////////////////////////
 // FLyraVerbMessageReplicationEntry
 
+namespace LyraVerbMessageReplication
+{
+	// Fields of a message that differ from their defaults
+	enum EPackedField : uint8
+	{
+		Instigator     = 1 << 0,
+		Target         = 1 << 1,
+		InstigatorTags = 1 << 2,
+		TargetTags     = 1 << 3,
+		ContextTags    = 1 << 4,
+		Magnitude      = 1 << 5,
+		WholeMagnitude = 1 << 6,
+
+		NumFieldBits = 7
+	};
+
+	// Damage numbers, counts and streaks are whole numbers, so those are sent as packed integers instead of doubles
+	static bool IsWholeNumber(double Value)
+	{
+		return (FMath::Abs(Value) <= (double)MAX_int32) && (FMath::RoundToDouble(Value) == Value);
+	}
+
+	static void SerializeTags(FArchive& Ar, UPackageMap* Map, FGameplayTagContainer& Tags, bool& bOutSuccess)
+	{
+		bool bTagsSuccess = true;
+		Tags.NetSerialize(Ar, Map, bTagsSuccess);
+		bOutSuccess &= bTagsSuccess;
+	}
+}
+
 FString FLyraVerbMessageReplicationEntry::GetDebugString() const
 {
-	return Message.ToString();
+	TArray<FString> MessageStrings;
+	for (const FLyraVerbMessage& Message : Messages)
+	{
+		MessageStrings.Add(Message.ToString());
+	}
+	return FString::Join(MessageStrings, TEXT(", "));
+}
+
+bool FLyraVerbMessageReplicationEntry::NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess)
+{
+	using namespace LyraVerbMessageReplication;
+
+	bOutSuccess = true;
+
+	uint32 NumMessages = Messages.Num();
+	Ar.SerializeIntPacked(NumMessages);
+	if (Ar.IsLoading())
+	{
+		// A corrupt count shouldn't make us allocate unbounded memory
+		if (NumMessages > (uint32)MaxMessagesPerBatch)
+		{
+			Ar.SetError();
+			bOutSuccess = false;
+			return false;
+		}
+		Messages.SetNum(NumMessages);
+	}
+
+	for (FLyraVerbMessage& Message : Messages)
+	{
+		uint8 Fields = 0;
+		if (Ar.IsSaving())
+		{
+			Fields |= (Message.Instigator != nullptr) ? Instigator : 0;
+			Fields |= (Message.Target != nullptr) ? Target : 0;
+			Fields |= !Message.InstigatorTags.IsEmpty() ? InstigatorTags : 0;
+			Fields |= !Message.TargetTags.IsEmpty() ? TargetTags : 0;
+			Fields |= !Message.ContextTags.IsEmpty() ? ContextTags : 0;
+			Fields |= (Message.Magnitude != 1.0) ? Magnitude : 0;
+			Fields |= IsWholeNumber(Message.Magnitude) ? WholeMagnitude : 0;
+		}
+		Ar.SerializeBits(&Fields, NumFieldBits);
+
+		// Verbs go through the net index table of the gameplay tags manager
+		bool bVerbSuccess = true;
+		Message.Verb.NetSerialize(Ar, Map, bVerbSuccess);
+		bOutSuccess &= bVerbSuccess;
+
+		// Objects are sent as net GUIDs by the package map
+		if (Fields & Instigator)
+		{
+			Ar << Message.Instigator;
+		}
+		if (Fields & Target)
+		{
+			Ar << Message.Target;
+		}
+
+		if (Fields & InstigatorTags)
+		{
+			SerializeTags(Ar, Map, Message.InstigatorTags, bOutSuccess);
+		}
+		if (Fields & TargetTags)
+		{
+			SerializeTags(Ar, Map, Message.TargetTags, bOutSuccess);
+		}
+		if (Fields & ContextTags)
+		{
+			SerializeTags(Ar, Map, Message.ContextTags, bOutSuccess);
+		}
+
+		if (Fields & Magnitude)
+		{
+			if (Fields & WholeMagnitude)
+			{
+				// Zigzag encoded so small negative values stay small
+				int32 Value = (int32)Message.Magnitude;
+				uint32 Packed = ((uint32)Value << 1) ^ (uint32)(Value >> 31);
+				Ar.SerializeIntPacked(Packed);
+				if (Ar.IsLoading())
+				{
+					Value = (int32)(Packed >> 1) ^ -(int32)(Packed & 1);
+					Message.Magnitude = Value;
+				}
+			}
+			else
+			{
+				// Only the copy sent to clients is reduced to float precision, never the server's message
+				float Value = (float)Message.Magnitude;
+				Ar << Value;
+				if (Ar.IsLoading())
+				{
+					Message.Magnitude = Value;
+				}
+			}
+		}
+		else if (Ar.IsLoading())
+		{
+			Message.Magnitude = 1.0;
+		}
+	}
+
+	return bOutSuccess;
 }
 
 //////////////////////////////////////////////////////////////////////
@@ -16,8 +148,17 @@ FString FLyraVerbMessageReplicationEntry::GetDebugString() const
 
 void FLyraVerbMessageReplication::AddMessage(const FLyraVerbMessage& Message)
 {
-	FLyraVerbMessageReplicationEntry& NewStack = CurrentMessages.Emplace_GetRef(Message);
-	MarkItemDirty(NewStack);
+	if (CurrentMessages.Num() > 0 && CurrentMessages.Last().FrameNumber == GFrameCounter && CurrentMessages.Last().Messages.Num() < FLyraVerbMessageReplicationEntry::MaxMessagesPerBatch)
+	{
+		FLyraVerbMessageReplicationEntry& Batch = CurrentMessages.Last();
+		Batch.Messages.Add(Message);
+		MarkItemDirty(Batch);
+		return;
+	}
+
+	FLyraVerbMessageReplicationEntry& NewBatch = CurrentMessages.Emplace_GetRef(Message);
+	NewBatch.FrameNumber = GFrameCounter;
+	MarkItemDirty(NewBatch);
 }
 
 void FLyraVerbMessageReplication::PreReplicatedRemove(const TArrayView<int32> RemovedIndices, int32 FinalSize)
@@ -33,8 +174,7 @@ void FLyraVerbMessageReplication::PostReplicatedAdd(const TArrayView<int32> Adde
 {
 	for (int32 Index : AddedIndices)
 	{
-		const FLyraVerbMessageReplicationEntry& Entry = CurrentMessages[Index];
-		RebroadcastMessage(Entry.Message);
+		RebroadcastMessages(CurrentMessages[Index]);
 	}
 }
 
@@ -42,14 +182,20 @@ void FLyraVerbMessageReplication::PostReplicatedChange(const TArrayView<int32> C
 {
 	for (int32 Index : ChangedIndices)
 	{
-		const FLyraVerbMessageReplicationEntry& Entry = CurrentMessages[Index];
-		RebroadcastMessage(Entry.Message);
+		RebroadcastMessages(CurrentMessages[Index]);
 	}
 }
 
-void FLyraVerbMessageReplication::RebroadcastMessage(const FLyraVerbMessage& Message)
+void FLyraVerbMessageReplication::RebroadcastMessages(FLyraVerbMessageReplicationEntry& Entry)
 {
 	check(Owner);
 	UGameplayMessageSubsystem& MessageSystem = UGameplayMessageSubsystem::Get(Owner);
-	MessageSystem.BroadcastMessage(Message.Verb, Message);
+
+	// A batch only grows while its frame lasts, so a change means new messages at the end
+	for (int32 Index = Entry.NumRebroadcast; Index < Entry.Messages.Num(); ++Index)
+	{
+		const FLyraVerbMessage& Message = Entry.Messages[Index];
+		MessageSystem.BroadcastMessage(Message.Verb, Message);
+	}
+	Entry.NumRebroadcast = Entry.Messages.Num();
 }
@@ -10,7 +10,7 @@
 struct FLyraVerbMessageReplication;
 
 /**
- * Represents one verb message
+ * Represents the verb messages sent in one frame, packed into a single item
  */
 USTRUCT(BlueprintType)
 struct FLyraVerbMessageReplicationEntry : public FFastArraySerializerItem
@@ -21,17 +21,37 @@ struct FLyraVerbMessageReplicationEntry : public FFastArraySerializerItem
 	{}
 
 	FLyraVerbMessageReplicationEntry(const FLyraVerbMessage& InMessage)
-		: Message(InMessage)
 	{
+		Messages.Add(InMessage);
 	}
 
 	FString GetDebugString() const;
 
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+
 private:
 	friend FLyraVerbMessageReplication;
 
+	// Clients reject larger batches as corrupt, so the server starts a new batch once one is full
+	static constexpr int32 MaxMessagesPerBatch = 1024;
+
 	UPROPERTY()
-	FLyraVerbMessage Message;
+	TArray<FLyraVerbMessage> Messages;
+
+	// Frame the batch was started in (server only)
+	uint64 FrameNumber = 0;
+
+	// Number of messages already rebroadcast (client only)
+	int32 NumRebroadcast = 0;
+};
+
+template<>
+struct TStructOpsTypeTraits<FLyraVerbMessageReplicationEntry> : public TStructOpsTypeTraitsBase2<FLyraVerbMessageReplicationEntry>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
 };
 
 /** Container of verb messages to replicate */
@@ -47,7 +67,7 @@ struct FLyraVerbMessageReplication : public FFastArraySerializer
 public:
 	void SetOwner(UObject* InOwner) { Owner = InOwner; }
 
-	// Broadcasts a message from server to clients
+	// Broadcasts a message from server to clients, messages added in the same frame are replicated as one batch
 	void AddMessage(const FLyraVerbMessage& Message);
 
 	//~FFastArraySerializer contract
@@ -62,10 +82,10 @@ public:
 	}
 
 private:
-	void RebroadcastMessage(const FLyraVerbMessage& Message);
+	void RebroadcastMessages(FLyraVerbMessageReplicationEntry& Entry);
 
 private:
-	// Replicated list of gameplay tag stacks
+	// Replicated list of verb message batches
 	UPROPERTY()
 	TArray<FLyraVerbMessageReplicationEntry> CurrentMessages;
 	
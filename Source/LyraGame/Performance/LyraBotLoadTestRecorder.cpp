@@ -0,0 +1,255 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LyraBotLoadTestRecorder.h"
+#include "LyraLogChannels.h"
+#include "Engine/World.h"
+#include "Engine/NetDriver.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Kismet/GameplayStatics.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+//////////////////////////////////////////////////////////////////////
+// FLyraBotLoadTestSettings
+
+void FLyraBotLoadTestSettings::ParseOptions(const FString& Options)
+{
+	BotStep = FMath::Max(UGameplayStatics::GetIntOption(Options, TEXT("LoadTestBotStep"), BotStep), 1);
+	StartBots = FMath::Max(UGameplayStatics::GetIntOption(Options, TEXT("LoadTestStartBots"), StartBots), 0);
+	MaxBots = FMath::Max(UGameplayStatics::GetIntOption(Options, TEXT("LoadTestMaxBots"), MaxBots), StartBots);
+
+	auto GetFloatOption = [&Options](const TCHAR* Key, float DefaultValue)
+	{
+		const FString Value = UGameplayStatics::ParseOption(Options, Key);
+		return Value.IsEmpty() ? DefaultValue : FMath::Max(FCString::Atof(*Value), 0.0f);
+	};
+
+	WarmupSeconds = GetFloatOption(TEXT("LoadTestWarmup"), WarmupSeconds);
+	StepSeconds = FMath::Max(GetFloatOption(TEXT("LoadTestStepSeconds"), StepSeconds), 1.0f);
+	BehaviorInterval = FMath::Max(GetFloatOption(TEXT("LoadTestBehaviorInterval"), BehaviorInterval), 0.1f);
+
+	if (UGameplayStatics::HasOption(Options, TEXT("LoadTestBehaviors")))
+	{
+		const FString BehaviorString = UGameplayStatics::ParseOption(Options, TEXT("LoadTestBehaviors"));
+
+		Behaviors = ELyraBotLoadTestBehavior::None;
+		if (BehaviorString.Contains(TEXT("Move")))
+		{
+			Behaviors |= ELyraBotLoadTestBehavior::Move;
+		}
+		if (BehaviorString.Contains(TEXT("Fire")))
+		{
+			Behaviors |= ELyraBotLoadTestBehavior::Fire;
+		}
+		if (BehaviorString.Contains(TEXT("Interact")))
+		{
+			Behaviors |= ELyraBotLoadTestBehavior::Interact;
+		}
+	}
+
+	bCaptureCsvProfile = UGameplayStatics::HasOption(Options, TEXT("LoadTestCsvProfile"));
+	bExitWhenDone = UGameplayStatics::HasOption(Options, TEXT("LoadTestExit"));
+}
+
+//////////////////////////////////////////////////////////////////////
+// FLyraBotLoadTestRecorder
+
+namespace LyraBotLoadTest
+{
+	static FString GetOutputDir()
+	{
+		return FPaths::ProfilingDir() / TEXT("BotLoadTest");
+	}
+
+	static float GetPercentile(TArray<float>& Samples, float Percentile)
+	{
+		if (Samples.Num() == 0)
+		{
+			return 0.0f;
+		}
+
+		Samples.Sort();
+		const int32 Index = FMath::Clamp(FMath::CeilToInt(Percentile * Samples.Num()) - 1, 0, Samples.Num() - 1);
+		return Samples[Index];
+	}
+
+	static float GetAverage(const TArray<float>& Samples)
+	{
+		float Total = 0.0f;
+		for (const float Sample : Samples)
+		{
+			Total += Sample;
+		}
+		return (Samples.Num() > 0) ? (Total / Samples.Num()) : 0.0f;
+	}
+}
+
+FLyraBotLoadTestRecorder::FLyraBotLoadTestRecorder(UWorld* InWorld, const FLyraBotLoadTestSettings& InSettings)
+	: World(InWorld)
+	, Settings(InSettings)
+{
+	check(InWorld);
+
+	const FString OutputDir = LyraBotLoadTest::GetOutputDir();
+	IFileManager::Get().MakeDirectory(*OutputDir, /*Tree=*/ true);
+
+	Filename = OutputDir / FString::Printf(TEXT("BotLoadTest-%s-%s.csv"), *InWorld->GetMapName(), *FDateTime::Now().ToString());
+
+	// Rows are appended as steps finish, so a test that doesn't make it to the end still leaves its results behind
+	FFileHelper::SaveStringToFile(TEXT("Step,NumBots,NumFrames,AvgFrameMs,P95FrameMs,MaxFrameMs,AvgGameThreadMs,P95GameThreadMs,AvgPreActorTickMs,AvgActorTickMs,AvgNetDispatchMs,AvgNetFlushMs\n"), *Filename);
+
+	TickStartHandle = FWorldDelegates::OnWorldTickStart.AddRaw(this, &FLyraBotLoadTestRecorder::OnWorldTickStart);
+	PreActorTickHandle = FWorldDelegates::OnWorldPreActorTick.AddRaw(this, &FLyraBotLoadTestRecorder::OnWorldPreActorTick);
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddRaw(this, &FLyraBotLoadTestRecorder::OnWorldPostActorTick);
+
+	if (UNetDriver* WorldNetDriver = InWorld->GetNetDriver())
+	{
+		NetDriver = WorldNetDriver;
+		TickDispatchHandle = WorldNetDriver->OnTickDispatch().AddLambda([this](float DeltaSeconds) { BeginPhase(EPhase::NetDispatch); });
+		PostTickDispatchHandle = WorldNetDriver->OnPostTickDispatch().AddLambda([this]() { EndPhase(EPhase::NetDispatch); });
+		TickFlushHandle = WorldNetDriver->OnTickFlush().AddLambda([this](float DeltaSeconds) { BeginPhase(EPhase::NetFlush); });
+		PostTickFlushHandle = WorldNetDriver->OnPostTickFlush().AddLambda([this]() { EndPhase(EPhase::NetFlush); });
+	}
+}
+
+FLyraBotLoadTestRecorder::~FLyraBotLoadTestRecorder()
+{
+	FWorldDelegates::OnWorldTickStart.Remove(TickStartHandle);
+	FWorldDelegates::OnWorldPreActorTick.Remove(PreActorTickHandle);
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+
+	if (UNetDriver* WorldNetDriver = NetDriver.Get())
+	{
+		WorldNetDriver->OnTickDispatch().Remove(TickDispatchHandle);
+		WorldNetDriver->OnPostTickDispatch().Remove(PostTickDispatchHandle);
+		WorldNetDriver->OnTickFlush().Remove(TickFlushHandle);
+		WorldNetDriver->OnPostTickFlush().Remove(PostTickFlushHandle);
+	}
+
+#if CSV_PROFILER
+	if (bRecording && Settings.bCaptureCsvProfile)
+	{
+		FCsvProfiler::Get()->EndCapture();
+	}
+#endif
+}
+
+void FLyraBotLoadTestRecorder::BeginStep(int32 NumBots)
+{
+	StepNumBots = NumBots;
+	FrameTimes.Reset();
+	GameThreadTimes.Reset();
+	FMemory::Memzero(StepPhaseSeconds);
+	bRecording = true;
+
+#if CSV_PROFILER
+	if (Settings.bCaptureCsvProfile)
+	{
+		const FString StepFilename = FString::Printf(TEXT("%s-Step%d-%dBots.csv"), *FPaths::GetBaseFilename(Filename), StepIndex, NumBots);
+		FCsvProfiler::Get()->BeginCapture(-1, LyraBotLoadTest::GetOutputDir(), StepFilename);
+	}
+#endif
+}
+
+void FLyraBotLoadTestRecorder::EndStep()
+{
+	if (!bRecording)
+	{
+		return;
+	}
+
+	bRecording = false;
+
+#if CSV_PROFILER
+	if (Settings.bCaptureCsvProfile)
+	{
+		FCsvProfiler::Get()->EndCapture();
+	}
+#endif
+
+	const int32 NumFrames = FrameTimes.Num();
+	const float AvgFrameMs = LyraBotLoadTest::GetAverage(FrameTimes);
+	const float AvgGameThreadMs = LyraBotLoadTest::GetAverage(GameThreadTimes);
+	const float P95FrameMs = LyraBotLoadTest::GetPercentile(FrameTimes, 0.95f);
+	const float MaxFrameMs = (NumFrames > 0) ? FrameTimes.Last() : 0.0f;
+	const float P95GameThreadMs = LyraBotLoadTest::GetPercentile(GameThreadTimes, 0.95f);
+
+	FString Row = FString::Printf(TEXT("%d,%d,%d,%.3f,%.3f,%.3f,%.3f,%.3f"), StepIndex, StepNumBots, NumFrames, AvgFrameMs, P95FrameMs, MaxFrameMs, AvgGameThreadMs, P95GameThreadMs);
+	for (const double PhaseSeconds : StepPhaseSeconds)
+	{
+		Row += FString::Printf(TEXT(",%.3f"), (NumFrames > 0) ? (PhaseSeconds * 1000.0 / NumFrames) : 0.0);
+	}
+	Row += TEXT("\n");
+
+	FFileHelper::SaveStringToFile(Row, *Filename, FFileHelper::EEncodingOptions::AutoDetect, &IFileManager::Get(), FILEWRITE_Append);
+
+	UE_LOG(LogLyra, Log, TEXT("Bot load test step %d: %d bots, %d frames, %.2f ms average frame, %.2f ms p95 frame, %.2f ms average game thread"),
+		StepIndex, StepNumBots, NumFrames, AvgFrameMs, P95FrameMs, AvgGameThreadMs);
+
+	++StepIndex;
+}
+
+void FLyraBotLoadTestRecorder::StartCharting()
+{
+}
+
+void FLyraBotLoadTestRecorder::ProcessFrame(const FFrameData& FrameData)
+{
+	if (bRecording)
+	{
+		FrameTimes.Add((float)(FrameData.TrueDeltaSeconds * 1000.0));
+		GameThreadTimes.Add((float)(FrameData.GameThreadTimeSeconds * 1000.0));
+
+		for (uint8 PhaseIndex = 0; PhaseIndex < (uint8)EPhase::Count; ++PhaseIndex)
+		{
+			StepPhaseSeconds[PhaseIndex] += FPlatformTime::ToSeconds64(FramePhaseCycles[PhaseIndex]);
+		}
+	}
+
+	FMemory::Memzero(FramePhaseCycles);
+}
+
+void FLyraBotLoadTestRecorder::StopCharting()
+{
+}
+
+void FLyraBotLoadTestRecorder::OnWorldTickStart(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds)
+{
+	if (InWorld == World.Get())
+	{
+		BeginPhase(EPhase::PreActorTick);
+	}
+}
+
+void FLyraBotLoadTestRecorder::OnWorldPreActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds)
+{
+	if (InWorld == World.Get())
+	{
+		EndPhase(EPhase::PreActorTick);
+		BeginPhase(EPhase::ActorTick);
+	}
+}
+
+void FLyraBotLoadTestRecorder::OnWorldPostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds)
+{
+	if (InWorld == World.Get())
+	{
+		EndPhase(EPhase::ActorTick);
+	}
+}
+
+void FLyraBotLoadTestRecorder::BeginPhase(EPhase Phase)
+{
+	PhaseStartCycles[(uint8)Phase] = FPlatformTime::Cycles64();
+}
+
+void FLyraBotLoadTestRecorder::EndPhase(EPhase Phase)
+{
+	uint64& StartCycles = PhaseStartCycles[(uint8)Phase];
+	if (StartCycles != 0)
+	{
+		FramePhaseCycles[(uint8)Phase] += FPlatformTime::Cycles64() - StartCycles;
+		StartCycles = 0;
+	}
+}
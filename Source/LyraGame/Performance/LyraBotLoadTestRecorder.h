@@ -0,0 +1,136 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "ChartCreation.h"
+#include "Engine/EngineBaseTypes.h"
+
+class UNetDriver;
+class UWorld;
+
+//////////////////////////////////////////////////////////////////////
+
+// Scripted behaviors the bots run during a bot load test
+enum class ELyraBotLoadTestBehavior : uint8
+{
+	None = 0,
+
+	// Run towards another bot
+	Move = 1 << 0,
+
+	// Aim at another bot and fire in bursts
+	Fire = 1 << 1,
+
+	// Press interact now and then
+	Interact = 1 << 2,
+
+	All = Move | Fire | Interact
+};
+ENUM_CLASS_FLAGS(ELyraBotLoadTestBehavior);
+
+// Settings of a bot load test, read from the URL options (e.g., ?BotLoadTest?LoadTestBotStep=16?LoadTestMaxBots=128)
+struct FLyraBotLoadTestSettings
+{
+	// Number of bots in the first step (LoadTestStartBots)
+	int32 StartBots = 8;
+
+	// Number of bots added for every following step (LoadTestBotStep)
+	int32 BotStep = 8;
+
+	// The test ends after the step that reaches this many bots (LoadTestMaxBots)
+	int32 MaxBots = 64;
+
+	// Time after adding bots before frames are recorded, so spawning doesn't show up in the step (LoadTestWarmup)
+	float WarmupSeconds = 5.0f;
+
+	// Time frames are recorded for in each step (LoadTestStepSeconds)
+	float StepSeconds = 20.0f;
+
+	// How often bots update their scripted behaviors (LoadTestBehaviorInterval)
+	float BehaviorInterval = 0.5f;
+
+	// The scripted behaviors, any of Move, Fire and Interact (LoadTestBehaviors=Move+Fire), or None to leave bots to their AI
+	ELyraBotLoadTestBehavior Behaviors = ELyraBotLoadTestBehavior::All;
+
+	// Also capture a CSV profile of every step for the full per-category breakdown (LoadTestCsvProfile)
+	bool bCaptureCsvProfile = false;
+
+	// Exit once the test is done (LoadTestExit)
+	bool bExitWhenDone = false;
+
+	void ParseOptions(const FString& Options);
+};
+
+//////////////////////////////////////////////////////////////////////
+
+// Records the server frame times of each bot load test step, appending a CSV row per step.
+// Dedicated servers sleep to their tick rate, so the game thread and phase times are the ones that show the cost of the bots.
+class FLyraBotLoadTestRecorder : public IPerformanceDataConsumer
+{
+public:
+	FLyraBotLoadTestRecorder(UWorld* InWorld, const FLyraBotLoadTestSettings& InSettings);
+	virtual ~FLyraBotLoadTestRecorder();
+
+	// Starts recording frames for a step with the number of bots
+	void BeginStep(int32 NumBots);
+
+	// Stops recording and writes the step to the CSV
+	void EndStep();
+
+	const FString& GetFilename() const { return Filename; }
+
+	//~IPerformanceDataConsumer interface
+	virtual void StartCharting() override;
+	virtual void ProcessFrame(const FFrameData& FrameData) override;
+	virtual void StopCharting() override;
+	//~End of IPerformanceDataConsumer interface
+
+private:
+	// Parts of the frame timed separately, in CSV column order
+	enum class EPhase : uint8
+	{
+		// From the start of the world tick until actors tick (includes net dispatch)
+		PreActorTick,
+		ActorTick,
+		NetDispatch,
+		// Replication and sending
+		NetFlush,
+
+		Count
+	};
+
+	void OnWorldTickStart(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+	void OnWorldPreActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+	void OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+
+	void BeginPhase(EPhase Phase);
+	void EndPhase(EPhase Phase);
+
+	TWeakObjectPtr<UWorld> World;
+	TWeakObjectPtr<UNetDriver> NetDriver;
+	FLyraBotLoadTestSettings Settings;
+	FString Filename;
+
+	int32 StepIndex = 0;
+	int32 StepNumBots = 0;
+	bool bRecording = false;
+
+	// Per frame samples of the current step, in milliseconds
+	TArray<float> FrameTimes;
+	TArray<float> GameThreadTimes;
+
+	// Phase times of the current step, summed over its frames
+	double StepPhaseSeconds[(uint8)EPhase::Count] = {};
+
+	// Phase times of the frame in progress
+	uint64 PhaseStartCycles[(uint8)EPhase::Count] = {};
+	uint64 FramePhaseCycles[(uint8)EPhase::Count] = {};
+
+	FDelegateHandle TickStartHandle;
+	FDelegateHandle PreActorTickHandle;
+	FDelegateHandle PostActorTickHandle;
+	FDelegateHandle TickDispatchHandle;
+	FDelegateHandle PostTickDispatchHandle;
+	FDelegateHandle TickFlushHandle;
+	FDelegateHandle PostTickFlushHandle;
+};
@@ -23,24 +23,55 @@ void FGameplayTagStackContainer::AddStack(FGameplayTag Tag, int32 StackCount)
 
 	if (StackCount > 0)
 	{
-		for (FGameplayTagStack& Stack : Stacks)
+		if (AddStackInternal(Tag, StackCount))
 		{
-			if (Stack.Tag == Tag)
-			{
-				const int32 NewCount = Stack.StackCount + StackCount;
-				Stack.StackCount = NewCount;
-				TagToCountMap[Tag] = NewCount;
-				MarkItemDirty(Stack);
-				return;
-			}
+			MarkArrayDirty();
+		}
+	}
+}
+
+void FGameplayTagStackContainer::AddStacks(TConstArrayView<TPair<FGameplayTag, int32>> TagStacks)
+{
+	bool bChangedExistingStack = false;
+
+	for (const TPair<FGameplayTag, int32>& TagStack : TagStacks)
+	{
+		if (!TagStack.Key.IsValid())
+		{
+			FFrame::KismetExecutionMessage(TEXT("An invalid tag was passed to AddStacks"), ELogVerbosity::Warning);
+			continue;
 		}
 
-		FGameplayTagStack& NewStack = Stacks.Emplace_GetRef(Tag, StackCount);
-		MarkItemDirty(NewStack);
-		TagToCountMap.Add(Tag, StackCount);
+		if (TagStack.Value > 0)
+		{
+			bChangedExistingStack |= AddStackInternal(TagStack.Key, TagStack.Value);
+		}
+	}
+
+	if (bChangedExistingStack)
+	{
+		MarkArrayDirty();
 	}
 }
 
+bool FGameplayTagStackContainer::AddStackInternal(FGameplayTag Tag, int32 StackCount)
+{
+	const int32 Index = FindStackIndex(Tag);
+	if (Index != INDEX_NONE)
+	{
+		// Equivalent to MarkItemDirty, minus the MarkArrayDirty the caller does once for the whole batch
+		FGameplayTagStack& Stack = Stacks[Index];
+		Stack.StackCount += StackCount;
+		Stack.ReplicationKey++;
+		return true;
+	}
+
+	const int32 NewIndex = Stacks.Emplace(Tag, StackCount);
+	MarkItemDirty(Stacks[NewIndex]);
+	TagToIndexMap.Add(Tag, NewIndex);
+	return false;
+}
+
 void FGameplayTagStackContainer::RemoveStack(FGameplayTag Tag, int32 StackCount)
 {
 	if (!Tag.IsValid())
@@ -52,53 +83,83 @@ void FGameplayTagStackContainer::RemoveStack(FGameplayTag Tag, int32 StackCount)
 	//@TODO: Should we error if you try to remove a stack that doesn't exist or has a smaller count?
 	if (StackCount > 0)
 	{
-		for (auto It = Stacks.CreateIterator(); It; ++It)
+		const int32 Index = FindStackIndex(Tag);
+		if (Index == INDEX_NONE)
+		{
+			return;
+		}
+		TagToIndexMap.Remove(Tag);
+
+		FGameplayTagStack& Stack = Stacks[Index];
+		if (Stack.StackCount <= StackCount)
 		{
-			FGameplayTagStack& Stack = *It;
-			if (Stack.Tag == Tag)
+			// Order doesn't matter to the fast array, so fill the hole with the last stack and fix up its index
+			Stacks.RemoveAtSwap(Index, 1, false);
+			if (Stacks.IsValidIndex(Index))
 			{
-				if (Stack.StackCount <= StackCount)
-				{
-					It.RemoveCurrent();
-					TagToCountMap.Remove(Tag);
-					MarkArrayDirty();
-				}
-				else
-				{
-					const int32 NewCount = Stack.StackCount - StackCount;
-					Stack.StackCount = NewCount;
-					TagToCountMap[Tag] = NewCount;
-					MarkItemDirty(Stack);
-				}
-				return;
+				TagToIndexMap[Stacks[Index].Tag] = Index;
 			}
+			MarkArrayDirty();
+		}
+		else
+		{
+			Stack.StackCount -= StackCount;
+			TagToIndexMap.Add(Tag, Index);
+			MarkItemDirty(Stack);
 		}
 	}
 }
 
-void FGameplayTagStackContainer::PreReplicatedRemove(const TArrayView<int32> RemovedIndices, int32 FinalSize)
+int32 FGameplayTagStackContainer::FindStackIndex(FGameplayTag Tag) const
 {
-	for (int32 Index : RemovedIndices)
+	if (bTagToIndexMapStale)
+	{
+		RebuildTagToIndexMap();
+	}
+
+	const int32* Index = TagToIndexMap.Find(Tag);
+	if (Index == nullptr)
+	{
+		return INDEX_NONE;
+	}
+
+	if (!Stacks.IsValidIndex(*Index) || (Stacks[*Index].Tag != Tag))
 	{
-		const FGameplayTag Tag = Stacks[Index].Tag;
-		TagToCountMap.Remove(Tag);
+		// Replication moved the stacks without us noticing, don't trust any of the indices
+		RebuildTagToIndexMap();
+		Index = TagToIndexMap.Find(Tag);
+		return Index ? *Index : INDEX_NONE;
 	}
+
+	return *Index;
 }
 
-void FGameplayTagStackContainer::PostReplicatedAdd(const TArrayView<int32> AddedIndices, int32 FinalSize)
+void FGameplayTagStackContainer::RebuildTagToIndexMap() const
 {
-	for (int32 Index : AddedIndices)
+	TagToIndexMap.Reset();
+	for (int32 Index = 0; Index < Stacks.Num(); ++Index)
 	{
-		const FGameplayTagStack& Stack = Stacks[Index];
-		TagToCountMap.Add(Stack.Tag, Stack.StackCount);
+		TagToIndexMap.Add(Stacks[Index].Tag, Index);
 	}
+	bTagToIndexMapStale = false;
+}
+
+void FGameplayTagStackContainer::PreReplicatedRemove(const TArrayView<int32> RemovedIndices, int32 FinalSize)
+{
+	// The removed stacks are swapped out after all of the callbacks, so every index can change
+	bTagToIndexMapStale = true;
 }
 
-void FGameplayTagStackContainer::PostReplicatedChange(const TArrayView<int32> ChangedIndices, int32 FinalSize)
+void FGameplayTagStackContainer::PostReplicatedAdd(const TArrayView<int32> AddedIndices, int32 FinalSize)
 {
-	for (int32 Index : ChangedIndices)
+	// With removals in the same update these are pre-removal indices, the map gets rebuilt when next used instead
+	if (bTagToIndexMapStale)
+	{
+		return;
+	}
+
+	for (int32 Index : AddedIndices)
 	{
-		const FGameplayTagStack& Stack = Stacks[Index];
-		TagToCountMap[Stack.Tag] = Stack.StackCount;
+		TagToIndexMap.Add(Stacks[Index].Tag, Index);
 	}
 }
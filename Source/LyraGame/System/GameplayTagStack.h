@@ -54,25 +54,28 @@ public:
 	// Adds a specified number of stacks to the tag (does nothing if StackCount is below 1)
 	void AddStack(FGameplayTag Tag, int32 StackCount);
 
+	// Adds stacks to several tags at once, the array is only marked dirty once for all of the existing tags
+	void AddStacks(TConstArrayView<TPair<FGameplayTag, int32>> TagStacks);
+
 	// Removes a specified number of stacks from the tag (does nothing if StackCount is below 1)
 	void RemoveStack(FGameplayTag Tag, int32 StackCount);
 
 	// Returns the stack count of the specified tag (or 0 if the tag is not present)
 	int32 GetStackCount(FGameplayTag Tag) const
 	{
-		return TagToCountMap.FindRef(Tag);
+		const int32 Index = FindStackIndex(Tag);
+		return (Index != INDEX_NONE) ? Stacks[Index].StackCount : 0;
 	}
 
 	// Returns true if there is at least one stack of the specified tag
 	bool ContainsTag(FGameplayTag Tag) const
 	{
-		return TagToCountMap.Contains(Tag);
+		return FindStackIndex(Tag) != INDEX_NONE;
 	}
 
 	//~FFastArraySerializer contract
 	void PreReplicatedRemove(const TArrayView<int32> RemovedIndices, int32 FinalSize);
 	void PostReplicatedAdd(const TArrayView<int32> AddedIndices, int32 FinalSize);
-	void PostReplicatedChange(const TArrayView<int32> ChangedIndices, int32 FinalSize);
 	//~End of FFastArraySerializer contract
 
 	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
@@ -81,12 +84,24 @@ public:
 	}
 
 private:
+	// Adds to the stack without marking anything dirty, returns true if an existing stack changed (new stacks are marked dirty here)
+	bool AddStackInternal(FGameplayTag Tag, int32 StackCount);
+
+	// Returns the index of the tag's stack in Stacks (or INDEX_NONE), rebuilding the index map first if it is stale
+	int32 FindStackIndex(FGameplayTag Tag) const;
+
+	void RebuildTagToIndexMap() const;
+
 	// Replicated list of gameplay tag stacks
 	UPROPERTY()
 	TArray<FGameplayTagStack> Stacks;
 	
-	// Accelerated list of tag stacks for queries
-	TMap<FGameplayTag, int32> TagToCountMap;
+	// Index of each tag's stack in Stacks, for queries and updates without scanning
+	mutable TMap<FGameplayTag, int32> TagToIndexMap;
+
+	// Set on clients when replication removes stacks, which moves the remaining ones around after the
+	// replication callbacks have run; the map is rebuilt the next time it is used
+	mutable bool bTagToIndexMapStale = false;
 };
 
 template<>
@@ -23,9 +23,13 @@ static FAutoConsoleCommand CVarDumpLoadedAssets(
 
 //////////////////////////////////////////////////////////////////////
 
+// The job macros return the index of the new job, which other jobs pass to DependsOn
 #define STARTUP_JOB_WEIGHTED(JobFunc, JobWeight) StartupJobs.Add(FLyraAssetManagerStartupJob(#JobFunc, [this](const FLyraAssetManagerStartupJob& StartupJob, TSharedPtr<FStreamableHandle>& LoadHandle){JobFunc;}, JobWeight))
 #define STARTUP_JOB(JobFunc) STARTUP_JOB_WEIGHTED(JobFunc, 1.f)
 
+// A job whose function returns a streamable handle, the load completes in the background while other jobs run
+#define STARTUP_LOAD_JOB_WEIGHTED(JobFunc, JobWeight) StartupJobs.Add(FLyraAssetManagerStartupJob(#JobFunc, [this](const FLyraAssetManagerStartupJob& StartupJob, TSharedPtr<FStreamableHandle>& LoadHandle){LoadHandle = JobFunc;}, JobWeight))
+
 //////////////////////////////////////////////////////////////////////
 
 ULyraAssetManager::ULyraAssetManager()
@@ -106,23 +110,36 @@ void ULyraAssetManager::StartInitialLoading()
 	// This does all of the scanning, need to do this now even if loads are deferred
 	Super::StartInitialLoading();
 
-	STARTUP_JOB(InitializeAbilitySystem());
-	STARTUP_JOB(InitializeGameplayCueManager());
+	// Jobs start as soon as their dependencies complete, so the game data streams in while the ability system
+	// and gameplay cue libraries initialize
+	const int32 NativeTagsJob = STARTUP_JOB(InitializeNativeTags());
+	const int32 AbilitySystemJob = STARTUP_JOB(InitializeAbilitySystem());
+	const int32 GameplayCueManagerJob = STARTUP_JOB(InitializeGameplayCueManager());
+	StartupJobs[AbilitySystemJob].DependsOn(NativeTagsJob);
+	StartupJobs[GameplayCueManagerJob].DependsOn(AbilitySystemJob);
 
 	{
 		// Load base game data asset
-		STARTUP_JOB_WEIGHTED(GetGameData(), 25.f);
+		const int32 PreloadGameDataJob = STARTUP_LOAD_JOB_WEIGHTED(PreloadGameData(), 24.f);
+		const int32 GameDataJob = STARTUP_JOB(GetGameData());
+		StartupJobs[PreloadGameDataJob].DependsOn(NativeTagsJob);
+		StartupJobs[GameDataJob].DependsOn(PreloadGameDataJob).DependsOn(AbilitySystemJob);
 	}
 
 	// Run all the queued up startup jobs
 	DoAllStartupJobs();
 }
 
-void ULyraAssetManager::InitializeAbilitySystem()
+void ULyraAssetManager::InitializeNativeTags()
 {
-	SCOPED_BOOT_TIMING("ULyraAssetManager::InitializeAbilitySystem");
+	SCOPED_BOOT_TIMING("ULyraAssetManager::InitializeNativeTags");
 
 	FLyraGameplayTags::InitializeNativeTags();
+}
+
+void ULyraAssetManager::InitializeAbilitySystem()
+{
+	SCOPED_BOOT_TIMING("ULyraAssetManager::InitializeAbilitySystem");
 
 	UAbilitySystemGlobals::Get().InitGlobalData();
 }
@@ -142,6 +159,17 @@ const ULyraGameData& ULyraAssetManager::GetGameData()
 	return GetOrLoadTypedGameData<ULyraGameData>(LyraGameDataPath);
 }
 
+TSharedPtr<FStreamableHandle> ULyraAssetManager::PreloadGameData()
+{
+	// The editor loads game data synchronously on demand, see LoadGameDataOfClass
+	if (GIsEditor || LyraGameDataPath.IsNull())
+	{
+		return nullptr;
+	}
+
+	return LoadPrimaryAssetsWithType(ULyraGameData::StaticClass()->GetFName());
+}
+
 const ULyraPawnData* ULyraAssetManager::GetDefaultPawnData() const
 {
 	return GetAsset(DefaultPawnData);
@@ -201,49 +229,113 @@ void ULyraAssetManager::DoAllStartupJobs()
 	SCOPED_BOOT_TIMING("ULyraAssetManager::DoAllStartupJobs");
 	const double AllStartupJobsStartTime = FPlatformTime::Seconds();
 
-	if (IsRunningDedicatedServer())
+	// Jobs only depend on jobs added before them, so there can't be a cycle
+	for (int32 JobIndex = 0; JobIndex < StartupJobs.Num(); ++JobIndex)
 	{
-		// No need for periodic progress updates, just run the jobs
-		for (const FLyraAssetManagerStartupJob& StartupJob : StartupJobs)
+		for (const int32 DependencyIndex : StartupJobs[JobIndex].Dependencies)
 		{
-			StartupJob.DoJob();
+			checkf((DependencyIndex >= 0) && (DependencyIndex < JobIndex), TEXT("Startup job \"%s\" depends on job %d, which wasn't added before it"), *StartupJobs[JobIndex].JobName, DependencyIndex);
 		}
 	}
-	else
+
+	// No need for periodic progress updates on a dedicated server
+	const bool bReportProgress = !IsRunningDedicatedServer();
+
+	float TotalJobValue = 0.0f;
+	for (const FLyraAssetManagerStartupJob& StartupJob : StartupJobs)
+	{
+		TotalJobValue += StartupJob.JobWeight;
+	}
+
+	TArray<bool> CompletedJobs;
+	CompletedJobs.SetNumZeroed(StartupJobs.Num());
+	int32 NumCompletedJobs = 0;
+	float AccumulatedJobValue = 0.0f;
+
+	auto CompleteJob = [&](int32 JobIndex)
+	{
+		FLyraAssetManagerStartupJob& StartupJob = StartupJobs[JobIndex];
+		StartupJob.FinishJob();
+		StartupJob.SubstepProgressDelegate.Unbind();
+
+		CompletedJobs[JobIndex] = true;
+		++NumCompletedJobs;
+		AccumulatedJobValue += StartupJob.JobWeight;
+
+		if (bReportProgress)
+		{
+			UpdateInitialGameContentLoadPercent(AccumulatedJobValue / TotalJobValue);
+		}
+	};
+
+	while (NumCompletedJobs < StartupJobs.Num())
 	{
-		if (StartupJobs.Num() > 0)
+		bool bMadeProgress = false;
+
+		// Start everything that's ready
+		for (int32 JobIndex = 0; JobIndex < StartupJobs.Num(); ++JobIndex)
 		{
-			float TotalJobValue = 0.0f;
-			for (const FLyraAssetManagerStartupJob& StartupJob : StartupJobs)
+			FLyraAssetManagerStartupJob& StartupJob = StartupJobs[JobIndex];
+			if (StartupJob.HasStarted())
+			{
+				continue;
+			}
+
+			const bool bDependenciesComplete = !StartupJob.Dependencies.ContainsByPredicate([&CompletedJobs](int32 DependencyIndex) { return !CompletedJobs[DependencyIndex]; });
+			if (!bDependenciesComplete)
 			{
-				TotalJobValue += StartupJob.JobWeight;
+				continue;
 			}
 
-			float AccumulatedJobValue = 0.0f;
-			for (FLyraAssetManagerStartupJob& StartupJob : StartupJobs)
+			if (bReportProgress)
 			{
 				const float JobValue = StartupJob.JobWeight;
-				StartupJob.SubstepProgressDelegate.BindLambda([This = this, AccumulatedJobValue, JobValue, TotalJobValue](float NewProgress)
+				StartupJob.SubstepProgressDelegate.BindLambda([This = this, &AccumulatedJobValue, JobValue, TotalJobValue](float NewProgress)
 					{
 						const float SubstepAdjustment = FMath::Clamp(NewProgress, 0.0f, 1.0f) * JobValue;
 						const float OverallPercentWithSubstep = (AccumulatedJobValue + SubstepAdjustment) / TotalJobValue;
 
 						This->UpdateInitialGameContentLoadPercent(OverallPercentWithSubstep);
 					});
+			}
 
-				StartupJob.DoJob();
-
-				StartupJob.SubstepProgressDelegate.Unbind();
-
-				AccumulatedJobValue += JobValue;
+			StartupJob.StartJob();
+			bMadeProgress = true;
+		}
 
-				UpdateInitialGameContentLoadPercent(AccumulatedJobValue / TotalJobValue);
+		for (int32 JobIndex = 0; JobIndex < StartupJobs.Num(); ++JobIndex)
+		{
+			if (!CompletedJobs[JobIndex] && StartupJobs[JobIndex].HasStarted() && StartupJobs[JobIndex].IsJobComplete())
+			{
+				CompleteJob(JobIndex);
+				bMadeProgress = true;
 			}
 		}
-		else
+
+		if (bMadeProgress)
+		{
+			continue;
+		}
+
+		// Nothing else can start until a running job completes, so block on the oldest one
+		int32 RunningJobIndex = INDEX_NONE;
+		for (int32 JobIndex = 0; (JobIndex < StartupJobs.Num()) && (RunningJobIndex == INDEX_NONE); ++JobIndex)
 		{
-			UpdateInitialGameContentLoadPercent(1.0f);
+			if (StartupJobs[JobIndex].HasStarted() && !CompletedJobs[JobIndex])
+			{
+				RunningJobIndex = JobIndex;
+			}
 		}
+
+		// Without cycles the first waiting job can always start once everything before it has completed
+		check(RunningJobIndex != INDEX_NONE);
+		StartupJobs[RunningJobIndex].WaitForJob();
+		CompleteJob(RunningJobIndex);
+	}
+
+	if (bReportProgress && (StartupJobs.Num() == 0))
+	{
+		UpdateInitialGameContentLoadPercent(1.0f);
 	}
 
 	StartupJobs.Empty();
@@ -94,13 +94,17 @@ protected:
 	TSoftObjectPtr<ULyraPawnData> DefaultPawnData;
 
 private:
-	// Flushes the StartupJobs array. Processes all startup work.
+	// Flushes the StartupJobs array. Processes all startup work, starting each job once the jobs it depends on have completed.
 	void DoAllStartupJobs();
 
 	// Sets up the ability system
+	void InitializeNativeTags();
 	void InitializeAbilitySystem();
 	void InitializeGameplayCueManager();
 
+	// Starts loading the game data without waiting for it, GetGameData picks it up once it has loaded
+	TSharedPtr<FStreamableHandle> PreloadGameData();
+
 	// Called periodically during loads, could be used to feed the status to a loading screen
 	void UpdateInitialGameContentLoadPercent(float GameContentPercent);
 
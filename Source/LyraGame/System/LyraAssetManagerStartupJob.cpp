@@ -2,23 +2,52 @@
 
 #include "LyraAssetManagerStartupJob.h"
 #include "LyraLogChannels.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
 
-TSharedPtr<FStreamableHandle> FLyraAssetManagerStartupJob::DoJob() const
+void FLyraAssetManagerStartupJob::StartJob()
 {
-	const double JobStartTime = FPlatformTime::Seconds();
+	check(!HasStarted());
 
-	TSharedPtr<FStreamableHandle> Handle;
 	UE_LOG(LogLyra, Display, TEXT("Startup job \"%s\" starting"), *JobName);
-	JobFunc(*this, Handle);
+	StartTime = FPlatformTime::Seconds();
 
-	if (Handle.IsValid())
 	{
-		Handle->BindUpdateDelegate(FStreamableUpdateDelegate::CreateRaw(this, &FLyraAssetManagerStartupJob::UpdateSubstepProgressFromStreamable));
-		Handle->WaitUntilComplete(0.0f, false);
-		Handle->BindUpdateDelegate(FStreamableUpdateDelegate());
+		TRACE_CPUPROFILER_EVENT_SCOPE_TEXT(*JobName);
+		JobFunc(*this, LoadHandle);
 	}
 
-	UE_LOG(LogLyra, Display, TEXT("Startup job \"%s\" took %.2f seconds to complete"), *JobName, FPlatformTime::Seconds() - JobStartTime);
+	if (LoadHandle.IsValid())
+	{
+		LoadHandle->BindUpdateDelegate(FStreamableUpdateDelegate::CreateRaw(this, &FLyraAssetManagerStartupJob::UpdateSubstepProgressFromStreamable));
+	}
+
+	GameThreadSeconds = FPlatformTime::Seconds() - StartTime;
+}
+
+bool FLyraAssetManagerStartupJob::IsJobComplete() const
+{
+	return !LoadHandle.IsValid() || LoadHandle->HasLoadCompleted() || LoadHandle->WasCanceled();
+}
+
+void FLyraAssetManagerStartupJob::WaitForJob()
+{
+	const double WaitStartTime = FPlatformTime::Seconds();
+
+	if (LoadHandle.IsValid())
+	{
+		LoadHandle->WaitUntilComplete(0.0f, false);
+	}
+
+	GameThreadSeconds += FPlatformTime::Seconds() - WaitStartTime;
+}
+
+void FLyraAssetManagerStartupJob::FinishJob()
+{
+	if (LoadHandle.IsValid())
+	{
+		LoadHandle->BindUpdateDelegate(FStreamableUpdateDelegate());
+		LoadHandle.Reset();
+	}
 
-	return Handle;
+	UE_LOG(LogLyra, Display, TEXT("Startup job \"%s\" took %.2f seconds to complete (%.2f seconds blocking the game thread)"), *JobName, FPlatformTime::Seconds() - StartTime, GameThreadSeconds);
 }
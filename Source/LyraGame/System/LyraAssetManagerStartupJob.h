@@ -16,6 +16,9 @@ struct FLyraAssetManagerStartupJob
 	float JobWeight;
 	mutable double LastUpdate = 0;
 
+	/** Indices of the jobs that have to complete before this one starts, jobs can only depend on jobs added before them */
+	TArray<int32> Dependencies;
+
 	/** Simple job that is all synchronous */
 	FLyraAssetManagerStartupJob(const FString& InJobName, const TFunction<void(const FLyraAssetManagerStartupJob&, TSharedPtr<FStreamableHandle>&)>& InJobFunc, float InJobWeight)
 		: JobFunc(InJobFunc)
@@ -23,8 +26,27 @@ struct FLyraAssetManagerStartupJob
 		, JobWeight(InJobWeight)
 	{}
 
-	/** Perform actual loading, will return a handle if it created one */
-	TSharedPtr<FStreamableHandle> DoJob() const;
+	/** Takes the index returned when the other job was added */
+	FLyraAssetManagerStartupJob& DependsOn(int32 InJobIndex)
+	{
+		check(InJobIndex != INDEX_NONE);
+		Dependencies.Add(InJobIndex);
+		return *this;
+	}
+
+	/** Runs the job on the game thread, any load handle it creates is left to complete in the background */
+	void StartJob();
+
+	/** Returns true once the job and the load it started have completed */
+	bool IsJobComplete() const;
+
+	/** Blocks until the job and the load it started have completed */
+	void WaitForJob();
+
+	/** Releases the job's load handle and reports how long it took */
+	void FinishJob();
+
+	bool HasStarted() const { return StartTime > 0.0; }
 
 	void UpdateSubstepProgress(float NewProgress) const
 	{
@@ -44,4 +66,11 @@ struct FLyraAssetManagerStartupJob
 			}
 		}
 	}
+
+private:
+	TSharedPtr<FStreamableHandle> LoadHandle;
+
+	// When the job started, and how much of it was spent blocking the game thread
+	double StartTime = 0.0;
+	double GameThreadSeconds = 0.0;
 };
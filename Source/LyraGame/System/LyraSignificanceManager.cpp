@@ -1,3 +1,255 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "LyraSignificanceManager.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/PlayerController.h"
+#include "Feedback/ContextEffects/LyraContextEffectComponent.h"
+#include "UI/IndicatorSystem/IndicatorDescriptor.h"
+
+const FName ULyraSignificanceManager::CharacterTag(TEXT("Character"));
+const FName ULyraSignificanceManager::WeaponTag(TEXT("Weapon"));
+const FName ULyraSignificanceManager::ContextEffectsTag(TEXT("ContextEffects"));
+const FName ULyraSignificanceManager::IndicatorTag(TEXT("Indicator"));
+
+namespace LyraSignificance
+{
+	static FVector GetActorLocation(const UObject* Object)
+	{
+		return CastChecked<AActor>(Object)->GetActorLocation();
+	}
+
+	// Pawns can be possessed after they register, so this is checked again whenever settings are applied
+	static const FLyraSignificanceBucketSettings& GetSettingsForPawn(const APawn* Pawn, const FLyraSignificanceBucketSettings& Settings)
+	{
+		static const FLyraSignificanceBucketSettings FullRateSettings;
+		return ULyraSignificanceManager::IsRemotelyControlledOnServer(Pawn) ? FullRateSettings : Settings;
+	}
+
+	static void ApplyToCharacter(UObject* Object, ELyraSignificanceBucket Bucket, const FLyraSignificanceBucketSettings& Settings)
+	{
+		ACharacter* Character = CastChecked<ACharacter>(Object);
+		const FLyraSignificanceBucketSettings& PawnSettings = GetSettingsForPawn(Character, Settings);
+		Character->SetActorTickInterval(PawnSettings.TickInterval);
+
+		if (USkeletalMeshComponent* Mesh = Character->GetMesh())
+		{
+			Mesh->SetComponentTickInterval(PawnSettings.AnimationTickInterval);
+		}
+	}
+
+	static void ApplyToWeapon(UObject* Object, ELyraSignificanceBucket Bucket, const FLyraSignificanceBucketSettings& Settings)
+	{
+		AActor* WeaponActor = CastChecked<AActor>(Object);
+		const FLyraSignificanceBucketSettings& PawnSettings = GetSettingsForPawn(Cast<APawn>(WeaponActor->GetOwner()), Settings);
+		WeaponActor->SetActorTickInterval(PawnSettings.TickInterval);
+		WeaponActor->ForEachComponent<USkeletalMeshComponent>(/*bIncludeFromChildActors=*/ false, [&PawnSettings](USkeletalMeshComponent* Mesh)
+		{
+			Mesh->SetComponentTickInterval(PawnSettings.AnimationTickInterval);
+		});
+	}
+
+	static FVector GetContextEffectsLocation(const UObject* Object)
+	{
+		const AActor* Owner = CastChecked<UActorComponent>(Object)->GetOwner();
+		return Owner ? Owner->GetActorLocation() : FVector::ZeroVector;
+	}
+
+	static void ApplyToContextEffects(UObject* Object, ELyraSignificanceBucket Bucket, const FLyraSignificanceBucketSettings& Settings)
+	{
+		CastChecked<ULyraContextEffectComponent>(Object)->SetEffectSpawnInterval(Settings.EffectSpawnInterval);
+	}
+
+	static FVector GetIndicatorLocation(const UObject* Object)
+	{
+		// Sockets aren't used here, bone transforms aren't safe to read off the game thread
+		const USceneComponent* Component = CastChecked<UIndicatorDescriptor>(Object)->GetSceneComponent();
+		return Component ? Component->GetComponentLocation() : FVector::ZeroVector;
+	}
+
+	static void ApplyToIndicator(UObject* Object, ELyraSignificanceBucket Bucket, const FLyraSignificanceBucketSettings& Settings)
+	{
+		CastChecked<UIndicatorDescriptor>(Object)->SetCulledBySignificance(Settings.bCullIndicators);
+	}
+}
+
+ULyraSignificanceManager::ULyraSignificanceManager()
+{
+	FLyraSignificanceBucketSettings& Highest = BucketSettings[(uint8)ELyraSignificanceBucket::Highest];
+	Highest.MinSignificance = 0.9f;
+
+	FLyraSignificanceBucketSettings& High = BucketSettings[(uint8)ELyraSignificanceBucket::High];
+	High.MinSignificance = 0.75f;
+
+	FLyraSignificanceBucketSettings& Medium = BucketSettings[(uint8)ELyraSignificanceBucket::Medium];
+	Medium.MinSignificance = 0.5f;
+	Medium.TickInterval = 0.1f;
+	Medium.AnimationTickInterval = 1.0f / 30.0f;
+	Medium.EffectSpawnInterval = 0.1f;
+
+	FLyraSignificanceBucketSettings& Low = BucketSettings[(uint8)ELyraSignificanceBucket::Low];
+	Low.MinSignificance = 0.0f;
+	Low.TickInterval = 0.25f;
+	Low.AnimationTickInterval = 0.1f;
+	Low.EffectSpawnInterval = 0.5f;
+
+	Providers.Add(CharacterTag, { &LyraSignificance::GetActorLocation, &LyraSignificance::ApplyToCharacter });
+	Providers.Add(WeaponTag, { &LyraSignificance::GetActorLocation, &LyraSignificance::ApplyToWeapon });
+	Providers.Add(ContextEffectsTag, { &LyraSignificance::GetContextEffectsLocation, &LyraSignificance::ApplyToContextEffects });
+	Providers.Add(IndicatorTag, { &LyraSignificance::GetIndicatorLocation, &LyraSignificance::ApplyToIndicator });
+}
+
+void ULyraSignificanceManager::PostInitProperties()
+{
+	Super::PostInitProperties();
+
+	if (!HasAnyFlags(RF_ClassDefaultObject))
+	{
+		PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &ThisClass::OnWorldPostActorTick);
+	}
+}
+
+void ULyraSignificanceManager::BeginDestroy()
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+
+	Super::BeginDestroy();
+}
+
+void ULyraSignificanceManager::RegisterWithProvider(UObject* Object, FName ProviderTag)
+{
+	check(Object);
+
+	if (GetManagedObject(Object) != nullptr)
+	{
+		return;
+	}
+
+	const FProvider* Provider = Providers.Find(ProviderTag);
+	if (!ensureMsgf(Provider, TEXT("RegisterWithProvider: No significance provider for tag [%s]"), *ProviderTag.ToString()))
+	{
+		return;
+	}
+
+	auto GetLocation = Provider->GetLocation;
+	auto ApplyBucket = Provider->ApplyBucket;
+
+	auto SignificanceFunc = [this, GetLocation](FManagedObjectInfo* ObjectInfo, const FTransform& Viewpoint) -> float
+	{
+		return CalculateSignificance(GetLocation(ObjectInfo->GetObject()), Viewpoint);
+	};
+
+	auto PostSignificanceFunc = [this, ApplyBucket](FManagedObjectInfo* ObjectInfo, float OldSignificance, float Significance, bool bFinal)
+	{
+		// Objects leaving the manager go back to full rate, they may be reused
+		const ELyraSignificanceBucket NewBucket = bFinal ? ELyraSignificanceBucket::Highest : GetBucketForSignificance(Significance);
+		if (bFinal || (NewBucket != GetBucketForSignificance(OldSignificance)))
+		{
+			ApplyBucket(ObjectInfo->GetObject(), NewBucket, GetBucketSettings(NewBucket));
+		}
+	};
+
+	RegisterObject(Object, ProviderTag, SignificanceFunc, EPostSignificanceType::Sequential, PostSignificanceFunc);
+
+	// Replicated actors can be destroyed on clients without whoever registered them hearing about it
+	if (AActor* Actor = Cast<AActor>(Object))
+	{
+		Actor->OnDestroyed.AddUniqueDynamic(this, &ThisClass::HandleManagedActorDestroyed);
+	}
+}
+
+void ULyraSignificanceManager::HandleManagedActorDestroyed(AActor* DestroyedActor)
+{
+	if (GetManagedObject(DestroyedActor) != nullptr)
+	{
+		UnregisterObject(DestroyedActor);
+	}
+}
+
+bool ULyraSignificanceManager::IsRemotelyControlledOnServer(const APawn* Pawn)
+{
+	return Pawn && Pawn->HasAuthority() && (Pawn->GetNetMode() == NM_ListenServer) && (Pawn->GetController() != nullptr) && !Pawn->IsLocallyControlled();
+}
+
+ELyraSignificanceBucket ULyraSignificanceManager::GetBucket(const UObject* Object) const
+{
+	float Significance = 0.0f;
+	if (QuerySignificance(Object, /*out*/ Significance))
+	{
+		return GetBucketForSignificance(Significance);
+	}
+
+	return ELyraSignificanceBucket::Highest;
+}
+
+ELyraSignificanceBucket ULyraSignificanceManager::GetBucketForLocation(const FVector& Location) const
+{
+	const TArray<FTransform>& Views = GetViewpoints();
+	if (Views.Num() == 0)
+	{
+		return ELyraSignificanceBucket::Highest;
+	}
+
+	float Significance = 0.0f;
+	for (const FTransform& View : Views)
+	{
+		Significance = FMath::Max(Significance, CalculateSignificance(Location, View));
+	}
+
+	return GetBucketForSignificance(Significance);
+}
+
+ELyraSignificanceBucket ULyraSignificanceManager::GetBucketForSignificance(float Significance) const
+{
+	for (uint8 BucketIndex = 0; BucketIndex < (uint8)ELyraSignificanceBucket::Low; ++BucketIndex)
+	{
+		if (Significance >= BucketSettings[BucketIndex].MinSignificance)
+		{
+			return (ELyraSignificanceBucket)BucketIndex;
+		}
+	}
+
+	return ELyraSignificanceBucket::Low;
+}
+
+float ULyraSignificanceManager::CalculateSignificance(const FVector& Location, const FTransform& View) const
+{
+	const FVector ToLocation = Location - View.GetLocation();
+	float Distance = ToLocation.Size();
+
+	if ((ToLocation | View.GetUnitAxis(EAxis::X)) < 0.0f)
+	{
+		Distance *= BehindViewDistanceScale;
+	}
+
+	return 1.0f - FMath::Clamp(Distance / FMath::Max(MaxSignificanceDistance, 1.0f), 0.0f, 1.0f);
+}
+
+void ULyraSignificanceManager::OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (World != GetWorld())
+	{
+		return;
+	}
+
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_LyraSignificanceManager_Update);
+
+	TArray<FTransform, TInlineAllocator<4>> Views;
+	for (FConstPlayerControllerIterator Iterator = World->GetPlayerControllerIterator(); Iterator; ++Iterator)
+	{
+		const APlayerController* PC = Iterator->Get();
+		if (PC && PC->IsLocalController())
+		{
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PC->GetPlayerViewPoint(/*out*/ ViewLocation, /*out*/ ViewRotation);
+			Views.Emplace(ViewRotation, ViewLocation);
+		}
+	}
+
+	if (Views.Num() > 0)
+	{
+		Update(Views);
+	}
+}
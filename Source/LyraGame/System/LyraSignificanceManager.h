@@ -6,9 +6,126 @@
 #include "SignificanceManager.h"
 #include "LyraSignificanceManager.generated.h"
 
+class AActor;
+class APawn;
+
+/** Coarse significance levels that throttled work is configured by, from most to least significant */
+UENUM(BlueprintType)
+enum class ELyraSignificanceBucket : uint8
+{
+	Highest,
+	High,
+	Medium,
+	Low,
+
+	MAX	UMETA(Hidden)
+};
+
+/** What objects in a significance bucket are allowed to spend */
+USTRUCT()
+struct FLyraSignificanceBucketSettings
+{
+	GENERATED_BODY()
+
+	// Objects with at least this significance fall in this bucket (or a more significant one)
+	UPROPERTY(EditAnywhere, meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float MinSignificance = 0.0f;
+
+	// Actor tick interval, 0 ticks every frame
+	UPROPERTY(EditAnywhere, meta = (ClampMin = "0.0"))
+	float TickInterval = 0.0f;
+
+	// Tick interval of skeletal meshes, which is how often their animation updates, 0 updates every frame
+	UPROPERTY(EditAnywhere, meta = (ClampMin = "0.0"))
+	float AnimationTickInterval = 0.0f;
+
+	// Minimum time between effect spawns (context effects, number pops) from a single source, 0 is unlimited
+	UPROPERTY(EditAnywhere, meta = (ClampMin = "0.0"))
+	float EffectSpawnInterval = 0.0f;
+
+	// If set, indicators (nameplates, markers) in this bucket are hidden
+	UPROPERTY(EditAnywhere)
+	bool bCullIndicators = false;
+};
+
+/**
+ * ULyraSignificanceManager
+ *
+ * Rates registered objects by their distance to the local player views, then sorts them into significance
+ * buckets that scale how often they tick, animate and spawn effects.
+ *
+ * Objects register with one of the provider tags below.  The provider knows where the object is and how to
+ * apply bucket settings to it, and only gets called when the object changes bucket.  Significance is
+ * updated once per frame after actors tick from every local player's view, in parallel across objects.
+ */
 UCLASS()
-class ULyraSignificanceManager : public USignificanceManager
+class LYRAGAME_API ULyraSignificanceManager : public USignificanceManager
 {
 	GENERATED_BODY()
 
+public:
+	ULyraSignificanceManager();
+
+	static const FName CharacterTag;
+	static const FName WeaponTag;
+	static const FName ContextEffectsTag;
+	static const FName IndicatorTag;
+
+	//~UObject interface
+	virtual void PostInitProperties() override;
+	virtual void BeginDestroy() override;
+	//~End of UObject interface
+
+	/** Registers an object with the provider for the given tag, does nothing if it's already registered. Actors are unregistered when destroyed */
+	void RegisterWithProvider(UObject* Object, FName ProviderTag);
+
+	/** Returns true for pawns a listen server simulates on behalf of a remote player, which must not be throttled */
+	static bool IsRemotelyControlledOnServer(const APawn* Pawn);
+
+	/** Returns the bucket of a registered object, unregistered objects are treated as most significant */
+	ELyraSignificanceBucket GetBucket(const UObject* Object) const;
+
+	/** Returns the bucket an object at the given location would be in for the current views */
+	ELyraSignificanceBucket GetBucketForLocation(const FVector& Location) const;
+
+	const FLyraSignificanceBucketSettings& GetBucketSettings(ELyraSignificanceBucket Bucket) const
+	{
+		return BucketSettings[(uint8)Bucket];
+	}
+
+	ELyraSignificanceBucket GetBucketForSignificance(float Significance) const;
+
+	/** Significance of a location for a single view, in [0, 1] */
+	float CalculateSignificance(const FVector& Location, const FTransform& View) const;
+
+protected:
+	// Significance falls off linearly to zero at this distance from the closest view
+	UPROPERTY(Config, EditAnywhere, Category = "Significance")
+	float MaxSignificanceDistance = 20000.0f;
+
+	// Distances to objects behind a view are scaled by this, so they drop in significance sooner
+	UPROPERTY(Config, EditAnywhere, Category = "Significance")
+	float BehindViewDistanceScale = 2.0f;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Significance")
+	FLyraSignificanceBucketSettings BucketSettings[(uint8)ELyraSignificanceBucket::MAX];
+
+private:
+	struct FProvider
+	{
+		// Called from worker threads during the significance update, must only read
+		FVector (*GetLocation)(const UObject* Object);
+
+		// Called on the game thread when the object moves to a different bucket
+		void (*ApplyBucket)(UObject* Object, ELyraSignificanceBucket Bucket, const FLyraSignificanceBucketSettings& Settings);
+	};
+
+	void OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+
+	UFUNCTION()
+	void HandleManagedActorDestroyed(AActor* DestroyedActor);
+
+	TMap<FName, FProvider> Providers;
+
+	FDelegateHandle PostActorTickHandle;
 };
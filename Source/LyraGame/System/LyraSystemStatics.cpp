@@ -7,6 +7,7 @@
 #include "LyraLogChannels.h"
 #include "Components/MeshComponent.h"
 #include "GameModes/LyraUserFacingExperienceDefinition.h"
+#include "Cosmetics/LyraPawnComponent_CharacterParts.h"
 
 TSoftObjectPtr<UObject> ULyraSystemStatics::GetTypedSoftObjectReferenceFromPrimaryAssetId(FPrimaryAssetId PrimaryAssetId, TSubclassOf<UObject> ExpectedAssetType)
 {
@@ -70,10 +71,20 @@ void ULyraSystemStatics::SetScalarParameterValueOnAllMeshComponents(AActor* Targ
 {
 	if (TargetActor != nullptr)
 	{
-		TargetActor->ForEachComponent<UMeshComponent>(bIncludeChildActors, [=](UMeshComponent* InComponent)
+		auto SetParameter = [=](UMeshComponent* InComponent)
 		{
 			InComponent->SetScalarParameterValueOnMaterials(ParameterName, ParameterValue);
-		});
+		};
+
+		TargetActor->ForEachComponent<UMeshComponent>(bIncludeChildActors, SetParameter);
+
+		if (bIncludeChildActors)
+		{
+			for (AActor* PartActor : GetCharacterPartActors(TargetActor))
+			{
+				PartActor->ForEachComponent<UMeshComponent>(/*bIncludeFromChildActors=*/ true, SetParameter);
+			}
+		}
 	}
 }
 
@@ -81,10 +92,20 @@ void ULyraSystemStatics::SetVectorParameterValueOnAllMeshComponents(AActor* Targ
 {
 	if (TargetActor != nullptr)
 	{
-		TargetActor->ForEachComponent<UMeshComponent>(bIncludeChildActors, [=](UMeshComponent* InComponent)
+		auto SetParameter = [=](UMeshComponent* InComponent)
 		{
 			InComponent->SetVectorParameterValueOnMaterials(ParameterName, ParameterValue);
-		});
+		};
+
+		TargetActor->ForEachComponent<UMeshComponent>(bIncludeChildActors, SetParameter);
+
+		if (bIncludeChildActors)
+		{
+			for (AActor* PartActor : GetCharacterPartActors(TargetActor))
+			{
+				PartActor->ForEachComponent<UMeshComponent>(/*bIncludeFromChildActors=*/ true, SetParameter);
+			}
+		}
 	}
 }
 
@@ -100,6 +121,24 @@ TArray<UActorComponent*> ULyraSystemStatics::FindComponentsByClass(AActor* Targe
 	{
 		TargetActor->GetComponents(ComponentClass, /*out*/ Components, bIncludeChildActors);
 
+		if (bIncludeChildActors)
+		{
+			TArray<UActorComponent*> PartComponents;
+			for (AActor* PartActor : GetCharacterPartActors(TargetActor))
+			{
+				PartActor->GetComponents(ComponentClass, /*out*/ PartComponents, /*bIncludeFromChildActors=*/ true);
+				Components.Append(PartComponents);
+			}
+		}
 	}
 	return MoveTemp(Components);
 }
+
+TArray<AActor*> ULyraSystemStatics::GetCharacterPartActors(const AActor* TargetActor)
+{
+	if (const ULyraPawnComponent_CharacterParts* PartsComponent = (TargetActor != nullptr) ? TargetActor->FindComponentByClass<ULyraPawnComponent_CharacterParts>() : nullptr)
+	{
+		return PartsComponent->GetCharacterPartActors();
+	}
+	return TArray<AActor*>();
+}
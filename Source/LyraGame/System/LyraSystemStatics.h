@@ -41,4 +41,7 @@ public:
 	// Gets all the components that inherit from the given class
 	UFUNCTION(BlueprintCallable, Category = "Actor", meta=(DefaultToSelf="TargetActor", ComponentClass="ActorComponent", DeterminesOutputType="ComponentClass"))
 	static TArray<UActorComponent*> FindComponentsByClass(AActor* TargetActor, TSubclassOf<UActorComponent> ComponentClass, bool bIncludeChildActors = true);
+
+	// Gets the actors spawned for the character parts of the TargetActor; they are attached to it rather than child actors, so the helpers above also visit them when bIncludeChildActors is set
+	static TArray<AActor*> GetCharacterPartActors(const AActor* TargetActor);
 };
@@ -2,6 +2,8 @@
 
 #include "LyraTeamAgentInterface.h"
 #include "LyraLogChannels.h"
+#include "LyraTeamSubsystem.h"
+#include "Engine/World.h"
 
 ULyraTeamAgentInterface::ULyraTeamAgentInterface(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -18,6 +20,12 @@ void ILyraTeamAgentInterface::ConditionalBroadcastTeamChanged(TScriptInterface<I
 		UObject* ThisObj = This.GetObject();
 		UE_LOG(LogLyraTeams, Verbose, TEXT("[%s] %s assigned team %d"), *GetClientServerContextString(ThisObj), *GetPathNameSafe(ThisObj), NewTeamIndex);
 
+		// Let the team subsystem track the team of this agent from now on
+		if (ULyraTeamSubsystem* TeamSubsystem = UWorld::GetSubsystem<ULyraTeamSubsystem>(ThisObj->GetWorld()))
+		{
+			TeamSubsystem->RegisterTeamAgent(This);
+		}
+
 		This.GetInterface()->GetTeamChangedDelegateChecked().Broadcast(ThisObj, OldTeamIndex, NewTeamIndex);
 	}
 }
@@ -8,6 +8,7 @@
 #include "Engine/Texture.h"
 
 #include "LyraTeamSubsystem.h"
+#include "System/LyraSystemStatics.h"
 
 void ULyraTeamDisplayAsset::ApplyToMaterial(UMaterialInstanceDynamic* Material)
 {
@@ -90,7 +91,7 @@ void ULyraTeamDisplayAsset::ApplyToActor(AActor* TargetActor, bool bIncludeChild
 {
 	if (TargetActor != nullptr)
 	{
-		TargetActor->ForEachComponent(bIncludeChildActors, [=](UActorComponent* InComponent)
+		auto ApplyToComponent = [=](UActorComponent* InComponent)
 		{
 			if (UMeshComponent* MeshComponent = Cast<UMeshComponent>(InComponent))
 			{
@@ -100,7 +101,18 @@ void ULyraTeamDisplayAsset::ApplyToActor(AActor* TargetActor, bool bIncludeChild
 			{
 				ApplyToNiagaraComponent(NiagaraComponent);
 			}
-		});
+		};
+
+		TargetActor->ForEachComponent(bIncludeChildActors, ApplyToComponent);
+
+		// Character parts are attached actors rather than child actors
+		if (bIncludeChildActors)
+		{
+			for (AActor* PartActor : ULyraSystemStatics::GetCharacterPartActors(TargetActor))
+			{
+				PartActor->ForEachComponent(/*bIncludeFromChildActors=*/ true, ApplyToComponent);
+			}
+		}
 	}
 }
 
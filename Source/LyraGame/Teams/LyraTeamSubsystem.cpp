@@ -80,6 +80,8 @@ void ULyraTeamSubsystem::Deinitialize()
 {
 	UCheatManager::UnregisterFromOnCheatManagerCreated(CheatManagerRegistrationHandle);
 
+	AgentTeamMap.Reset();
+
 	Super::Deinitialize();
 }
 
@@ -122,8 +124,75 @@ bool ULyraTeamSubsystem::ChangeTeamForActor(AActor* ActorToChange, int32 NewTeam
 	}
 }
 
+void ULyraTeamSubsystem::RegisterTeamAgent(TScriptInterface<ILyraTeamAgentInterface> Agent)
+{
+	UObject* AgentObject = Agent.GetObject();
+	ILyraTeamAgentInterface* AgentInterface = Agent.GetInterface();
+	if ((AgentObject == nullptr) || (AgentInterface == nullptr) || AgentTeamMap.Contains(AgentObject))
+	{
+		return;
+	}
+
+	FOnLyraTeamIndexChangedDelegate* TeamChangedDelegate = AgentInterface->GetOnTeamIndexChangedDelegate();
+	if (TeamChangedDelegate == nullptr)
+	{
+		// Can't keep track of the team without the delegate, so this agent keeps going through the slow path
+		return;
+	}
+
+	TeamChangedDelegate->AddDynamic(this, &ThisClass::HandleTeamAgentTeamChanged);
+	if (AActor* AgentActor = Cast<AActor>(AgentObject))
+	{
+		AgentActor->OnEndPlay.AddDynamic(this, &ThisClass::HandleTeamAgentEndPlay);
+	}
+
+	AgentTeamMap.Add(AgentObject, GenericTeamIdToInteger(AgentInterface->GetGenericTeamId()));
+}
+
+void ULyraTeamSubsystem::UnregisterTeamAgent(UObject* Agent)
+{
+	if (AgentTeamMap.Remove(Agent) == 0)
+	{
+		return;
+	}
+
+	if (ILyraTeamAgentInterface* AgentInterface = Cast<ILyraTeamAgentInterface>(Agent))
+	{
+		if (FOnLyraTeamIndexChangedDelegate* TeamChangedDelegate = AgentInterface->GetOnTeamIndexChangedDelegate())
+		{
+			TeamChangedDelegate->RemoveDynamic(this, &ThisClass::HandleTeamAgentTeamChanged);
+		}
+	}
+
+	if (AActor* AgentActor = Cast<AActor>(Agent))
+	{
+		AgentActor->OnEndPlay.RemoveDynamic(this, &ThisClass::HandleTeamAgentEndPlay);
+	}
+}
+
+void ULyraTeamSubsystem::HandleTeamAgentTeamChanged(UObject* ObjectChangingTeam, int32 OldTeamID, int32 NewTeamID)
+{
+	if (int32* TeamId = AgentTeamMap.Find(ObjectChangingTeam))
+	{
+		*TeamId = NewTeamID;
+	}
+}
+
+void ULyraTeamSubsystem::HandleTeamAgentEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason)
+{
+	UnregisterTeamAgent(Actor);
+}
+
 int32 ULyraTeamSubsystem::FindTeamFromObject(const UObject* TestObject) const
 {
+	// See if it's a registered team agent
+	bool bRegistered;
+	const int32 RegisteredTeamId = FindTeamFromRegisteredAgent(TestObject, /*out*/ bRegistered);
+	if (bRegistered)
+	{
+		return RegisteredTeamId;
+	}
+
 	// See if it's directly a team agent
 	if (const ILyraTeamAgentInterface* ObjectWithTeamInterface = Cast<ILyraTeamAgentInterface>(TestObject))
 	{
@@ -133,7 +202,14 @@ int32 ULyraTeamSubsystem::FindTeamFromObject(const UObject* TestObject) const
 	if (const AActor* TestActor = Cast<const AActor>(TestObject))
 	{
 		// See if the instigator is a team actor
-		if (const ILyraTeamAgentInterface* InstigatorWithTeamInterface = Cast<ILyraTeamAgentInterface>(TestActor->GetInstigator()))
+		APawn* Instigator = TestActor->GetInstigator();
+		const int32 InstigatorTeamId = FindTeamFromRegisteredAgent(Instigator, /*out*/ bRegistered);
+		if (bRegistered)
+		{
+			return InstigatorTeamId;
+		}
+
+		if (const ILyraTeamAgentInterface* InstigatorWithTeamInterface = Cast<ILyraTeamAgentInterface>(Instigator))
 		{
 			return GenericTeamIdToInteger(InstigatorWithTeamInterface->GetGenericTeamId());
 		}
@@ -148,6 +224,15 @@ int32 ULyraTeamSubsystem::FindTeamFromObject(const UObject* TestObject) const
 	return INDEX_NONE;
 }
 
+void ULyraTeamSubsystem::FindTeamsForObjects(TConstArrayView<const UObject*> TestObjects, TArray<int32>& OutTeamIds) const
+{
+	OutTeamIds.Reset(TestObjects.Num());
+	for (const UObject* TestObject : TestObjects)
+	{
+		OutTeamIds.Add(FindTeamFromObject(TestObject));
+	}
+}
+
 const ALyraPlayerState* ULyraTeamSubsystem::FindPlayerStateFromActor(const AActor* PossibleTeamActor) const
 {
 	if (PossibleTeamActor != nullptr)
@@ -5,13 +5,16 @@
 #include "CoreMinimal.h"
 #include "Subsystems/WorldSubsystem.h"
 #include "GameplayTagContainer.h"
+#include "Engine/EngineTypes.h"
 
 #include "LyraTeamSubsystem.generated.h"
 
+class AActor;
 class ALyraTeamInfoBase;
 class ALyraTeamPublicInfo;
 class ALyraTeamPrivateInfo;
 class ALyraPlayerState;
+class ILyraTeamAgentInterface;
 class ULyraTeamDisplayAsset;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnLyraTeamDisplayAssetChangedDelegate, const ULyraTeamDisplayAsset*, DisplayAsset);
@@ -74,9 +77,17 @@ public:
 	// Note: This function can only be called on the authority
 	bool ChangeTeamForActor(AActor* ActorToChange, int32 NewTeamId);
 
+	// Starts tracking the team of a team agent through its team changed delegate, so looking it up doesn't have to go through the agent
+	// Note: Agents are registered automatically the first time they broadcast a team change
+	void RegisterTeamAgent(TScriptInterface<ILyraTeamAgentInterface> Agent);
+	void UnregisterTeamAgent(UObject* Agent);
+
 	// Returns the team this object belongs to, or INDEX_NONE if it is not part of a team
 	int32 FindTeamFromObject(const UObject* TestObject) const;
 
+	// Returns the team of each object in OutTeamIds (in the same order), using INDEX_NONE for objects that are not part of a team
+	void FindTeamsForObjects(TConstArrayView<const UObject*> TestObjects, TArray<int32>& OutTeamIds) const;
+
 	// Returns the associated player state for this actor, or INDEX_NONE if it is not associated with a player
 	const ALyraPlayerState* FindPlayerStateFromActor(const AActor* PossibleTeamActor) const;
 
@@ -134,9 +145,27 @@ public:
 	// Register for a team display asset notification for the specified team ID
 	FOnLyraTeamDisplayAssetChangedDelegate& GetTeamDisplayAssetChangedDelegate(int32 TeamId);
 
+private:
+	UFUNCTION()
+	void HandleTeamAgentTeamChanged(UObject* ObjectChangingTeam, int32 OldTeamID, int32 NewTeamID);
+
+	UFUNCTION()
+	void HandleTeamAgentEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason);
+
+	// Returns the team of a registered team agent, or INDEX_NONE if it is not registered or not part of a team
+	FORCEINLINE int32 FindTeamFromRegisteredAgent(const UObject* Agent, bool& bOutRegistered) const
+	{
+		const int32* TeamId = AgentTeamMap.Find(Agent);
+		bOutRegistered = TeamId != nullptr;
+		return bOutRegistered ? *TeamId : INDEX_NONE;
+	}
+
 private:
 	UPROPERTY()
 	TMap<int32, FLyraTeamTrackingInfo> TeamMap;
 
+	// Team of every registered team agent, kept up to date by their team changed delegates
+	TMap<TObjectKey<UObject>, int32> AgentTeamMap;
+
 	FDelegateHandle CheatManagerRegistrationHandle;
 };
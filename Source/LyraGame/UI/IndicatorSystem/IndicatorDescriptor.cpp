@@ -7,33 +7,24 @@ bool FIndicatorProjection::Project(const UIndicatorDescriptor& IndicatorDescript
 {
 	if (USceneComponent* Component = IndicatorDescriptor.GetSceneComponent())
 	{
-		TOptional<FVector> WorldLocation;
-		if (IndicatorDescriptor.GetComponentSocketName() != NAME_None)
-		{
-			WorldLocation = Component->GetSocketTransform(IndicatorDescriptor.GetComponentSocketName()).GetLocation();
-		}
-		else
-		{
-			WorldLocation = Component->GetComponentLocation();
-		}
-
-		const FVector ProjectWorldLocation = WorldLocation.GetValue() + IndicatorDescriptor.GetWorldPositionOffset();
 		const EActorCanvasProjectionMode ProjectionMode = IndicatorDescriptor.GetProjectionMode();
 		
 		switch (ProjectionMode)
 		{
 			case EActorCanvasProjectionMode::ComponentPoint:
+			case EActorCanvasProjectionMode::ActorBoundingBox:
+			case EActorCanvasProjectionMode::ComponentBoundingBox:
 			{
-				if (WorldLocation.IsSet())
+				FVector ProjectPoint;
+				GetProjectionPoint(IndicatorDescriptor, ProjectPoint);
+
+				FVector2D OutScreenSpacePosition;
+				if (ULocalPlayer::GetPixelPoint(InProjectionData, ProjectPoint, OutScreenSpacePosition, &ScreenSize))
 				{
-					FVector2D OutScreenSpacePosition;
-					if (ULocalPlayer::GetPixelPoint(InProjectionData, ProjectWorldLocation, OutScreenSpacePosition, &ScreenSize))
-					{
-						OutScreenSpacePosition += IndicatorDescriptor.GetScreenSpaceOffset();
+					OutScreenSpacePosition += IndicatorDescriptor.GetScreenSpaceOffset();
 
-						OutScreenPositionWithDepth = FVector(OutScreenSpacePosition.X, OutScreenSpacePosition.Y, FVector::Dist(InProjectionData.ViewOrigin, ProjectWorldLocation));
-						return true;
-					}
+					OutScreenPositionWithDepth = FVector(OutScreenSpacePosition.X, OutScreenSpacePosition.Y, FVector::Dist(InProjectionData.ViewOrigin, ProjectPoint));
+					return true;
 				}
 
 				return false;
@@ -54,6 +45,7 @@ bool FIndicatorProjection::Project(const UIndicatorDescriptor& IndicatorDescript
 				FVector2D LL, UR;
 				if (ULocalPlayer::GetPixelBoundingBox(InProjectionData, IndicatorBox, LL, UR, &ScreenSize))
 				{
+					const FVector ProjectWorldLocation = Component->GetSocketLocation(IndicatorDescriptor.GetComponentSocketName()) + IndicatorDescriptor.GetWorldPositionOffset();
 					const FVector& BoundingBoxAnchor = IndicatorDescriptor.GetBoundingBoxAnchor();
 					const FVector2D& ScreenSpaceOffset = IndicatorDescriptor.GetScreenSpaceOffset();
 					
@@ -65,32 +57,53 @@ bool FIndicatorProjection::Project(const UIndicatorDescriptor& IndicatorDescript
 
 				return false;
 			}
-			case EActorCanvasProjectionMode::ActorBoundingBox:
-			case EActorCanvasProjectionMode::ComponentBoundingBox:
-			{
-				FBox IndicatorBox;
-				if (ProjectionMode == EActorCanvasProjectionMode::ActorBoundingBox)
-				{
-					IndicatorBox = Component->GetOwner()->GetComponentsBoundingBox();
-				}
-				else
-				{
-					IndicatorBox = Component->Bounds.GetBox();
-				}
+		}
+	}
 
-				const FVector ProjectBoxPoint = IndicatorBox.GetCenter() + (IndicatorBox.GetSize() * (IndicatorDescriptor.GetBoundingBoxAnchor() - FVector(0.5)));
+	return false;
+}
 
-				FVector2D OutScreenSpacePosition;
-				if (ULocalPlayer::GetPixelPoint(InProjectionData, ProjectBoxPoint, OutScreenSpacePosition, &ScreenSize))
-				{
-					OutScreenSpacePosition += IndicatorDescriptor.GetScreenSpaceOffset();
+bool FIndicatorProjection::GetProjectionPoint(const UIndicatorDescriptor& IndicatorDescriptor, FVector& OutWorldPoint)
+{
+	USceneComponent* Component = IndicatorDescriptor.GetSceneComponent();
+	if (!Component)
+	{
+		return false;
+	}
 
-					OutScreenPositionWithDepth = FVector(OutScreenSpacePosition.X, OutScreenSpacePosition.Y, FVector::Dist(InProjectionData.ViewOrigin, ProjectBoxPoint));
-					return true;
-				}
+	const EActorCanvasProjectionMode ProjectionMode = IndicatorDescriptor.GetProjectionMode();
+	switch (ProjectionMode)
+	{
+		case EActorCanvasProjectionMode::ComponentPoint:
+		{
+			FVector WorldLocation;
+			if (IndicatorDescriptor.GetComponentSocketName() != NAME_None)
+			{
+				WorldLocation = Component->GetSocketTransform(IndicatorDescriptor.GetComponentSocketName()).GetLocation();
+			}
+			else
+			{
+				WorldLocation = Component->GetComponentLocation();
+			}
 
-				return false;
+			OutWorldPoint = WorldLocation + IndicatorDescriptor.GetWorldPositionOffset();
+			return true;
+		}
+		case EActorCanvasProjectionMode::ActorBoundingBox:
+		case EActorCanvasProjectionMode::ComponentBoundingBox:
+		{
+			FBox IndicatorBox;
+			if (ProjectionMode == EActorCanvasProjectionMode::ActorBoundingBox)
+			{
+				IndicatorBox = Component->GetOwner()->GetComponentsBoundingBox();
 			}
+			else
+			{
+				IndicatorBox = Component->Bounds.GetBox();
+			}
+
+			OutWorldPoint = IndicatorBox.GetCenter() + (IndicatorBox.GetSize() * (IndicatorDescriptor.GetBoundingBoxAnchor() - FVector(0.5)));
+			return true;
 		}
 	}
 
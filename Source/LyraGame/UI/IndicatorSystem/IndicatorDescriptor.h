@@ -17,6 +17,9 @@ class ULyraIndicatorManagerComponent;
 struct FIndicatorProjection
 {
 	bool Project(const UIndicatorDescriptor& IndicatorDescriptor, const FSceneViewProjectionData& InProjectionData, const FVector2D& ScreenSize, FVector& ScreenPositionWithDepth);
+
+	/** Gets the world point projected for the indicator, false for the screen bounding box modes which don't project a single point */
+	static bool GetProjectionPoint(const UIndicatorDescriptor& IndicatorDescriptor, FVector& OutWorldPoint);
 };
 
 UENUM(BlueprintType)
@@ -88,7 +91,7 @@ public:
 	//=======================
 
 	UFUNCTION(BlueprintCallable)
-	bool GetIsVisible() const { return IsValid(GetSceneComponent()) && bVisible; }
+	bool GetIsVisible() const { return IsValid(GetSceneComponent()) && bVisible && !bCulledBySignificance; }
 	
 	UFUNCTION(BlueprintCallable)
 	void SetDesiredVisibility(bool InVisible)
@@ -96,6 +99,12 @@ public:
 		bVisible = InVisible;
 	}
 
+	// Set by the significance manager to hide indicators that are too far away to matter.
+	void SetCulledBySignificance(bool bInCulled)
+	{
+		bCulledBySignificance = bInCulled;
+	}
+
 	UFUNCTION(BlueprintCallable)
 	EActorCanvasProjectionMode GetProjectionMode() const { return ProjectionMode; }
 	UFUNCTION(BlueprintCallable)
@@ -158,6 +167,15 @@ public:
 		ScreenSpaceOffset = Offset;
 	}
 
+	// Indicators further than this from the view are hidden, 0 never hides them.
+	UFUNCTION(BlueprintCallable)
+	float GetMaxVisibleDistance() const { return MaxVisibleDistance; }
+	UFUNCTION(BlueprintCallable)
+	void SetMaxVisibleDistance(float InMaxVisibleDistance)
+	{
+		MaxVisibleDistance = InMaxVisibleDistance;
+	}
+
 	UFUNCTION(BlueprintCallable)
 	FVector GetBoundingBoxAnchor() const { return BoundingBoxAnchor; }
 	UFUNCTION(BlueprintCallable)
@@ -198,6 +216,8 @@ private:
 	bool bOverrideScreenPosition = false;
 	UPROPERTY()
 	bool bAutoRemoveWhenIndicatorComponentIsNull = false;
+	UPROPERTY(Transient)
+	bool bCulledBySignificance = false;
 
 	UPROPERTY()
 	EActorCanvasProjectionMode ProjectionMode = EActorCanvasProjectionMode::ComponentPoint;
@@ -215,6 +235,8 @@ private:
 	FVector2D ScreenSpaceOffset = FVector2D(0, 0);
 	UPROPERTY()
 	FVector WorldPositionOffset = FVector(0, 0, 0);
+	UPROPERTY()
+	float MaxVisibleDistance = 0.0f;
 
 private:
 	friend class SActorCanvas;
@@ -3,6 +3,7 @@
 #include "LyraIndicatorManagerComponent.h"
 
 #include "IndicatorDescriptor.h"
+#include "System/LyraSignificanceManager.h"
 
 ULyraIndicatorManagerComponent::ULyraIndicatorManagerComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -26,6 +27,11 @@ void ULyraIndicatorManagerComponent::AddIndicator(UIndicatorDescriptor* Indicato
 	IndicatorDescriptor->SetIndicatorManagerComponent(this);
 	OnIndicatorAdded.Broadcast(IndicatorDescriptor);
 	Indicators.Add(IndicatorDescriptor);
+
+	if (ULyraSignificanceManager* SignificanceManager = USignificanceManager::Get<ULyraSignificanceManager>(GetWorld()))
+	{
+		SignificanceManager->RegisterWithProvider(IndicatorDescriptor, ULyraSignificanceManager::IndicatorTag);
+	}
 }
 
 void ULyraIndicatorManagerComponent::RemoveIndicator(UIndicatorDescriptor* IndicatorDescriptor)
@@ -34,6 +40,11 @@ void ULyraIndicatorManagerComponent::RemoveIndicator(UIndicatorDescriptor* Indic
 	{
 		ensure(IndicatorDescriptor->GetIndicatorManagerComponent() == this);
 	
+		if (ULyraSignificanceManager* SignificanceManager = USignificanceManager::Get<ULyraSignificanceManager>(GetWorld()))
+		{
+			SignificanceManager->UnregisterObject(IndicatorDescriptor);
+		}
+
 		OnIndicatorRemoved.Broadcast(IndicatorDescriptor);
 		Indicators.Remove(IndicatorDescriptor);
 	}
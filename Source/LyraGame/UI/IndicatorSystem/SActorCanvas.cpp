@@ -8,6 +8,11 @@
 #include "LyraIndicatorManagerComponent.h"
 #include "Widgets/Layout/SBox.h"
 
+DECLARE_STATS_GROUP(TEXT("Lyra Indicators"), STATGROUP_LyraIndicators, STATCAT_Advanced);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Indicators Projected"), STAT_LyraIndicatorsProjected, STATGROUP_LyraIndicators);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Indicators Culled"), STAT_LyraIndicatorsCulled, STATGROUP_LyraIndicators);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Indicators Arranged"), STAT_LyraIndicatorsArranged, STATGROUP_LyraIndicators);
+
 namespace EArrowDirection
 {
 	enum Type
@@ -194,6 +199,8 @@ EActiveTimerReturnType SActorCanvas::UpdateCanvas(double InCurrentTime, float In
 
 			bool IndicatorsChanged = false;
 
+			ProjectionBatch.Reset();
+
 			for (int32 ChildIndex = 0; ChildIndex < CanvasChildren.Num(); ++ChildIndex)
 			{
 				SActorCanvas::FSlot& CurChild = CanvasChildren[ChildIndex];
@@ -227,35 +234,55 @@ EActiveTimerReturnType SActorCanvas::UpdateCanvas(double InCurrentTime, float In
 					IndicatorsChanged = true;
 				}
 
+				// Single point indicators are projected together after this loop
+				FVector WorldPoint;
+				if (FIndicatorProjection::GetProjectionPoint(*Indicator, /*out*/ WorldPoint))
+				{
+					const FVector RelativeLocation = WorldPoint - ProjectionData.ViewOrigin;
+					const float Depth = RelativeLocation.Size();
+					const float MaxVisibleDistance = Indicator->GetMaxVisibleDistance();
+					if ((MaxVisibleDistance > 0.0f) && (Depth > MaxVisibleDistance))
+					{
+						IndicatorsChanged |= ApplyProjection(CurChild, false, FVector::ZeroVector, PaintGeometry.Size);
+					}
+					else
+					{
+						ProjectionBatch.Add(CurChild, RelativeLocation, Depth);
+					}
+					continue;
+				}
+
 				FVector ScreenPositionWithDepth;
 
 				FIndicatorProjection Projector;
-				const bool Success = Projector.Project(*Indicator, ProjectionData, PaintGeometry.Size, OUT ScreenPositionWithDepth);
+				bool Success = Projector.Project(*Indicator, ProjectionData, PaintGeometry.Size, OUT ScreenPositionWithDepth);
+				INC_DWORD_STAT(STAT_LyraIndicatorsProjected);
 
-				if (!Success)
+				const float MaxVisibleDistance = Indicator->GetMaxVisibleDistance();
+				if (Success && (MaxVisibleDistance > 0.0f) && (ScreenPositionWithDepth.Z > MaxVisibleDistance))
 				{
-					CurChild.SetHasValidScreenPosition(false);
-					CurChild.SetInFrontOfCamera(false);
-
-					IndicatorsChanged |= CurChild.bIsDirty();
-					CurChild.ClearDirtyFlag();
-					continue;
+					Success = false;
 				}
 
-				CurChild.SetInFrontOfCamera(Success);
-				CurChild.SetHasValidScreenPosition(CurChild.GetInFrontOfCamera() || Indicator->GetClampToScreen());
+				IndicatorsChanged |= ApplyProjection(CurChild, Success, ScreenPositionWithDepth, PaintGeometry.Size);
+			}
 
-				if (CurChild.HasValidScreenPosition())
-				{
-					// Only dirty the screen position if we can actually show this indicator.
-					CurChild.SetScreenPosition(FVector2D(ScreenPositionWithDepth));
-					CurChild.SetDepth(ScreenPositionWithDepth.X);
-				}
+			const int32 NumBatched = ProjectionBatch.Slots.Num();
+			if (NumBatched > 0)
+			{
+				// Positions are relative to the view origin, so the view translation is left out of the matrix
+				ProjectionBatch.Project(ProjectionData.ViewRotationMatrix * ProjectionData.ProjectionMatrix, PaintGeometry.Size);
+				INC_DWORD_STAT_BY(STAT_LyraIndicatorsProjected, NumBatched);
 
-				CurChild.SetPriority(Indicator->GetPriority());
+				for (int32 BatchIndex = 0; BatchIndex < NumBatched; ++BatchIndex)
+				{
+					SActorCanvas::FSlot& CurChild = *ProjectionBatch.Slots[BatchIndex];
+					const FVector2D ScreenSpaceOffset = CurChild.Indicator->GetScreenSpaceOffset();
+					const bool bInFrontOfCamera = (ProjectionBatch.Z[BatchIndex] >= 0.0f);
 
-				IndicatorsChanged |= CurChild.bIsDirty();
-				CurChild.ClearDirtyFlag();
+					const FVector ScreenPositionWithDepth(ProjectionBatch.X[BatchIndex] + ScreenSpaceOffset.X, ProjectionBatch.Y[BatchIndex] + ScreenSpaceOffset.Y, ProjectionBatch.Depth[BatchIndex]);
+					IndicatorsChanged |= ApplyProjection(CurChild, bInFrontOfCamera, ScreenPositionWithDepth, PaintGeometry.Size);
+				}
 			}
 
 			if (IndicatorsChanged)
@@ -284,6 +311,109 @@ EActiveTimerReturnType SActorCanvas::UpdateCanvas(double InCurrentTime, float In
 	}
 }
 
+void SActorCanvas::FProjectionBatch::Reset()
+{
+	X.Reset();
+	Y.Reset();
+	Z.Reset();
+	Depth.Reset();
+	Slots.Reset();
+}
+
+void SActorCanvas::FProjectionBatch::Add(FSlot& Slot, const FVector& RelativeLocation, float InDepth)
+{
+	X.Add(RelativeLocation.X);
+	Y.Add(RelativeLocation.Y);
+	Z.Add(RelativeLocation.Z);
+	Depth.Add(InDepth);
+	Slots.Add(&Slot);
+}
+
+void SActorCanvas::FProjectionBatch::Project(const FMatrix& ViewRotationProjectionMatrix, const FVector2D& ScreenSize)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_SActorCanvas_ProjectBatch);
+
+	// Pad with points at the view origin so every load and store is a full vector
+	const int32 NumPadded = Align(Slots.Num(), 4);
+	X.SetNumZeroed(NumPadded);
+	Y.SetNumZeroed(NumPadded);
+	Z.SetNumZeroed(NumPadded);
+
+	const FMatrix& M = ViewRotationProjectionMatrix;
+	const VectorRegister4Float M00 = VectorSetFloat1((float)M.M[0][0]), M10 = VectorSetFloat1((float)M.M[1][0]), M20 = VectorSetFloat1((float)M.M[2][0]), M30 = VectorSetFloat1((float)M.M[3][0]);
+	const VectorRegister4Float M01 = VectorSetFloat1((float)M.M[0][1]), M11 = VectorSetFloat1((float)M.M[1][1]), M21 = VectorSetFloat1((float)M.M[2][1]), M31 = VectorSetFloat1((float)M.M[3][1]);
+	const VectorRegister4Float M03 = VectorSetFloat1((float)M.M[0][3]), M13 = VectorSetFloat1((float)M.M[1][3]), M23 = VectorSetFloat1((float)M.M[2][3]), M33 = VectorSetFloat1((float)M.M[3][3]);
+
+	const VectorRegister4Float Half = VectorSetFloat1(0.5f);
+	const VectorRegister4Float ScreenWidth = VectorSetFloat1((float)ScreenSize.X);
+	const VectorRegister4Float ScreenHeight = VectorSetFloat1((float)ScreenSize.Y);
+
+	for (int32 Index = 0; Index < NumPadded; Index += 4)
+	{
+		const VectorRegister4Float PosX = VectorLoad(&X[Index]);
+		const VectorRegister4Float PosY = VectorLoad(&Y[Index]);
+		const VectorRegister4Float PosZ = VectorLoad(&Z[Index]);
+
+		const VectorRegister4Float ClipX = VectorMultiplyAdd(PosX, M00, VectorMultiplyAdd(PosY, M10, VectorMultiplyAdd(PosZ, M20, M30)));
+		const VectorRegister4Float ClipY = VectorMultiplyAdd(PosX, M01, VectorMultiplyAdd(PosY, M11, VectorMultiplyAdd(PosZ, M21, M31)));
+		const VectorRegister4Float ClipW = VectorMultiplyAdd(PosX, M03, VectorMultiplyAdd(PosY, M13, VectorMultiplyAdd(PosZ, M23, M33)));
+
+		// Same mapping as ULocalPlayer::GetPixelPoint
+		const VectorRegister4Float SafeW = VectorSelect(VectorCompareEQ(ClipW, GlobalVectorConstants::FloatZero), GlobalVectorConstants::FloatOne, VectorAbs(ClipW));
+		const VectorRegister4Float RHW = VectorDivide(GlobalVectorConstants::FloatOne, SafeW);
+
+		const VectorRegister4Float ScreenX = VectorMultiply(VectorMultiplyAdd(VectorMultiply(ClipX, RHW), Half, Half), ScreenWidth);
+		const VectorRegister4Float ScreenY = VectorMultiply(VectorSubtract(Half, VectorMultiply(VectorMultiply(ClipY, RHW), Half)), ScreenHeight);
+
+		VectorStore(ScreenX, &X[Index]);
+		VectorStore(ScreenY, &Y[Index]);
+		VectorStore(ClipW, &Z[Index]);
+	}
+}
+
+bool SActorCanvas::ApplyProjection(FSlot& CurChild, bool bProjected, const FVector& ScreenPositionWithDepth, const FVector2D& CanvasSize)
+{
+	const UIndicatorDescriptor* Indicator = CurChild.Indicator;
+
+	bool bOnScreen = bProjected;
+	if (bProjected && !Indicator->GetClampToScreen())
+	{
+		// The widget's size from the last layout is enough margin for any alignment
+		const FVector2D Margin = CurChild.GetWidget()->GetDesiredSize();
+		bOnScreen = (ScreenPositionWithDepth.X >= -Margin.X) && (ScreenPositionWithDepth.X <= CanvasSize.X + Margin.X) &&
+			(ScreenPositionWithDepth.Y >= -Margin.Y) && (ScreenPositionWithDepth.Y <= CanvasSize.Y + Margin.Y);
+	}
+
+	if (!bProjected)
+	{
+		CurChild.SetHasValidScreenPosition(false);
+		CurChild.SetInFrontOfCamera(false);
+	}
+	else
+	{
+		CurChild.SetInFrontOfCamera(true);
+		CurChild.SetHasValidScreenPosition(bOnScreen);
+
+		if (CurChild.HasValidScreenPosition())
+		{
+			// Only dirty the screen position if we can actually show this indicator.
+			CurChild.SetScreenPosition(FVector2D(ScreenPositionWithDepth));
+			CurChild.SetDepth(ScreenPositionWithDepth.X);
+		}
+
+		CurChild.SetPriority(Indicator->GetPriority());
+	}
+
+	if (!bOnScreen)
+	{
+		INC_DWORD_STAT(STAT_LyraIndicatorsCulled);
+	}
+
+	const bool bChanged = CurChild.bIsDirty();
+	CurChild.ClearDirtyFlag();
+	return bChanged;
+}
+
 void SActorCanvas::SetShowAnyIndicators(bool bIndicators)
 {
 	if (bShowAnyIndicators != bIndicators)
@@ -313,11 +443,19 @@ void SActorCanvas::OnArrangeChildren(const FGeometry& AllottedGeometry, FArrange
 		const FIntPoint FixedPadding = FIntPoint(10.0f, 10.0f) + FIntPoint(ArrowWidgetSize.X, ArrowWidgetSize.Y);
 		const FVector Center = FVector(AllottedGeometry.Size * 0.5f, 0.0f);
 
-		// Sort the children
+		// Sort the children, hidden and culled ones are skipped before any layout work
 		TArray<const SActorCanvas::FSlot*> SortedSlots;
 		for (int32 ChildIndex = 0; ChildIndex < CanvasChildren.Num(); ++ChildIndex)
 		{
-			SortedSlots.Add(&CanvasChildren[ChildIndex]);
+			const SActorCanvas::FSlot& CurChild = CanvasChildren[ChildIndex];
+			if (ArrangedChildren.Accepts(CurChild.GetWidget()->GetVisibility()))
+			{
+				SortedSlots.Add(&CurChild);
+			}
+			else
+			{
+				CurChild.SetWasIndicatorClamped(false);
+			}
 		}
 
 		SortedSlots.StableSort([](const SActorCanvas::FSlot& A, const SActorCanvas::FSlot& B)
@@ -332,13 +470,6 @@ void SActorCanvas::OnArrangeChildren(const FGeometry& AllottedGeometry, FArrange
 			const SActorCanvas::FSlot& CurChild = *SortedSlots[ChildIndex];
 			const UIndicatorDescriptor* Indicator = CurChild.Indicator;
 
-			// Skip this indicator if it's invalid or has an invalid world position
-			if (!ArrangedChildren.Accepts(CurChild.GetWidget()->GetVisibility()))
-			{
-				CurChild.SetWasIndicatorClamped(false);
-				continue;
-			}
-
 			FVector2D ScreenPosition = CurChild.GetScreenPosition();
 			const bool bInFrontOfCamera = CurChild.GetInFrontOfCamera();
 
@@ -471,6 +602,7 @@ void SActorCanvas::OnArrangeChildren(const FGeometry& AllottedGeometry, FArrange
 			}
 
 			CurChild.SetWasIndicatorClamped(bWasIndicatorClamped);
+			INC_DWORD_STAT(STAT_LyraIndicatorsArranged);
 
 			// Add the information about this child to the output list (ArrangedChildren)
 			ArrangedChildren.AddWidget(AllottedGeometry.MakeChild(
@@ -215,6 +215,24 @@ private:
 	void SetShowAnyIndicators(bool bIndicators);
 	EActiveTimerReturnType UpdateCanvas(double InCurrentTime, float InDeltaTime);
 
+	/** Single point indicators gathered for the batched projection, as a structure of arrays padded to the SIMD width */
+	struct FProjectionBatch
+	{
+		// Positions relative to the view origin, replaced by the screen position (X, Y) and clip space W after projection
+		TArray<float> X;
+		TArray<float> Y;
+		TArray<float> Z;
+		TArray<float> Depth;
+		TArray<FSlot*> Slots;
+
+		void Reset();
+		void Add(FSlot& Slot, const FVector& RelativeLocation, float Depth);
+		void Project(const FMatrix& ViewRotationProjectionMatrix, const FVector2D& ScreenSize);
+	};
+
+	/** Applies a projection result to the slot, culling it if it's off screen, returns true if the slot changed */
+	bool ApplyProjection(FSlot& CurChild, bool bProjected, const FVector& ScreenPositionWithDepth, const FVector2D& CanvasSize);
+
 	/** Helper function for calculating the offset */
 	void GetOffsetAndSize(const UIndicatorDescriptor* Indicator,
 		FVector2D& OutSize, 
@@ -251,4 +269,7 @@ private:
 	mutable TOptional<FGeometry> OptionalPaintGeometry;
 
 	TSharedPtr<FActiveTimerHandle> TickHandle;
+
+	/** Reused by every canvas update */
+	FProjectionBatch ProjectionBatch;
 };
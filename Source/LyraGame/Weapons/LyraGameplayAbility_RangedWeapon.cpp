@@ -9,6 +9,7 @@
 #include "NativeGameplayTags.h"
 #include "GameFramework/GameplayMessageSubsystem.h"
 #include "Weapons/LyraWeaponStateComponent.h"
+#include "Weapons/LyraLagCompensationSubsystem.h"
 #include "Teams/LyraTeamSubsystem.h"
 #include "AbilitySystemComponent.h"
 #include "GameFramework/PlayerController.h"
@@ -38,6 +39,20 @@ namespace LyraConsoleVariables
 		DrawBulletHitRadius,
 		TEXT("When bullet hit debug drawing is enabled (see DrawBulletHitDuration), how big should the hit radius be? (in uu)"),
 		ECVF_Default);
+
+	static float LagCompensationHitTolerance = 20.0f;
+	static FAutoConsoleVariableRef CVarLagCompensationHitTolerance(
+		TEXT("lyra.LagCompensation.HitTolerance"),
+		LagCompensationHitTolerance,
+		TEXT("How far (in uu) a client's bullet may pass from the rewound hitboxes of the pawn it claims to hit, negative disables validation"),
+		ECVF_Default);
+
+	static bool bAsyncBulletTraces = true;
+	static FAutoConsoleVariableRef CVarAsyncBulletTraces(
+		TEXT("lyra.Weapon.AsyncBulletTraces"),
+		bAsyncBulletTraces,
+		TEXT("Should weapons fired by the authority without a predicting client (e.g., bots) trace their bullets asynchronously, batched with every other trace of the frame?"),
+		ECVF_Default);
 }
 
 // Weapon fire will be blocked/canceled if the player has this tag
@@ -143,33 +158,27 @@ ECollisionChannel ULyraGameplayAbility_RangedWeapon::DetermineTraceChannel(FColl
 	return Lyra_TraceChannel_Weapon;
 }
 
-FHitResult ULyraGameplayAbility_RangedWeapon::WeaponTrace(const FVector& StartTrace, const FVector& EndTrace, float SweepRadius, bool bIsSimulated, OUT TArray<FHitResult>& OutHitResults) const
+ECollisionChannel ULyraGameplayAbility_RangedWeapon::InitWeaponTraceParams(FCollisionQueryParams& TraceParams, bool bIsSimulated) const
 {
-	TArray<FHitResult> HitResults;
-	
-	FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(WeaponTrace), /*bTraceComplex=*/ true, /*IgnoreActor=*/ GetAvatarActorFromActorInfo());
+	TraceParams.bTraceComplex = true;
+	TraceParams.AddIgnoredActor(GetAvatarActorFromActorInfo());
 	TraceParams.bReturnPhysicalMaterial = true;
 	AddAdditionalTraceIgnoreActors(TraceParams);
 	//TraceParams.bDebugQuery = true;
 
-	const ECollisionChannel TraceChannel = DetermineTraceChannel(TraceParams, bIsSimulated);
-
-	if (SweepRadius > 0.0f)
-	{
-		GetWorld()->SweepMultiByChannel(HitResults, StartTrace, EndTrace, FQuat::Identity, TraceChannel, FCollisionShape::MakeSphere(SweepRadius), TraceParams);
-	}
-	else
-	{
-		GetWorld()->LineTraceMultiByChannel(HitResults, StartTrace, EndTrace, TraceChannel, TraceParams);
-	}
+	return DetermineTraceChannel(TraceParams, bIsSimulated);
+}
 
+// Turns the raw hits of a weapon trace into the hits of a bullet, returning the last one as the impact
+static FHitResult FilterWeaponTraceHits(const FVector& StartTrace, const FVector& EndTrace, const TArray<FHitResult>& HitResults, OUT TArray<FHitResult>& OutHitResults)
+{
 	FHitResult Hit(ForceInit);
 	if (HitResults.Num() > 0)
 	{
 		// Filter the output list to prevent multiple hits on the same actor;
 		// this is to prevent a single bullet dealing damage multiple times to
 		// a single actor if using an overlap trace
-		for (FHitResult& CurHitResult : HitResults)
+		for (const FHitResult& CurHitResult : HitResults)
 		{
 			auto Pred = [&CurHitResult](const FHitResult& Other)
 			{
@@ -193,6 +202,45 @@ FHitResult ULyraGameplayAbility_RangedWeapon::WeaponTrace(const FVector& StartTr
 	return Hit;
 }
 
+// If the sweep hit a pawn, it should replace the line trace's hits unless they contain something blocking in front of that pawn
+static bool ShouldUseSweepHits(const TArray<FHitResult>& LineHits, const TArray<FHitResult>& SweepHits, int32 FirstPawnIdx)
+{
+	for (int32 Idx = 0; Idx < FirstPawnIdx; ++Idx)
+	{
+		const FHitResult& CurHitResult = SweepHits[Idx];
+
+		auto Pred = [&CurHitResult](const FHitResult& Other)
+		{
+			return Other.HitObjectHandle == CurHitResult.HitObjectHandle;
+		};
+		if (CurHitResult.bBlockingHit && LineHits.ContainsByPredicate(Pred))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+FHitResult ULyraGameplayAbility_RangedWeapon::WeaponTrace(const FVector& StartTrace, const FVector& EndTrace, float SweepRadius, bool bIsSimulated, OUT TArray<FHitResult>& OutHitResults) const
+{
+	TArray<FHitResult> HitResults;
+	
+	FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(WeaponTrace));
+	const ECollisionChannel TraceChannel = InitWeaponTraceParams(TraceParams, bIsSimulated);
+
+	if (SweepRadius > 0.0f)
+	{
+		GetWorld()->SweepMultiByChannel(HitResults, StartTrace, EndTrace, FQuat::Identity, TraceChannel, FCollisionShape::MakeSphere(SweepRadius), TraceParams);
+	}
+	else
+	{
+		GetWorld()->LineTraceMultiByChannel(HitResults, StartTrace, EndTrace, TraceChannel, TraceParams);
+	}
+
+	return FilterWeaponTraceHits(StartTrace, EndTrace, HitResults, /*out*/ OutHitResults);
+}
+
 FVector ULyraGameplayAbility_RangedWeapon::GetWeaponTargetingSourceLocation() const
 {
 	// Use Pawn's location as a base
@@ -325,23 +373,7 @@ FHitResult ULyraGameplayAbility_RangedWeapon::DoSingleBulletTrace(const FVector&
 			{
 				// If we had a blocking hit in our line trace that occurs in SweepHits before our
 				// hit pawn, we should just use our initial hit results since the Pawn hit should be blocked
-				bool bUseSweepHits = true;
-				for (int32 Idx = 0; Idx < FirstPawnIdx; ++Idx)
-				{
-					const FHitResult& CurHitResult = SweepHits[Idx];
-
-					auto Pred = [&CurHitResult](const FHitResult& Other)
-					{
-						return Other.HitObjectHandle == CurHitResult.HitObjectHandle;
-					};
-					if (CurHitResult.bBlockingHit && OutHits.ContainsByPredicate(Pred))
-					{
-						bUseSweepHits = false;
-						break;
-					}
-				}
-
-				if (bUseSweepHits)
+				if (ShouldUseSweepHits(OutHits, SweepHits, FirstPawnIdx))
 				{
 					OutHits = SweepHits;
 				}
@@ -352,14 +384,13 @@ FHitResult ULyraGameplayAbility_RangedWeapon::DoSingleBulletTrace(const FVector&
 	return Impact;
 }
 
-void ULyraGameplayAbility_RangedWeapon::PerformLocalTargeting(OUT TArray<FHitResult>& OutHits)
+bool ULyraGameplayAbility_RangedWeapon::InitLocalFiringInput(OUT FRangedWeaponFiringInput& InputData) const
 {
 	APawn* const AvatarPawn = Cast<APawn>(GetAvatarActorFromActorInfo());
 
 	ULyraRangedWeaponInstance* WeaponData = GetWeaponInstance();
 	if (AvatarPawn && AvatarPawn->IsLocallyControlled() && WeaponData)
 	{
-		FRangedWeaponFiringInput InputData;
 		InputData.WeaponData = WeaponData;
 		InputData.bCanPlayBulletFX = (AvatarPawn->GetNetMode() != NM_DedicatedServer);
 
@@ -378,65 +409,201 @@ void ULyraGameplayAbility_RangedWeapon::PerformLocalTargeting(OUT TArray<FHitRes
 		}
 #endif
 
+		return true;
+	}
+
+	return false;
+}
+
+void ULyraGameplayAbility_RangedWeapon::PerformLocalTargeting(OUT TArray<FHitResult>& OutHits)
+{
+	FRangedWeaponFiringInput InputData;
+	if (InitLocalFiringInput(/*out*/ InputData))
+	{
 		TraceBulletsInCartridge(InputData, /*out*/ OutHits);
 	}
 }
 
-void ULyraGameplayAbility_RangedWeapon::TraceBulletsInCartridge(const FRangedWeaponFiringInput& InputData, OUT TArray<FHitResult>& OutHits)
+void ULyraGameplayAbility_RangedWeapon::GetBulletTraceEnds(const FRangedWeaponFiringInput& InputData, OUT TArray<FVector>& OutTraceEnds) const
 {
 	ULyraRangedWeaponInstance* WeaponData = InputData.WeaponData;
 	check(WeaponData);
 
 	const int32 BulletsPerCartridge = WeaponData->GetBulletsPerCartridge();
+	OutTraceEnds.Reset(BulletsPerCartridge);
+
+	const float BaseSpreadAngle = WeaponData->GetCalculatedSpreadAngle();
+	const float SpreadAngleMultiplier = WeaponData->GetCalculatedSpreadAngleMultiplier();
+	const float ActualSpreadAngle = BaseSpreadAngle * SpreadAngleMultiplier;
+
+	const float HalfSpreadAngleInRadians = FMath::DegreesToRadians(ActualSpreadAngle * 0.5f);
 
 	for (int32 BulletIndex = 0; BulletIndex < BulletsPerCartridge; ++BulletIndex)
 	{
-		const float BaseSpreadAngle = WeaponData->GetCalculatedSpreadAngle();
-		const float SpreadAngleMultiplier = WeaponData->GetCalculatedSpreadAngleMultiplier();
-		const float ActualSpreadAngle = BaseSpreadAngle * SpreadAngleMultiplier;
+		const FVector BulletDir = VRandConeNormalDistribution(InputData.AimDir, HalfSpreadAngleInRadians, WeaponData->GetSpreadExponent());
 
-		const float HalfSpreadAngleInRadians = FMath::DegreesToRadians(ActualSpreadAngle * 0.5f);
+		OutTraceEnds.Add(InputData.StartTrace + (BulletDir * WeaponData->GetMaxDamageRange()));
+	}
+}
 
-		const FVector BulletDir = VRandConeNormalDistribution(InputData.AimDir, HalfSpreadAngleInRadians, WeaponData->GetSpreadExponent());
+void ULyraGameplayAbility_RangedWeapon::AddBulletHits(const FVector& EndTrace, FHitResult& Impact, const TArray<FHitResult>& AllImpacts, OUT TArray<FHitResult>& OutHits) const
+{
+	const AActor* HitActor = Impact.GetActor();
+
+	if (HitActor)
+	{
+#if ENABLE_DRAW_DEBUG
+		if (LyraConsoleVariables::DrawBulletHitDuration > 0.0f)
+		{
+			DrawDebugPoint(GetWorld(), Impact.ImpactPoint, LyraConsoleVariables::DrawBulletHitRadius, FColor::Red, false, LyraConsoleVariables::DrawBulletHitRadius);
+		}
+#endif
+
+		if (AllImpacts.Num() > 0)
+		{
+			OutHits.Append(AllImpacts);
+		}
+	}
 
-		const FVector EndTrace = InputData.StartTrace + (BulletDir * WeaponData->GetMaxDamageRange());
-		FVector HitLocation = EndTrace;
+	// Make sure there's always an entry in OutHits so the direction can be used for tracers, etc...
+	if (OutHits.Num() == 0)
+	{
+		if (!Impact.bBlockingHit)
+		{
+			// Locate the fake 'impact' at the end of the trace
+			Impact.Location = EndTrace;
+			Impact.ImpactPoint = EndTrace;
+		}
 
+		OutHits.Add(Impact);
+	}
+}
+
+void ULyraGameplayAbility_RangedWeapon::TraceBulletsInCartridge(const FRangedWeaponFiringInput& InputData, OUT TArray<FHitResult>& OutHits)
+{
+	ULyraRangedWeaponInstance* WeaponData = InputData.WeaponData;
+	check(WeaponData);
+
+	TArray<FVector> TraceEnds;
+	GetBulletTraceEnds(InputData, /*out*/ TraceEnds);
+
+	for (const FVector& EndTrace : TraceEnds)
+	{
 		TArray<FHitResult> AllImpacts;
 
 		FHitResult Impact = DoSingleBulletTrace(InputData.StartTrace, EndTrace, WeaponData->GetBulletTraceSweepRadius(), /*bIsSimulated=*/ false, /*out*/ AllImpacts);
 
-		const AActor* HitActor = Impact.GetActor();
+		AddBulletHits(EndTrace, Impact, AllImpacts, /*out*/ OutHits);
+	}
+}
+
+bool ULyraGameplayAbility_RangedWeapon::StartAsyncLocalTargeting()
+{
+	// Only the authority can wait for the results: a predicting client has to send its target data inside
+	// the activation's prediction window. Player controllers also keep synchronous traces so a listen
+	// server host doesn't get a frame of extra latency, which leaves bots.
+	if (NumPendingBulletTraces > 0 || !CurrentActorInfo->IsNetAuthority())
+	{
+		return false;
+	}
+
+	AController* Controller = GetControllerFromActorInfo();
+	if ((Controller == nullptr) || Controller->IsA<APlayerController>())
+	{
+		return false;
+	}
+
+	FRangedWeaponFiringInput InputData;
+	if (!InitLocalFiringInput(/*out*/ InputData))
+	{
+		return false;
+	}
+
+	TArray<FVector> TraceEnds;
+	GetBulletTraceEnds(InputData, /*out*/ TraceEnds);
+
+	FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(WeaponTrace));
+	const ECollisionChannel TraceChannel = InitWeaponTraceParams(TraceParams, /*bIsSimulated=*/ false);
+	const float SweepRadius = InputData.WeaponData->GetBulletTraceSweepRadius();
+
+	UWorld* World = GetWorld();
+	++PendingBatchId;
+	PendingBulletTraces.Reset(TraceEnds.Num());
+
+	for (int32 BulletIndex = 0; BulletIndex < TraceEnds.Num(); ++BulletIndex)
+	{
+		FAsyncBulletTrace& Bullet = PendingBulletTraces.AddDefaulted_GetRef();
+		Bullet.StartTrace = InputData.StartTrace;
+		Bullet.EndTrace = TraceEnds[BulletIndex];
+		Bullet.SweepRadius = SweepRadius;
 
-		if (HitActor)
-		{
 #if ENABLE_DRAW_DEBUG
-			if (LyraConsoleVariables::DrawBulletHitDuration > 0.0f)
-			{
-				DrawDebugPoint(GetWorld(), Impact.ImpactPoint, LyraConsoleVariables::DrawBulletHitRadius, FColor::Red, false, LyraConsoleVariables::DrawBulletHitRadius);
-			}
-#endif
+		if (LyraConsoleVariables::DrawBulletTracesDuration > 0.0f)
+		{
+			static float DebugThickness = 1.0f;
+			DrawDebugLine(World, Bullet.StartTrace, Bullet.EndTrace, FColor::Red, false, LyraConsoleVariables::DrawBulletTracesDuration, 0, DebugThickness);
+		}
+#endif // ENABLE_DRAW_DEBUG
 
-			if (AllImpacts.Num() > 0)
-			{
-				OutHits.Append(AllImpacts);
-			}
+		const FTraceDelegate LineDelegate = FTraceDelegate::CreateUObject(this, &ThisClass::OnAsyncBulletTraceDone, PendingBatchId, BulletIndex, /*bSweep=*/ false);
+		World->AsyncLineTraceByChannel(EAsyncTraceType::Multi, Bullet.StartTrace, Bullet.EndTrace, TraceChannel, TraceParams, FCollisionResponseParams::DefaultResponseParam, &LineDelegate);
+		++NumPendingBulletTraces;
 
-			HitLocation = Impact.ImpactPoint;
+		// The sweep is only used if the line trace misses every pawn, but waiting for that would cost another frame
+		if (SweepRadius > 0.0f)
+		{
+			const FTraceDelegate SweepDelegate = FTraceDelegate::CreateUObject(this, &ThisClass::OnAsyncBulletTraceDone, PendingBatchId, BulletIndex, /*bSweep=*/ true);
+			World->AsyncSweepByChannel(EAsyncTraceType::Multi, Bullet.StartTrace, Bullet.EndTrace, FQuat::Identity, TraceChannel, FCollisionShape::MakeSphere(SweepRadius), TraceParams, FCollisionResponseParams::DefaultResponseParam, &SweepDelegate);
+			++NumPendingBulletTraces;
 		}
+	}
+
+	return true;
+}
+
+void ULyraGameplayAbility_RangedWeapon::OnAsyncBulletTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum, uint32 BatchId, int32 BulletIndex, bool bSweep)
+{
+	// The ability ended (or fired again) since these traces were submitted
+	if ((BatchId != PendingBatchId) || !PendingBulletTraces.IsValidIndex(BulletIndex))
+	{
+		return;
+	}
+
+	FAsyncBulletTrace& Bullet = PendingBulletTraces[BulletIndex];
+	(bSweep ? Bullet.SweepHits : Bullet.LineHits) = MoveTemp(TraceDatum.OutHits);
 
-		// Make sure there's always an entry in OutHits so the direction can be used for tracers, etc...
-		if (OutHits.Num() == 0)
+	if (--NumPendingBulletTraces > 0)
+	{
+		return;
+	}
+
+	// Resolve every bullet the same way DoSingleBulletTrace does
+	TArray<FHitResult> FoundHits;
+	for (FAsyncBulletTrace& PendingBullet : PendingBulletTraces)
+	{
+		TArray<FHitResult> AllImpacts;
+		FHitResult Impact = FilterWeaponTraceHits(PendingBullet.StartTrace, PendingBullet.EndTrace, PendingBullet.LineHits, /*out*/ AllImpacts);
+
+		if ((FindFirstPawnHitResult(AllImpacts) == INDEX_NONE) && (PendingBullet.SweepRadius > 0.0f))
 		{
-			if (!Impact.bBlockingHit)
+			TArray<FHitResult> SweepHits;
+			Impact = FilterWeaponTraceHits(PendingBullet.StartTrace, PendingBullet.EndTrace, PendingBullet.SweepHits, /*out*/ SweepHits);
+
+			const int32 FirstPawnIdx = FindFirstPawnHitResult(SweepHits);
+			if (SweepHits.IsValidIndex(FirstPawnIdx) && ShouldUseSweepHits(AllImpacts, SweepHits, FirstPawnIdx))
 			{
-				// Locate the fake 'impact' at the end of the trace
-				Impact.Location = EndTrace;
-				Impact.ImpactPoint = EndTrace;
+				AllImpacts = MoveTemp(SweepHits);
 			}
-
-			OutHits.Add(Impact);
 		}
+
+		AddBulletHits(PendingBullet.EndTrace, Impact, AllImpacts, /*out*/ FoundHits);
+	}
+
+	PendingBulletTraces.Reset();
+
+	if (IsActive())
+	{
+		FinishRangedWeaponTargeting(FoundHits);
 	}
 }
 
@@ -469,6 +636,11 @@ void ULyraGameplayAbility_RangedWeapon::EndAbility(const FGameplayAbilitySpecHan
 		UAbilitySystemComponent* MyAbilityComponent = CurrentActorInfo->AbilitySystemComponent.Get();
 		check(MyAbilityComponent);
 
+		// Drop any cartridge still waiting for async trace results
+		++PendingBatchId;
+		NumPendingBulletTraces = 0;
+		PendingBulletTraces.Reset();
+
 		// When ability ends, consume target data and remove delegate
 		MyAbilityComponent->AbilityTargetDataSetDelegate(CurrentSpecHandle, CurrentActivationInfo.GetActivationPredictionKey()).Remove(OnTargetDataReadyCallbackDelegateHandle);
 		MyAbilityComponent->ConsumeClientReplicatedTargetData(CurrentSpecHandle, CurrentActivationInfo.GetActivationPredictionKey());
@@ -506,6 +678,12 @@ void ULyraGameplayAbility_RangedWeapon::OnTargetDataReadyCallback(const FGamepla
 			{
 				if (Controller->GetLocalRole() == ROLE_Authority)
 				{
+					// Rewind the targets of a remote client's hits to when they fired, replacing the hits that don't line up
+					if (!CurrentActorInfo->IsLocallyControlled())
+					{
+						ValidateRemoteHits(Controller, LocalTargetDataHandle);
+					}
+
 					// Confirm hit markers
 					if (ULyraWeaponStateComponent* WeaponStateComponent = Controller->FindComponentByClass<ULyraWeaponStateComponent>())
 					{
@@ -552,6 +730,49 @@ void ULyraGameplayAbility_RangedWeapon::OnTargetDataReadyCallback(const FGamepla
 	MyAbilityComponent->ConsumeClientReplicatedTargetData(CurrentSpecHandle, CurrentActivationInfo.GetActivationPredictionKey());
 }
 
+void ULyraGameplayAbility_RangedWeapon::ValidateRemoteHits(AController* Controller, FGameplayAbilityTargetDataHandle& TargetData) const
+{
+	ULyraLagCompensationSubsystem* LagCompensation = GetWorld()->GetSubsystem<ULyraLagCompensationSubsystem>();
+	if (!LagCompensation || (LyraConsoleVariables::LagCompensationHitTolerance < 0.0f))
+	{
+		return;
+	}
+
+	const ULyraRangedWeaponInstance* WeaponData = GetWeaponInstance();
+	const float Tolerance = LyraConsoleVariables::LagCompensationHitTolerance + (WeaponData ? WeaponData->GetBulletTraceSweepRadius() : 0.0f);
+	const double RewindTime = LagCompensation->GetRewindTime(Controller);
+
+	for (int32 Idx = 0; Idx < TargetData.Num(); ++Idx)
+	{
+		FGameplayAbilityTargetData_SingleTargetHit* SingleTargetHit = static_cast<FGameplayAbilityTargetData_SingleTargetHit*>(TargetData.Get(Idx));
+		if (!SingleTargetHit)
+		{
+			continue;
+		}
+
+		FHitResult& HitResult = SingleTargetHit->HitResult;
+
+		// Hits on things attached to a pawn count as hits on the pawn, the same way FindFirstPawnHitResult sees them
+		const AActor* HitActor = HitResult.GetActor();
+		const APawn* HitPawn = Cast<APawn>(HitActor);
+		if (!HitPawn && HitActor)
+		{
+			HitPawn = Cast<APawn>(HitActor->GetAttachParentActor());
+		}
+
+		if (HitPawn && !LagCompensation->ValidateHit(HitPawn, RewindTime, HitResult.TraceStart, HitResult.TraceEnd, Tolerance))
+		{
+			UE_LOG(LogLyraAbilitySystem, Verbose, TEXT("Rejected hit on %s from %s, it doesn't line up with the target's rewound hitboxes"), *GetNameSafe(HitPawn), *GetNameSafe(Controller));
+
+			// Keep the trace for tracers, but turn it into a miss
+			HitResult = FHitResult(HitResult.TraceStart, HitResult.TraceEnd);
+			HitResult.Location = HitResult.TraceEnd;
+			HitResult.ImpactPoint = HitResult.TraceEnd;
+			SingleTargetHit->bHitReplaced = true;
+		}
+	}
+}
+
 void ULyraGameplayAbility_RangedWeapon::StartRangedWeaponTargeting()
 {
 	check(CurrentActorInfo);
@@ -564,13 +785,32 @@ void ULyraGameplayAbility_RangedWeapon::StartRangedWeaponTargeting()
 
 	AController* Controller = GetControllerFromActorInfo();
 	check(Controller);
-	ULyraWeaponStateComponent* WeaponStateComponent = Controller->FindComponentByClass<ULyraWeaponStateComponent>();
 
-	FScopedPredictionWindow ScopedPrediction(MyAbilityComponent, CurrentActivationInfo.GetActivationPredictionKey());
+	if (LyraConsoleVariables::bAsyncBulletTraces && StartAsyncLocalTargeting())
+	{
+		// FinishRangedWeaponTargeting is called once the traces complete
+		return;
+	}
 
 	TArray<FHitResult> FoundHits;
 	PerformLocalTargeting(/*out*/ FoundHits);
 
+	FinishRangedWeaponTargeting(FoundHits);
+}
+
+void ULyraGameplayAbility_RangedWeapon::FinishRangedWeaponTargeting(const TArray<FHitResult>& FoundHits)
+{
+	check(CurrentActorInfo);
+
+	UAbilitySystemComponent* MyAbilityComponent = CurrentActorInfo->AbilitySystemComponent.Get();
+	check(MyAbilityComponent);
+
+	AController* Controller = GetControllerFromActorInfo();
+	check(Controller);
+	ULyraWeaponStateComponent* WeaponStateComponent = Controller->FindComponentByClass<ULyraWeaponStateComponent>();
+
+	FScopedPredictionWindow ScopedPrediction(MyAbilityComponent, CurrentActivationInfo.GetActivationPredictionKey());
+
 	// Fill out the target data from the hit results
 	FGameplayAbilityTargetDataHandle TargetData;
 	TargetData.UniqueId = WeaponStateComponent ? WeaponStateComponent->GetUnconfirmedServerSideHitMarkerCount() : 0;
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Equipment/LyraGameplayAbility_FromEquipment.h"
+#include "WorldCollision.h"
 
 #include "LyraGameplayAbility_RangedWeapon.generated.h"
 
@@ -79,9 +80,23 @@ protected:
 		}
 	};
 
+	// A single bullet of a cartridge traced asynchronously, both traces are issued up front so results arrive in one frame
+	struct FAsyncBulletTrace
+	{
+		FVector StartTrace = FVector::ZeroVector;
+		FVector EndTrace = FVector::ZeroVector;
+		float SweepRadius = 0.0f;
+
+		TArray<FHitResult> LineHits;
+		TArray<FHitResult> SweepHits;
+	};
+
 protected:
 	static int32 FindFirstPawnHitResult(const TArray<FHitResult>& HitResults);
 
+	// Sets up the query params shared by every weapon trace and returns the channel to trace on
+	ECollisionChannel InitWeaponTraceParams(FCollisionQueryParams& TraceParams, bool bIsSimulated) const;
+
 	// Does a single weapon trace, either sweeping or ray depending on if SweepRadius is above zero
 	FHitResult WeaponTrace(const FVector& StartTrace, const FVector& EndTrace, float SweepRadius, bool bIsSimulated, OUT TArray<FHitResult>& OutHitResults) const;
 
@@ -91,11 +106,28 @@ protected:
 	// Traces all of the bullets in a single cartridge
 	void TraceBulletsInCartridge(const FRangedWeaponFiringInput& InputData, OUT TArray<FHitResult>& OutHits);
 
+	// Picks the direction of every bullet in a cartridge, returning the end of each trace
+	void GetBulletTraceEnds(const FRangedWeaponFiringInput& InputData, OUT TArray<FVector>& OutTraceEnds) const;
+
+	// Adds the hits of one bullet to the cartridge's hits, making sure there is always at least one entry
+	void AddBulletHits(const FVector& EndTrace, FHitResult& Impact, const TArray<FHitResult>& AllImpacts, OUT TArray<FHitResult>& OutHits) const;
+
+	// Submits the traces of a cartridge to the world's async trace batch, they complete next frame
+	bool StartAsyncLocalTargeting();
+
+	void OnAsyncBulletTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum, uint32 BatchId, int32 BulletIndex, bool bSweep);
+
+	// Turns the hits into target data and processes them, the second half of StartRangedWeaponTargeting
+	void FinishRangedWeaponTargeting(const TArray<FHitResult>& FoundHits);
+
 	virtual void AddAdditionalTraceIgnoreActors(FCollisionQueryParams& TraceParams) const;
 
 	// Determine the trace channel to use for the weapon trace(s)
 	virtual ECollisionChannel DetermineTraceChannel(FCollisionQueryParams& TraceParams, bool bIsSimulated) const;
 
+	// Fills out the firing input for a locally controlled avatar, returns false if it can't fire
+	bool InitLocalFiringInput(OUT FRangedWeaponFiringInput& OutInputData) const;
+
 	void PerformLocalTargeting(OUT TArray<FHitResult>& OutHits);
 
 	FVector GetWeaponTargetingSourceLocation() const;
@@ -103,6 +135,9 @@ protected:
 
 	void OnTargetDataReadyCallback(const FGameplayAbilityTargetDataHandle& InData, FGameplayTag ApplicationTag);
 
+	// Checks the hits a remote client sent against the lag compensation history, turning the ones that don't line up into misses
+	void ValidateRemoteHits(AController* Controller, FGameplayAbilityTargetDataHandle& TargetData) const;
+
 	UFUNCTION(BlueprintCallable)
 	void StartRangedWeaponTargeting();
 
@@ -112,4 +147,9 @@ protected:
 
 private:
 	FDelegateHandle OnTargetDataReadyCallbackDelegateHandle;
+
+	// Cartridge waiting for async trace results, identified by PendingBatchId so stale results are dropped
+	TArray<FAsyncBulletTrace> PendingBulletTraces;
+	int32 NumPendingBulletTraces = 0;
+	uint32 PendingBatchId = 0;
 };
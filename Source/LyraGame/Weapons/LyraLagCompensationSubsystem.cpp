@@ -0,0 +1,240 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LyraLagCompensationSubsystem.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/PlayerState.h"
+
+namespace LyraConsoleVariables
+{
+	static float LagCompensationMaxRewindTime = 0.4f;
+	static FAutoConsoleVariableRef CVarLagCompensationMaxRewindTime(
+		TEXT("lyra.LagCompensation.MaxRewindTime"),
+		LagCompensationMaxRewindTime,
+		TEXT("How far back (in seconds) the server will rewind targets when validating a client's hits"),
+		ECVF_Default);
+}
+
+ULyraLagCompensationSubsystem::ULyraLagCompensationSubsystem()
+{
+	HitBones.Add({ TEXT("head"), FVector(15.0f) });
+	HitBones.Add({ TEXT("spine_03"), FVector(20.0f, 25.0f, 25.0f) });
+	HitBones.Add({ TEXT("pelvis"), FVector(20.0f, 25.0f, 20.0f) });
+}
+
+void ULyraLagCompensationSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	HistoryCapacity = FMath::Max(HistoryCapacity, 2);
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &ThisClass::OnWorldPostActorTick);
+}
+
+void ULyraLagCompensationSubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+	PawnHistories.Empty();
+
+	Super::Deinitialize();
+}
+
+void ULyraLagCompensationSubsystem::RegisterPawn(APawn* Pawn)
+{
+	check(Pawn);
+
+	// Only servers validate hits
+	const ENetMode NetMode = Pawn->GetNetMode();
+	if ((NetMode != NM_DedicatedServer) && (NetMode != NM_ListenServer))
+	{
+		return;
+	}
+
+	const ACharacter* Character = Cast<ACharacter>(Pawn);
+	if (!Character || !Character->GetCapsuleComponent())
+	{
+		return;
+	}
+
+	FPawnHistory& History = PawnHistories.FindOrAdd(Pawn);
+	History.Pawn = Pawn;
+	History.Mesh = Character->GetMesh();
+	History.Head = 0;
+	History.NumSnapshots = 0;
+
+	const int32 NumFloats = HistoryCapacity * GetNumBoxesPadded();
+	History.Times.SetNumZeroed(HistoryCapacity);
+	History.CenterX.SetNumZeroed(NumFloats);
+	History.CenterY.SetNumZeroed(NumFloats);
+	History.CenterZ.SetNumZeroed(NumFloats);
+	History.ExtentX.SetNumZeroed(NumFloats);
+	History.ExtentY.SetNumZeroed(NumFloats);
+	History.ExtentZ.SetNumZeroed(NumFloats);
+
+	RecordSnapshot(History, GetWorld()->GetTimeSeconds());
+}
+
+void ULyraLagCompensationSubsystem::UnregisterPawn(APawn* Pawn)
+{
+	PawnHistories.Remove(Pawn);
+}
+
+int32 ULyraLagCompensationSubsystem::GetHistoryBytesPerPawn() const
+{
+	return HistoryCapacity * (sizeof(double) + GetNumBoxesPadded() * 6 * sizeof(float));
+}
+
+void ULyraLagCompensationSubsystem::OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if ((World != GetWorld()) || (PawnHistories.Num() == 0))
+	{
+		return;
+	}
+
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_LyraLagCompensation_RecordSnapshots);
+
+	const double Time = World->GetTimeSeconds();
+	for (auto It = PawnHistories.CreateIterator(); It; ++It)
+	{
+		if (It->Value.Pawn.IsValid())
+		{
+			RecordSnapshot(It->Value, Time);
+		}
+		else
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void ULyraLagCompensationSubsystem::RecordSnapshot(FPawnHistory& History, double Time) const
+{
+	const ACharacter* Character = CastChecked<ACharacter>(History.Pawn.Get());
+	const UCapsuleComponent* Capsule = Character->GetCapsuleComponent();
+	const USkeletalMeshComponent* Mesh = History.Mesh.Get();
+
+	const int32 Snapshot = History.Head;
+	const int32 First = Snapshot * GetNumBoxesPadded();
+
+	History.Times[Snapshot] = Time;
+
+	const FVector CapsuleCenter = Capsule->GetComponentLocation();
+	const float CapsuleRadius = Capsule->GetScaledCapsuleRadius();
+	History.CenterX[First] = CapsuleCenter.X;
+	History.CenterY[First] = CapsuleCenter.Y;
+	History.CenterZ[First] = CapsuleCenter.Z;
+	History.ExtentX[First] = CapsuleRadius;
+	History.ExtentY[First] = CapsuleRadius;
+	History.ExtentZ[First] = Capsule->GetScaledCapsuleHalfHeight();
+
+	for (int32 BoneIdx = 0; BoneIdx < HitBones.Num(); ++BoneIdx)
+	{
+		const FLyraLagCompensationBone& Bone = HitBones[BoneIdx];
+		const int32 BoneIndex = Mesh ? Mesh->GetBoneIndex(Bone.BoneName) : INDEX_NONE;
+
+		// A missing bone collapses into the capsule center, which the capsule box already covers
+		const FVector BoneLocation = (BoneIndex != INDEX_NONE) ? Mesh->GetBoneTransform(BoneIndex).GetLocation() : CapsuleCenter;
+		const FVector BoneExtent = (BoneIndex != INDEX_NONE) ? Bone.Extent : FVector::ZeroVector;
+
+		const int32 Box = First + 1 + BoneIdx;
+		History.CenterX[Box] = BoneLocation.X;
+		History.CenterY[Box] = BoneLocation.Y;
+		History.CenterZ[Box] = BoneLocation.Z;
+		History.ExtentX[Box] = BoneExtent.X;
+		History.ExtentY[Box] = BoneExtent.Y;
+		History.ExtentZ[Box] = BoneExtent.Z;
+	}
+
+	History.Head = (History.Head + 1) % HistoryCapacity;
+	History.NumSnapshots = FMath::Min(History.NumSnapshots + 1, HistoryCapacity);
+}
+
+double ULyraLagCompensationSubsystem::GetRewindTime(const AController* Shooter) const
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	// The client saw the targets half a round trip ago, and the shot took the other half to get here
+	const APlayerState* PlayerState = Shooter ? Shooter->PlayerState : nullptr;
+	const double RoundTripTime = PlayerState ? (PlayerState->GetPingInMilliseconds() * 0.001) : 0.0;
+
+	return Now - FMath::Clamp(RoundTripTime, 0.0, (double)LyraConsoleVariables::LagCompensationMaxRewindTime);
+}
+
+bool ULyraLagCompensationSubsystem::ValidateHit(const APawn* TargetPawn, double RewindTime, const FVector& RayStart, const FVector& RayEnd, float Tolerance) const
+{
+	const FPawnHistory* History = PawnHistories.Find(TargetPawn);
+	if (!History || (History->NumSnapshots == 0))
+	{
+		return true;
+	}
+
+	// Find the snapshots around the rewind time, walking back from the newest one
+	int32 Newer = (History->Head + HistoryCapacity - 1) % HistoryCapacity;
+	int32 Older = Newer;
+	for (int32 Step = 1; Step < History->NumSnapshots; ++Step)
+	{
+		if (History->Times[Older] <= RewindTime)
+		{
+			break;
+		}
+
+		Newer = Older;
+		Older = (Older + HistoryCapacity - 1) % HistoryCapacity;
+	}
+
+	const double TimeSpan = History->Times[Newer] - History->Times[Older];
+	const float Alpha = (TimeSpan > 0.0) ? (float)FMath::Clamp((RewindTime - History->Times[Older]) / TimeSpan, 0.0, 1.0) : 0.0f;
+
+	// Segment in parametric form, the slab test below clips [0, 1] against every box
+	const FVector RayDelta = RayEnd - RayStart;
+	auto SafeInverse = [](double Value) { return 1.0f / (float)((FMath::Abs(Value) > KINDA_SMALL_NUMBER) ? Value : KINDA_SMALL_NUMBER); };
+
+	const VectorRegister4Float OriginX = VectorSetFloat1((float)RayStart.X);
+	const VectorRegister4Float OriginY = VectorSetFloat1((float)RayStart.Y);
+	const VectorRegister4Float OriginZ = VectorSetFloat1((float)RayStart.Z);
+	const VectorRegister4Float InvDirX = VectorSetFloat1(SafeInverse(RayDelta.X));
+	const VectorRegister4Float InvDirY = VectorSetFloat1(SafeInverse(RayDelta.Y));
+	const VectorRegister4Float InvDirZ = VectorSetFloat1(SafeInverse(RayDelta.Z));
+	const VectorRegister4Float AlphaV = VectorSetFloat1(Alpha);
+	const VectorRegister4Float ToleranceV = VectorSetFloat1(Tolerance);
+
+	const int32 NumBoxes = 1 + HitBones.Num();
+	const int32 NumBoxesPadded = GetNumBoxesPadded();
+	const int32 OlderFirst = Older * NumBoxesPadded;
+	const int32 NewerFirst = Newer * NumBoxesPadded;
+
+	for (int32 Box = 0; Box < NumBoxesPadded; Box += 4)
+	{
+		VectorRegister4Float TMin = VectorZeroFloat();
+		VectorRegister4Float TMax = VectorOneFloat();
+
+		auto ClipAxis = [&](const TArray<float>& Centers, const TArray<float>& Extents, const VectorRegister4Float& Origin, const VectorRegister4Float& InvDir)
+		{
+			const VectorRegister4Float OlderCenter = VectorLoad(&Centers[OlderFirst + Box]);
+			const VectorRegister4Float OlderExtent = VectorLoad(&Extents[OlderFirst + Box]);
+			const VectorRegister4Float Center = VectorMultiplyAdd(VectorSubtract(VectorLoad(&Centers[NewerFirst + Box]), OlderCenter), AlphaV, OlderCenter);
+			const VectorRegister4Float Extent = VectorAdd(VectorMultiplyAdd(VectorSubtract(VectorLoad(&Extents[NewerFirst + Box]), OlderExtent), AlphaV, OlderExtent), ToleranceV);
+
+			const VectorRegister4Float RelativeCenter = VectorSubtract(Center, Origin);
+			const VectorRegister4Float T1 = VectorMultiply(VectorSubtract(RelativeCenter, Extent), InvDir);
+			const VectorRegister4Float T2 = VectorMultiply(VectorAdd(RelativeCenter, Extent), InvDir);
+			TMin = VectorMax(TMin, VectorMin(T1, T2));
+			TMax = VectorMin(TMax, VectorMax(T1, T2));
+		};
+
+		ClipAxis(History->CenterX, History->ExtentX, OriginX, InvDirX);
+		ClipAxis(History->CenterY, History->ExtentY, OriginY, InvDirY);
+		ClipAxis(History->CenterZ, History->ExtentZ, OriginZ, InvDirZ);
+
+		// Ignore the padding lanes past the last box
+		const int32 ValidLanes = (1 << FMath::Min(NumBoxes - Box, 4)) - 1;
+		if (VectorMaskBits(VectorCompareLE(TMin, TMax)) & ValidLanes)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
@@ -0,0 +1,110 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+
+#include "LyraLagCompensationSubsystem.generated.h"
+
+class AController;
+class APawn;
+class USkeletalMeshComponent;
+
+/** A bone that gets its own hitbox in the lag compensation history */
+USTRUCT()
+struct FLyraLagCompensationBone
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere)
+	FName BoneName;
+
+	/** Half size of the axis aligned box around the bone */
+	UPROPERTY(EditAnywhere)
+	FVector Extent = FVector(15.0f);
+};
+
+/**
+ * ULyraLagCompensationSubsystem
+ *
+ * Records a compact hitbox history for every registered pawn on the server (the capsule plus a few key bones
+ * as axis aligned boxes) so hits reported by clients can be checked against where the target was when the
+ * client fired, without any scene queries.
+ *
+ * Each pawn's history is a fixed size ring buffer stored as structure of arrays, so its memory is bounded
+ * and rewinding interpolates and tests four boxes at a time.
+ */
+UCLASS(Config=Game)
+class LYRAGAME_API ULyraLagCompensationSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	ULyraLagCompensationSubsystem();
+
+	//~USubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~End of USubsystem interface
+
+	/** Starts recording the hitboxes of the given pawn, only does something on servers */
+	void RegisterPawn(APawn* Pawn);
+
+	void UnregisterPawn(APawn* Pawn);
+
+	/** The server time the shooter saw when firing, based on their round trip time and capped by the maximum rewind */
+	double GetRewindTime(const AController* Shooter) const;
+
+	/**
+	 * Returns true if the segment from RayStart to RayEnd passes within Tolerance of the target's hitboxes at RewindTime.
+	 * Pawns without a history can't be checked, so hits on them are accepted.
+	 */
+	bool ValidateHit(const APawn* TargetPawn, double RewindTime, const FVector& RayStart, const FVector& RayEnd, float Tolerance) const;
+
+	/** Bytes used by the history of a single pawn */
+	int32 GetHistoryBytesPerPawn() const;
+
+protected:
+	/** Bones that get a hitbox in addition to the capsule */
+	UPROPERTY(Config, EditAnywhere, Category = "Lag Compensation")
+	TArray<FLyraLagCompensationBone> HitBones;
+
+	/** Number of snapshots kept per pawn; one is taken every server tick so this bounds how far back we can rewind */
+	UPROPERTY(Config, EditAnywhere, Category = "Lag Compensation")
+	int32 HistoryCapacity = 64;
+
+private:
+	struct FPawnHistory
+	{
+		TWeakObjectPtr<APawn> Pawn;
+		TWeakObjectPtr<USkeletalMeshComponent> Mesh;
+
+		/** Index of the next snapshot to write, and how many are valid */
+		int32 Head = 0;
+		int32 NumSnapshots = 0;
+
+		/** [Snapshot] */
+		TArray<double> Times;
+
+		/** [Snapshot * NumBoxesPadded + Box], box 0 is the capsule */
+		TArray<float> CenterX;
+		TArray<float> CenterY;
+		TArray<float> CenterZ;
+		TArray<float> ExtentX;
+		TArray<float> ExtentY;
+		TArray<float> ExtentZ;
+	};
+
+	/** Boxes per snapshot rounded up so every snapshot starts on a vector boundary */
+	int32 GetNumBoxesPadded() const { return Align(1 + HitBones.Num(), 4); }
+
+	void OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+
+	void RecordSnapshot(FPawnHistory& History, double Time) const;
+
+	TMap<TObjectKey<APawn>, FPawnHistory> PawnHistories;
+
+	FDelegateHandle PostActorTickHandle;
+};